@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <base/native_capability.h>
 #include <base/thread_state.h>
+#include <base/trace/types.h>
 
 /* core includes */
 #include <pager.h>
@@ -166,6 +167,12 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return scheduling statistics of the thread
+			 */
+			Trace::Scheduling_stats scheduling_stats() const {
+				return Trace::Scheduling_stats(); }
+
 
 			/*******************************
 			 ** Fiasco-specific Accessors **
@@ -46,3 +46,9 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 		l4_fpage_unmap(l4_fpage(addr, L4_LOG2_PAGESIZE, 0, 0),
 		               L4_FP_FLUSH_PAGE);
 }
+
+
+/*
+ * Mappings are transferred by the kernel as reply to a page fault only
+ */
+bool Rm_client::map(Mapping const &) { return false; }
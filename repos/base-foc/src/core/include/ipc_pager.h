@@ -30,6 +30,7 @@
 /* Fiasco includes */
 namespace Fiasco {
 #include <l4/sys/types.h>
+#include <l4/sys/consts.h>
 }
 
 namespace Genode {
@@ -76,6 +77,34 @@ namespace Genode {
 
 			Cache_attribute cacheability() const { return _cacheability; }
 			bool iomem() { return _iomem; }
+
+			/**
+			 * Return send base of the map item, which denotes the
+			 * destination address and the memory attributes
+			 */
+			Fiasco::l4_umword_t snd_base() const
+			{
+				using namespace Fiasco;
+
+				l4_umword_t const grant = _grant ? L4_MAP_ITEM_GRANT : 0;
+				l4_umword_t       base  = _dst_addr | L4_ITEM_MAP | grant;
+
+				switch (_cacheability) {
+				case WRITE_COMBINED:
+					base |= L4_FPAGE_BUFFERABLE << 4;
+					break;
+				case CACHED:
+					base |= L4_FPAGE_CACHEABLE << 4;
+					break;
+				case UNCACHED:
+					if (!_iomem)
+						base |= L4_FPAGE_BUFFERABLE << 4;
+					else
+						base |= L4_FPAGE_UNCACHEABLE << 4;
+					break;
+				}
+				return base;
+			}
 			/**
 			 * Prepare map operation is not needed on Fiasco.OC, since we clear the
 			 * dataspace before this function is called.
@@ -92,23 +92,7 @@ void Ipc_pager::reply_and_wait_for_fault()
 	l4_umword_t label;
 	l4_msgtag_t snd_tag = l4_msgtag(0, 0, 1, 0);
 
-	l4_umword_t grant   = _reply_mapping.grant() ? L4_MAP_ITEM_GRANT : 0;
-	l4_utcb_mr()->mr[0] = _reply_mapping.dst_addr() | L4_ITEM_MAP | grant;
-
-	switch (_reply_mapping.cacheability()) {
-	case WRITE_COMBINED:
-		l4_utcb_mr()->mr[0] |= L4_FPAGE_BUFFERABLE << 4;
-		break;
-	case CACHED:
-		l4_utcb_mr()->mr[0] |= L4_FPAGE_CACHEABLE << 4;
-		break;
-	case UNCACHED:
-		if (!_reply_mapping.iomem())
-			l4_utcb_mr()->mr[0] |= L4_FPAGE_BUFFERABLE << 4;
-		else
-			l4_utcb_mr()->mr[0] |= L4_FPAGE_UNCACHEABLE << 4;
-		break;
-	}
+	l4_utcb_mr()->mr[0] = _reply_mapping.snd_base();
 	l4_utcb_mr()->mr[1] = _reply_mapping.fpage().raw;
 
 	_tag = l4_ipc_send_and_wait(_last.kcap, l4_utcb(), snd_tag,
@@ -14,6 +14,12 @@
 /* core includes */
 #include <rm_session_component.h>
 #include <map_local.h>
+#include <platform_pd.h>
+
+/* Fiasco.OC includes */
+namespace Fiasco {
+#include <l4/sys/task.h>
+}
 
 using namespace Genode;
 
@@ -22,3 +28,22 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 	// TODO unmap it only from target space
 	unmap_local(core_local_base, size >> get_page_size_log2());
 }
+
+
+bool Rm_client::map(Mapping const &mapping)
+{
+	using namespace Fiasco;
+
+	Locked_ptr<Address_space> locked_address_space(_address_space);
+
+	if (!locked_address_space.valid())
+		return false;
+
+	Platform_pd &pd = static_cast<Platform_pd &>(*locked_address_space);
+
+	/* map from core's address space as the pager would do on a fault */
+	l4_msgtag_t const tag = l4_task_map(pd.native_task().data()->kcap(),
+	                                    L4_BASE_TASK_CAP, mapping.fpage(),
+	                                    mapping.snd_base());
+	return !l4_msgtag_has_error(tag);
+}
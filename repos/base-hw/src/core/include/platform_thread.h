@@ -18,6 +18,7 @@
 /* Genode includes */
 #include <ram_session/ram_session.h>
 #include <base/thread.h>
+#include <base/trace/types.h>
 
 /* base-internal includes */
 #include <base/internal/native_utcb.h>
@@ -191,6 +192,12 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return scheduling statistics of the thread
+			 */
+			Trace::Scheduling_stats scheduling_stats() const {
+				return Trace::Scheduling_stats(); }
+
 
 			/***************
 			 ** Accessors **
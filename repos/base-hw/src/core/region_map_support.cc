@@ -38,6 +38,22 @@ void Rm_client::unmap(addr_t, addr_t virt_base, size_t size)
 }
 
 
+bool Rm_client::map(Mapping const &mapping)
+{
+	Locked_ptr<Address_space> locked_address_space(_address_space);
+
+	if (!locked_address_space.valid())
+		return false;
+
+	Hw::Address_space * as = static_cast<Hw::Address_space*>(&*locked_address_space);
+	Page_flags const flags = Page_flags::apply_mapping(mapping.writable,
+	                                                   mapping.cacheable,
+	                                                   mapping.io_mem);
+	return as->insert_translation(mapping.virt_address, mapping.phys_address,
+	                              1 << mapping.size_log2, flags);
+}
+
+
 /**********************
  ** Pager_entrypoint **
  **********************/
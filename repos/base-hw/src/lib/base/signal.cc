@@ -50,7 +50,7 @@ void Signal_context::submit(unsigned) { PERR("not implemented"); }
 void Signal_transmitter::submit(unsigned cnt)
 {
 	{
-		Trace::Signal_submit trace_event(cnt);
+		Trace::Signal_submit trace_event(cnt, _context.local_name());
 	}
 	Kernel::submit_signal(Capability_space::capid(_context), cnt);
 }
@@ -18,6 +18,9 @@
 #ifndef _CORE__INCLUDE__CORE_ENV_H_
 #define _CORE__INCLUDE__CORE_ENV_H_
 
+/* Genode includes */
+#include <base/rpc_entrypoint_pool.h>
+
 /* core includes */
 #include <platform.h>
 #include <core_parent.h>
@@ -123,14 +126,27 @@ namespace Genode {
 			 * entrypoint cannot call itself. To support this special case,
 			 * the 'Entrypoint' extends the 'Rpc_entrypoint' with the
 			 * functionality needed to lookup an RPC object by its capability.
+			 *
+			 * Objects that support concurrent dispatching, i.e., RAM and RM
+			 * sessions, are served by one worker thread per additional CPU.
 			 */
-			struct Entrypoint : Rpc_entrypoint
+			struct Entrypoint : Rpc_entrypoint_pool
 			{
 				enum { STACK_SIZE = 2048 * sizeof(Genode::addr_t) };
+				enum { MAX_EP_WORKERS = 7 };
+
+				static unsigned _num_ep_workers()
+				{
+					unsigned const cpus = platform()->affinity_space().total();
+					return cpus > 1 ? min(cpus - 1, (unsigned)MAX_EP_WORKERS) : 0;
+				}
 
 				Entrypoint()
 				:
-					Rpc_entrypoint(nullptr, STACK_SIZE, "entrypoint")
+					Rpc_entrypoint_pool(nullptr, STACK_SIZE, "entrypoint",
+					                    *platform()->core_mem_alloc(),
+					                    platform()->affinity_space(),
+					                    _num_ep_workers())
 				{ }
 			};
 
@@ -48,6 +48,46 @@ inline int lx_dup(int fd)
 }
 
 
+/*
+ * The system-call number of 'memfd_create' is missing in the headers of
+ * older C libraries.
+ */
+#ifndef SYS_memfd_create
+#if defined(__x86_64__)
+#define SYS_memfd_create 319
+#elif defined(__i386__)
+#define SYS_memfd_create 356
+#elif defined(__arm__)
+#define SYS_memfd_create 385
+#endif
+#endif
+
+enum { LX_MFD_CLOEXEC = 1, LX_MFD_ALLOW_SEALING = 2, LX_MFD_HUGETLB = 4 };
+
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+#ifdef SYS_memfd_create
+	return lx_syscall(SYS_memfd_create, name, flags);
+#else
+	return -1;
+#endif
+}
+
+
+/**
+ * Allocate the backing store of the first 'length' bytes of a file
+ */
+inline int lx_fallocate(int fd, unsigned long length)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fallocate, fd, 0, 0UL, length);
+#else
+	/* offset and length are passed as pairs of 32-bit arguments */
+	return lx_syscall(SYS_fallocate, fd, 0, 0UL, 0UL, length, 0UL);
+#endif
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
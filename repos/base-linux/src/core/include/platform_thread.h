@@ -20,6 +20,7 @@
 #include <base/thread_state.h>
 #include <cpu_session/cpu_session.h>
 #include <base/weak_ptr.h>
+#include <base/trace/types.h>
 
 /* base-internal includes */
 #include <base/internal/server_socket_pair.h>
@@ -176,8 +177,19 @@ namespace Genode {
 
 			/**
 			 * Return execution time consumed by the thread
+			 *
+			 * The time is obtained in nanoseconds from the 'schedstat'
+			 * file of the thread in the host's procfs.
+			 */
+			unsigned long long execution_time() const;
+
+			/**
+			 * Return scheduling statistics of the thread
+			 *
+			 * The statistics are obtained from the 'schedstat', 'status',
+			 * and 'stat' files of the thread in the host's procfs.
 			 */
-			unsigned long long execution_time() const { return 0; }
+			Trace::Scheduling_stats scheduling_stats() const;
 
 			Weak_ptr<Address_space> address_space() { return Weak_ptr<Address_space>(); }
 
@@ -26,6 +26,75 @@ using namespace Genode;
 typedef Token<Scanner_policy_identifier_with_underline> Tid_token;
 
 
+/**
+ * Read procfs file of the thread 'tid' of process 'pid' into 'dst'
+ *
+ * \return  number of bytes read, zero if the file is not available
+ *
+ * The content is null-terminated.
+ */
+static size_t read_task_file(unsigned long pid, unsigned long tid,
+                             char const *file, char *dst, size_t dst_len)
+{
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/%lu/task/%lu/%s", pid, tid, file);
+
+	int const fd = lx_open(path, O_RDONLY | LX_O_CLOEXEC);
+	if (fd < 0)
+		return 0;
+
+	size_t len = 0;
+	while (len < dst_len - 1) {
+		int const ret = lx_read(fd, dst + len, dst_len - 1 - len);
+		if (ret <= 0)
+			break;
+		len += ret;
+	}
+	lx_close(fd);
+
+	dst[len] = 0;
+	return len;
+}
+
+
+/**
+ * Skip whitespace-separated fields of a procfs line
+ */
+static char const *skip_fields(char const *s, unsigned num)
+{
+	for (; *s && num; num--) {
+		while (*s && *s != ' ') s++;
+		while (*s == ' ') s++;
+	}
+	return s;
+}
+
+
+/**
+ * Return value of the 'key:' line of a procfs status file
+ */
+static unsigned long status_value(char const *status, char const *key)
+{
+	size_t const key_len = Genode::strlen(key);
+
+	for (char const *line = status; *line; ) {
+
+		if (strcmp(line, key, key_len) == 0 && line[key_len] == ':') {
+			char const *s = line + key_len + 1;
+			while (*s == ' ' || *s == '\t') s++;
+
+			unsigned long value = 0;
+			ascii_to(s, value);
+			return value;
+		}
+
+		while (*line && *line != '\n') line++;
+		if (*line) line++;
+	}
+	return 0;
+}
+
+
 /*******************************
  ** Platform_thread::Registry **
  *******************************/
@@ -132,3 +201,58 @@ int Platform_thread::server_sd()
 	client_sd();
 	return _socket_pair.server_sd;
 }
+
+
+unsigned long long Platform_thread::execution_time() const
+{
+	if (_tid == (unsigned long)-1)
+		return 0;
+
+	/* the first field of 'schedstat' is the time spent on the CPU in ns */
+	char buf[128];
+	unsigned long long time = 0;
+	if (read_task_file(_pid, _tid, "schedstat", buf, sizeof(buf)))
+		ascii_to(buf, time);
+
+	return time;
+}
+
+
+Trace::Scheduling_stats Platform_thread::scheduling_stats() const
+{
+	Trace::Scheduling_stats stats;
+
+	if (_tid == (unsigned long)-1)
+		return stats;
+
+	/* the second field of 'schedstat' is the time spent on a run queue */
+	char buf[2048];
+	if (read_task_file(_pid, _tid, "schedstat", buf, sizeof(buf)))
+		ascii_to(skip_fields(buf, 1), stats.wait_time);
+
+	if (read_task_file(_pid, _tid, "status", buf, sizeof(buf))) {
+		stats.voluntary_switches   = status_value(buf, "voluntary_ctxt_switches");
+		stats.involuntary_switches = status_value(buf, "nonvoluntary_ctxt_switches");
+	}
+
+	/*
+	 * The 'stat' file starts with the PID followed by the command name in
+	 * parentheses, which may contain spaces. The CPU is field 39, which
+	 * follows the state (field 3) after the command name by 36 fields.
+	 */
+	if (read_task_file(_pid, _tid, "stat", buf, sizeof(buf))) {
+		char const *state = 0;
+		for (char const *c = buf; *c; c++)
+			if (*c == ')') state = c + 1;
+
+		if (state) {
+			while (*state == ' ') state++;
+
+			unsigned long cpu = 0;
+			ascii_to(skip_fields(state, 36), cpu);
+			stats.last_cpu = cpu;
+		}
+	}
+
+	return stats;
+}
@@ -33,18 +33,73 @@ using namespace Genode;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
-void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+
+/**
+ * Create file backed by the hugetlb pool of the host
+ *
+ * The huge pages are allocated up front. Otherwise, an exhausted pool
+ * would not become apparent before the first access to the dataspace,
+ * which raises a SIGBUS. Note that such a dataspace can be attached only
+ * at the granularity of huge pages.
+ *
+ * \return file descriptor, or -1 if the pool lacks free huge pages
+ */
+static int hugetlb_file(char const *name, size_t size)
+{
+	if (size % HUGE_PAGE_SIZE)
+		return -1;
+
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC | LX_MFD_HUGETLB);
+	if (fd < 0)
+		return -1;
+
+	if (lx_ftruncate(fd, size) == 0 && lx_fallocate(fd, size) == 0)
+		return fd;
+
+	lx_close(fd);
+	return -1;
+}
+
+
+/**
+ * Create anonymous shared-memory file eligible for transparent huge pages
+ *
+ * Whether the host kernel actually backs the file by huge pages depends on
+ * its configuration ('/sys/kernel/mm/transparent_hugepage/shmem_enabled').
+ * The 'advise' mode is covered by 'Region_map_mmap', which marks each large
+ * mapping of a file sealed with 'LX_SEALS_HUGE_PAGES' accordingly.
+ *
+ * \return file descriptor, or -1 if 'memfd_create' is not supported
+ */
+static int shmem_file(char const *name, size_t size)
+{
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+	if (fd < 0)
+		return -1;
+
+	if (lx_ftruncate(fd, size) == 0
+	 && lx_fcntl(fd, LX_F_ADD_SEALS, LX_SEALS_HUGE_PAGES) == 0)
+		return fd;
+
+	lx_close(fd);
+	return -1;
+}
+
+
+/**
+ * Create file in the resource path
+ */
+static int resource_file(char const *name, size_t size)
 {
 	char fname[Linux_dataspace::FNAME_LEN];
 
 	/* create file using a unique file name in the resource path */
-	snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt++);
+	snprintf(fname, sizeof(fname), "%s/%s", resource_path(), name);
 	lx_unlink(fname);
 	int const fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds->size());
-
-	/* remember file descriptor in dataspace component object */
-	ds->fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -53,6 +108,37 @@ void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname);
+
+	return fd;
+}
+
+
+void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "ds-%d", ram_ds_cnt++);
+
+	size_t const size = ds->size();
+	int          fd   = -1;
+
+	/*
+	 * Back large dataspaces by huge pages according to the session's
+	 * policy, falling back to the next-weaker option if unavailable
+	 */
+	if (size >= HUGE_PAGE_SIZE) {
+
+		if (_huge_pages == HUGE_PAGES_HUGETLB)
+			fd = hugetlb_file(name, size);
+
+		if (fd < 0 && _huge_pages != HUGE_PAGES_NO)
+			fd = shmem_file(name, size);
+	}
+
+	if (fd < 0)
+		fd = resource_file(name, size);
+
+	/* remember file descriptor in dataspace component object */
+	ds->fd(fd);
 }
 
 
@@ -46,7 +46,7 @@ class Stack_area_region_map : public Genode::Region_map
 		Local_addr attach(Genode::Dataspace_capability ds_cap,
 		                  Genode::size_t size, Genode::off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable)
+		                  bool executable, bool, bool)
 		{
 			using namespace Genode;
 
@@ -60,6 +60,52 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 
 		bool _is_attached() const { return _base > 0; }
 
+		/**
+		 * Properties of a dataspace obtained during an attach batch
+		 *
+		 * While processing a batch, the size, the writeability, and the
+		 * file descriptor of each dataspace are requested from core only
+		 * once. The file descriptors are closed after all mappings of the
+		 * batch are in place.
+		 */
+		struct Dataspace_info
+		{
+			Dataspace_capability ds;
+			size_t               size           = 0;
+			bool                 size_valid     = false;
+			bool                 writable       = false;
+			bool                 writable_valid = false;
+			int                  fd             = -1;
+		};
+
+		struct Batch_infos
+		{
+			Dataspace_info info[Attach_batch::MAX_ENTRIES];
+			unsigned       count = 0;
+		};
+
+		Batch_infos *_batch_infos = nullptr;
+
+		/**
+		 * Return batch info of dataspace, or nullptr outside of a batch
+		 */
+		Dataspace_info *_batch_info(Dataspace_capability);
+
+		/*
+		 * Accessors of dataspace properties that consult the batch infos
+		 */
+		size_t _ds_size(Dataspace_capability);
+		bool   _ds_writable(Dataspace_capability);
+		int    _ds_fd(Dataspace_capability);
+
+		/**
+		 * Attach dataspace with '_lock' held
+		 */
+		Local_addr _attach(Dataspace_capability ds, size_t size, off_t offset,
+		                   bool use_local_addr, Local_addr local_addr,
+		                   bool executable, bool copy_on_write,
+		                   bool populate);
+
 		void _add_to_rmap(Region const &);
 
 		/**
@@ -71,6 +117,13 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 
 		/**
 		 * Map dataspace into local address space
+		 *
+		 * A copy-on-write mapping is realized as private file mapping.
+		 * The Linux kernel duplicates each page at the first write access.
+		 *
+		 * A shared mapping is populated via 'MAP_POPULATE'. Because
+		 * populating a private writeable mapping would duplicate all of
+		 * its pages, a copy-on-write mapping is merely read ahead.
 		 */
 		void *_map_local(Dataspace_capability ds,
 		                 size_t               size,
@@ -78,6 +131,8 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		                 bool                 use_local_addr,
 		                 addr_t               local_addr,
 		                 bool                 executable,
+		                 bool                 copy_on_write,
+		                 bool                 populate,
 		                 bool                 overmap = false);
 
 		/**
@@ -117,7 +172,10 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		 **************************/
 
 		Local_addr attach(Dataspace_capability ds, size_t size,
-		                  off_t, bool, Local_addr, bool executable);
+		                  off_t, bool, Local_addr, bool executable,
+		                  bool copy_on_write, bool populate);
+
+		void attach_batch(Attach_batch &) override;
 
 		void detach(Local_addr local_addr);
 
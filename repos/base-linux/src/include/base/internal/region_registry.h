@@ -31,6 +31,8 @@ class Genode::Region
 		off_t                _offset;
 		Dataspace_capability _ds;
 		size_t               _size;
+		bool                 _copy_on_write;
+		bool                 _populate;
 
 		/**
 		 * Return offset of first byte after the region
@@ -39,16 +41,26 @@ class Genode::Region
 
 	public:
 
-		Region() : _start(0), _offset(0), _size(0) { }
+		Region()
+		:
+			_start(0), _offset(0), _size(0), _copy_on_write(false),
+			_populate(false)
+		{ }
 
-		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size)
-		: _start(start), _offset(offset), _ds(ds), _size(size) { }
+		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size,
+		       bool copy_on_write = false, bool populate = false)
+		:
+			_start(start), _offset(offset), _ds(ds), _size(size),
+			_copy_on_write(copy_on_write), _populate(populate)
+		{ }
 
 		bool                 used()      const { return _size > 0; }
 		addr_t               start()     const { return _start; }
 		off_t                offset()    const { return _offset; }
 		size_t               size()      const { return _size; }
 		Dataspace_capability dataspace() const { return _ds; }
+		bool                 copy_on_write() const { return _copy_on_write; }
+		bool                 populate()      const { return _populate; }
 
 		bool intersects(Region const &r) const
 		{
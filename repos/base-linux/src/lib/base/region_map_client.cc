@@ -39,17 +39,27 @@ Region_map::Local_addr
 Region_map_client::attach(Dataspace_capability ds, size_t size,
                           off_t offset, bool use_local_addr,
                           Region_map::Local_addr local_addr,
-                          bool executable)
+                          bool executable, bool copy_on_write,
+                          bool populate)
 {
 	return _local(*this)->attach(ds, size, offset, use_local_addr,
-	                             local_addr, executable);
+	                             local_addr, executable, copy_on_write,
+	                             populate);
 }
 
 
+void Region_map_client::attach_batch(Attach_batch &batch) {
+	_local(*this)->attach_batch(batch); }
+
+
 void Region_map_client::detach(Local_addr local_addr) {
 	return _local(*this)->detach(local_addr); }
 
 
+void Region_map_client::detach_batch(Detach_batch const &batch) {
+	_local(*this)->detach_batch(batch); }
+
+
 void Region_map_client::fault_handler(Signal_context_capability /*handler*/)
 {
 	/*
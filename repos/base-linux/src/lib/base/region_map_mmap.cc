@@ -113,12 +113,27 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
                                   bool                 use_local_addr,
                                   addr_t               local_addr,
                                   bool                 executable,
+                                  bool                 copy_on_write,
+                                  bool                 populate,
                                   bool                 overmap)
 {
-	int  const  fd        = _dataspace_fd(ds);
-	bool const  writable  = _dataspace_writable(ds);
+	enum { HUGE_PAGE_SIZE = 2*1024*1024 };
 
-	int  const  flags     = MAP_SHARED | (overmap ? MAP_FIXED : 0);
+	bool const  batched   = _batch_info(ds) != nullptr;
+	int  const  fd        = _ds_fd(ds);
+	bool const  writable  = _ds_writable(ds) || copy_on_write;
+
+	/*
+	 * Large RAM dataspaces of sessions that asked for transparent huge pages
+	 * are backed by shared memory that core marked with specific seals (see
+	 * core's 'ram_session_support.cc').
+	 */
+	bool const  huge      = size >= HUGE_PAGE_SIZE
+	                     && lx_fcntl(fd, LX_F_GET_SEALS, 0) == LX_SEALS_HUGE_PAGES;
+
+	int  const  flags     = (copy_on_write ? MAP_PRIVATE : MAP_SHARED)
+	                      | (overmap ? MAP_FIXED : 0)
+	                      | (populate && !copy_on_write ? MAP_POPULATE : 0);
 	int  const  prot      = PROT_READ
 	                      | (writable   ? PROT_WRITE : 0)
 	                      | (executable ? PROT_EXEC  : 0);
@@ -129,9 +144,11 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 	 * We can close the file after calling mmap. The Linux kernel will still
 	 * keep the file mapped. By immediately closing the file descriptor, we
 	 * won't need to keep track of dataspace file descriptors within the
-	 * process.
+	 * process. Within an attach batch, the descriptor is closed after all
+	 * mappings of the batch are in place.
 	 */
-	lx_close(fd);
+	if (!batched)
+		lx_close(fd);
 
 	/* attach at local address failed - unmap incorrect mapping */
 	if (use_local_addr && addr_in != addr_out)
@@ -144,6 +161,18 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 		throw Region_map::Region_conflict();
 	}
 
+	/*
+	 * If the host kernel provides transparent huge pages for shared memory
+	 * on advice only, ask for them. Otherwise, the advice is meaningless and
+	 * its failure is harmless.
+	 */
+	if (huge)
+		lx_madvise(addr_out, size, LX_MADV_HUGEPAGE);
+
+	/* read ahead the file content of a populated copy-on-write mapping */
+	if (populate && copy_on_write)
+		lx_madvise(addr_out, size, LX_MADV_WILLNEED);
+
 	return addr_out;
 }
 
@@ -157,14 +186,128 @@ void Region_map_mmap::_add_to_rmap(Region const &region)
 }
 
 
+Region_map_mmap::Dataspace_info *
+Region_map_mmap::_batch_info(Dataspace_capability ds)
+{
+	if (!_batch_infos)
+		return nullptr;
+
+	Batch_infos &infos = *_batch_infos;
+
+	for (unsigned i = 0; i < infos.count; i++)
+		if (infos.info[i].ds == ds)
+			return &infos.info[i];
+
+	/* dataspaces beyond the capacity are not cached */
+	if (infos.count == Attach_batch::MAX_ENTRIES)
+		return nullptr;
+
+	Dataspace_info &info = infos.info[infos.count++];
+	info = Dataspace_info();
+	info.ds = ds;
+	return &info;
+}
+
+
+size_t Region_map_mmap::_ds_size(Dataspace_capability ds)
+{
+	Dataspace_info *info = _batch_info(ds);
+	if (!info)
+		return _dataspace_size(ds);
+
+	if (!info->size_valid) {
+		info->size       = _dataspace_size(ds);
+		info->size_valid = true;
+	}
+	return info->size;
+}
+
+
+bool Region_map_mmap::_ds_writable(Dataspace_capability ds)
+{
+	Dataspace_info *info = _batch_info(ds);
+	if (!info)
+		return _dataspace_writable(ds);
+
+	if (!info->writable_valid) {
+		info->writable       = _dataspace_writable(ds);
+		info->writable_valid = true;
+	}
+	return info->writable;
+}
+
+
+int Region_map_mmap::_ds_fd(Dataspace_capability ds)
+{
+	Dataspace_info *info = _batch_info(ds);
+	if (!info)
+		return _dataspace_fd(ds);
+
+	if (info->fd < 0)
+		info->fd = _dataspace_fd(ds);
+
+	return info->fd;
+}
+
+
 Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
                                                size_t size, off_t offset,
                                                bool use_local_addr,
                                                Region_map::Local_addr local_addr,
-                                               bool executable)
+                                               bool executable,
+                                               bool copy_on_write,
+                                               bool populate)
+{
+	Lock::Guard lock_guard(_lock);
+
+	return _attach(ds, size, offset, use_local_addr, local_addr, executable,
+	               copy_on_write, populate);
+}
+
+
+void Region_map_mmap::attach_batch(Attach_batch &batch)
 {
 	Lock::Guard lock_guard(_lock);
 
+	/*
+	 * Request the properties of each dataspace from core only once and
+	 * keep the file descriptors open until all mappings are done.
+	 */
+	Batch_infos infos;
+	_batch_infos = &infos;
+
+	for (unsigned i = 0; i < batch.count; i++) {
+
+		Attach_batch::Entry &e = batch.entries[i];
+
+		try {
+			e.addr   = _attach(e.ds, e.size, e.offset, e.use_local_addr,
+			                   e.local_addr, e.executable, e.copy_on_write,
+			                   e.populate);
+			e.result = Attach_batch::OK;
+		}
+		catch (Invalid_dataspace) { e.result = Attach_batch::INVALID_DATASPACE; }
+		catch (Region_conflict)   { e.result = Attach_batch::REGION_CONFLICT; }
+		catch (Out_of_metadata)   { e.result = Attach_batch::OUT_OF_METADATA; }
+		catch (Invalid_args)      { e.result = Attach_batch::INVALID_ARGS; }
+	}
+
+	_batch_infos = nullptr;
+
+	for (unsigned i = 0; i < infos.count; i++)
+		if (infos.info[i].fd >= 0)
+			lx_close(infos.info[i].fd);
+}
+
+
+Region_map::Local_addr Region_map_mmap::_attach(Dataspace_capability ds,
+                                                size_t size, off_t offset,
+                                                bool use_local_addr,
+                                                Region_map::Local_addr local_addr,
+                                                bool executable,
+                                                bool copy_on_write,
+                                                bool populate)
+{
 	/* only support attach_at for sub RM sessions */
 	if (_sub_rm && !use_local_addr) {
 		PERR("Region_map_mmap::attach: attaching w/o local addr not supported\n");
@@ -176,8 +319,9 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		throw Region_conflict();
 	}
 
-	size_t const remaining_ds_size = _dataspace_size(ds) > (addr_t)offset
-	                               ? _dataspace_size(ds) - (addr_t)offset : 0;
+	size_t const ds_size           = _ds_size(ds);
+	size_t const remaining_ds_size = ds_size > (addr_t)offset
+	                               ? ds_size - (addr_t)offset : 0;
 
 	/* determine size of virtual address region */
 	size_t const region_size = size ? min(remaining_ds_size, size)
@@ -217,7 +361,8 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			throw Region_conflict();
 		}
 
-		_add_to_rmap(Region(local_addr, offset, ds, region_size));
+		_add_to_rmap(Region(local_addr, offset, ds, region_size, copy_on_write,
+		                    populate));
 
 		/*
 		 * Case 3.1
@@ -228,7 +373,8 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		 * argument as the region was reserved by a PROT_NONE mapping.
 		 */
 		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable, true);
+			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr,
+			           executable, copy_on_write, populate, true);
 
 		return (void *)local_addr;
 
@@ -279,7 +425,8 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 				 */
 				_map_local(region.dataspace(), region.size(), region.offset(),
 				           true, rm->_base + region.start() + region.offset(),
-				           executable, true);
+				           executable, region.copy_on_write(),
+				           populate || region.populate(), true);
 			}
 
 			return rm->_base;
@@ -293,9 +440,11 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			 * Note, we do not overmap.
 			 */
 			void *addr = _map_local(ds, region_size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, copy_on_write,
+			                        populate);
 
-			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
+			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size,
+			                    copy_on_write, populate));
 
 			return addr;
 		}
@@ -203,6 +203,29 @@ inline int lx_munmap(void *addr, size_t length)
 }
 
 
+/* advice to back a mapping by transparent huge pages */
+enum { LX_MADV_WILLNEED = 3, LX_MADV_HUGEPAGE = 14 };
+
+inline int lx_madvise(void *addr, size_t length, int advice)
+{
+	return lx_syscall(SYS_madvise, addr, length, advice);
+}
+
+
+/*
+ * Core seals the size of the shared-memory files of RAM dataspaces eligible
+ * for transparent huge pages. No other file carries this set of seals.
+ */
+enum { LX_F_ADD_SEALS = 1033, LX_F_GET_SEALS = 1034,
+       LX_F_SEAL_SEAL = 1, LX_F_SEAL_SHRINK = 2, LX_F_SEAL_GROW = 4,
+       LX_SEALS_HUGE_PAGES = LX_F_SEAL_SEAL | LX_F_SEAL_SHRINK | LX_F_SEAL_GROW };
+
+inline int lx_fcntl(int fd, int cmd, unsigned long arg)
+{
+	return lx_syscall(SYS_fcntl, fd, cmd, arg);
+}
+
+
 /***********************************************************************
  ** Functions used by thread lib and core's cancel-blocking mechanism **
  ***********************************************************************/
@@ -0,0 +1,146 @@
+/*
+ * \brief  Random-access bandwidth of a large RAM dataspace
+ * \author Genode Labs
+ * \date   2016-06-06
+ *
+ * The test allocates a 1 GiB dataspace from RAM sessions with different
+ * 'huge_pages' policies and measures the bandwidth of reading cache lines
+ * scattered randomly over the whole dataspace. With 4 KiB pages, almost
+ * each access misses the TLB whereas the TLB covers a much larger part of
+ * the dataspace with 2 MiB pages.
+ *
+ * In addition, the test compares the time needed to attach a dataspace
+ * and to touch all of its pages for an on-demand and a populated mapping.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/connection.h>
+#include <ram_session/client.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+enum { DS_SIZE         = 1024*1024*1024,
+       FIRST_TOUCH_SIZE = 256*1024*1024,
+       LINE_SIZE       = 64,
+       PAGE_SIZE       = 4096,
+       ACCESSES        = 32*1024*1024 };
+
+
+/**
+ * RAM session with the specified huge-page policy
+ */
+struct Policy_ram_connection : Connection<Ram_session>, Ram_session_client
+{
+	enum { RAM_QUOTA = 4*1024*sizeof(long) };
+
+	Policy_ram_connection(char const *policy)
+	:
+		Connection<Ram_session>(session("ram_quota=%u, huge_pages=%s, "
+		                                "label=\"%s\"", RAM_QUOTA,
+		                                policy, policy)),
+		Ram_session_client(cap())
+	{ }
+};
+
+
+static void measure(Timer::Connection &timer, char const *policy)
+{
+	Policy_ram_connection ram(policy);
+	ram.ref_account(env()->ram_session_cap());
+	env()->ram_session()->transfer_quota(ram.cap(), DS_SIZE);
+
+	Ram_dataspace_capability ds = ram.alloc(DS_SIZE);
+	uint64_t * const base = env()->rm_session()->attach(ds);
+
+	/* touch each page up front to exclude page faults from the measurement */
+	unsigned long const populate_start_ms = timer.elapsed_ms();
+
+	for (size_t offset = 0; offset < DS_SIZE; offset += PAGE_SIZE)
+		base[offset/sizeof(uint64_t)] = offset;
+
+	unsigned long const populate_ms = timer.elapsed_ms() - populate_start_ms;
+
+	/* read cache lines at pseudo-random positions (xorshift) */
+	uint64_t x   = 88172645463325252ULL;
+	uint64_t sum = 0;
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < ACCESSES; i++) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+
+		size_t const line = x % (DS_SIZE/LINE_SIZE);
+		sum += base[line*(LINE_SIZE/sizeof(uint64_t))];
+	}
+
+	unsigned long const duration_ms = timer.elapsed_ms() - start_ms;
+
+	printf("bandwidth: huge_pages=%s: populate %lu ms, %u random reads %lu ms",
+	       policy, populate_ms, (unsigned)ACCESSES, duration_ms);
+
+	if (duration_ms)
+		printf(", %lu MiB/s", (unsigned long)(((uint64_t)ACCESSES*LINE_SIZE/1024)
+		                                      /duration_ms*1000/1024));
+
+	printf(" (checksum %lx)\n", (unsigned long)sum);
+
+	env()->rm_session()->detach(base);
+	ram.free(ds);
+}
+
+
+static void measure_first_touch(Timer::Connection &timer, bool populate)
+{
+	Ram_dataspace_capability ds = env()->ram_session()->alloc(FIRST_TOUCH_SIZE);
+
+	unsigned long const attach_start_ms = timer.elapsed_ms();
+
+	uint64_t * const base = env()->rm_session()->attach(ds, 0, 0, false,
+	                                                    (void *)0, false,
+	                                                    false, populate);
+
+	unsigned long const touch_start_ms = timer.elapsed_ms();
+
+	for (size_t offset = 0; offset < FIRST_TOUCH_SIZE; offset += PAGE_SIZE)
+		base[offset/sizeof(uint64_t)] = offset;
+
+	unsigned long const end_ms = timer.elapsed_ms();
+
+	printf("first touch: populate=%s: attach %lu ms, touch %lu ms\n",
+	       populate ? "yes" : "no", touch_start_ms - attach_start_ms,
+	       end_ms - touch_start_ms);
+
+	env()->rm_session()->detach(base);
+	env()->ram_session()->free(ds);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- RAM bandwidth test ---\n");
+
+	static Timer::Connection timer;
+
+	char const *policies[] = { "no", "transparent", "hugetlb" };
+
+	for (unsigned i = 0; i < sizeof(policies)/sizeof(policies[0]); i++)
+		measure(timer, policies[i]);
+
+	measure_first_touch(timer, false);
+	measure_first_touch(timer, true);
+
+	printf("--- finished RAM bandwidth test ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-ram_bandwidth
+LIBS   = base
+SRC_CC = main.cc
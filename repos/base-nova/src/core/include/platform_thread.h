@@ -18,6 +18,7 @@
 /* Genode includes */
 #include <thread/capability.h>
 #include <base/thread_state.h>
+#include <base/trace/types.h>
 #include <base/thread.h>
 
 /* base-internal includes */
@@ -186,6 +187,12 @@ namespace Genode {
 			 * Return execution time consumed by the thread
 			 */
 			unsigned long long execution_time() const;
+
+			/**
+			 * Return scheduling statistics of the thread
+			 */
+			Trace::Scheduling_stats scheduling_stats() const {
+				return Trace::Scheduling_stats(); }
 	};
 }
 
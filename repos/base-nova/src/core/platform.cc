@@ -740,7 +740,8 @@ Platform::Platform() :
 				Nova::sc_ctrl(sc_sel, execution_time);
 
 				return { Session_label("kernel"), Trace::Thread_name(name),
-				         Trace::Execution_time(execution_time), affinity };
+				         Trace::Execution_time(execution_time), affinity,
+				         Trace::Scheduling_stats() };
 			}
 
 			Idle_trace_source(Affinity::Location affinity, unsigned sc_sel)
@@ -24,10 +24,33 @@ Region_map_client::Region_map_client(Capability<Region_map> session)
 Region_map::Local_addr
 Region_map_client::attach(Dataspace_capability ds, size_t size, off_t offset,
                           bool use_local_addr, Local_addr local_addr,
-                          bool executable)
+                          bool executable, bool copy_on_write,
+                          bool populate)
 {
+	Attach_attr const attr { executable, copy_on_write, populate };
+
 	return call<Rpc_attach>(ds, size, offset, use_local_addr, local_addr,
-	                        executable);
+	                        attr);
+}
+
+
+void Region_map_client::attach_batch(Attach_batch &batch)
+{
+	struct Transfer : Attach_chunk_transfer
+	{
+		Region_map_client &rm;
+
+		Transfer(Region_map_client &rm) : rm(rm) { }
+
+		void transfer(Dataspace_capability ds0, Dataspace_capability ds1,
+		              Dataspace_capability ds2, Dataspace_capability ds3,
+		              Attach_chunk &chunk) override
+		{
+			rm.call<Rpc_attach_chunk>(ds0, ds1, ds2, ds3, chunk);
+		}
+	} transfer(*this);
+
+	attach_batch_chunked(batch, transfer);
 }
 
 
@@ -35,6 +58,10 @@ void Region_map_client::detach(Local_addr local_addr) {
 	call<Rpc_detach>(local_addr); }
 
 
+void Region_map_client::detach_batch(Detach_batch const &batch) {
+	call<Rpc_detach_batch>(batch); }
+
+
 void Region_map_client::fault_handler(Signal_context_capability cap) {
 	call<Rpc_fault_handler>(cap); }
 
@@ -37,13 +37,15 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 {
 	using namespace Nova;
 
+	Rpc_entrypoint &ep = _serving_ep(*obj);
+
 	Untyped_capability ec_cap;
 
 	/* _ec_sel is invalid until thread gets started */
-	if (native_thread().ec_sel != Native_thread::INVALID_INDEX)
-		ec_cap = Capability_space::import(native_thread().ec_sel);
+	if (ep.native_thread().ec_sel != Native_thread::INVALID_INDEX)
+		ec_cap = Capability_space::import(ep.native_thread().ec_sel);
 	else
-		ec_cap = _thread_cap;
+		ec_cap = ep._thread_cap;
 
 	Untyped_capability obj_cap = _alloc_rpc_cap(_pd_session, ec_cap,
 	                                            (addr_t)&_activation_entry);
@@ -52,7 +54,7 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 
 	/* add server object to object pool */
 	obj->cap(obj_cap);
-	insert(obj);
+	_objects.insert(obj);
 
 	/* return object capability managed by entrypoint thread */
 	return obj_cap;
@@ -61,6 +63,8 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 
 void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 {
+	Rpc_entrypoint &ep = _serving_ep(*obj);
+
 	/* de-announce object from cap_session */
 	_free_rpc_cap(_pd_session, obj->cap());
 
@@ -68,11 +72,13 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 	Nova::revoke(Nova::Obj_crd(obj->cap().local_name(), 0), true);
 
 	/* make sure nobody is able to find this object */
-	remove(obj);
+	_objects.remove(obj);
 
 	/* effectively invalidate the capability used before */
 	obj->cap(Untyped_capability());
 
+	_release_serving_ep(*obj);
+
 	/*
 	 * The activation may execute a blocking operation in a dispatch function.
 	 * Before resolving the corresponding object, we need to ensure that it is
@@ -84,7 +90,7 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 
 	Utcb *utcb = reinterpret_cast<Utcb *>(Thread::myself()->utcb());
 	/* don't call ourself */
-	if (utcb == reinterpret_cast<Utcb *>(this->utcb()))
+	if (utcb == reinterpret_cast<Utcb *>(ep.utcb()))
 		return;
 
 	/*
@@ -92,17 +98,17 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 	 * a client which blocks on a session opening request where the service
 	 * is not up yet.
 	 */
-	cancel_blocking();
+	ep.cancel_blocking();
 
 	/* activate entrypoint now - otherwise cleanup call will block forever */
-	_delay_start.unlock();
+	ep._delay_start.unlock();
 
 	/* make a IPC to ensure that cap() identifier is not used anymore */
 	utcb->msg[0] = 0xdead;
 	utcb->set_msg_word(1);
-	if (uint8_t res = call(_cap.local_name()))
+	if (uint8_t res = call(ep._cap.local_name()))
 		PERR("%8p - could not clean up entry point of thread 0x%p - res %u",
-		     utcb, this->utcb(), res);
+		     utcb, ep.utcb(), res);
 }
 
 
@@ -170,7 +176,7 @@ void Rpc_entrypoint::_activation_entry()
 		try { exc = obj->dispatch(opcode, unmarshaller, ep._snd_buf); }
 		catch (Blocking_canceled) { }
 	};
-	ep.apply(id_pt, lambda);
+	ep._objects.apply(id_pt, lambda);
 
 	if (!rcv_window.prepare_rcv_window(*(Nova::Utcb *)ep.utcb()))
 		PWRN("out of capability selectors for handling server requests");
@@ -208,10 +214,21 @@ void Rpc_entrypoint::activate()
 Rpc_entrypoint::Rpc_entrypoint(Pd_session *pd_session, size_t stack_size,
                                const char  *name, bool start_on_construction,
                                Affinity::Location location)
+:
+	Rpc_entrypoint(pd_session, stack_size, name, start_on_construction,
+	               location, *this)
+{ }
+
+
+Rpc_entrypoint::Rpc_entrypoint(Pd_session *pd_session, size_t stack_size,
+                               const char  *name, bool start_on_construction,
+                               Affinity::Location location,
+                               Object_pool<Rpc_object_base> &objects)
 :
 	Thread(Cpu_session::Weight::DEFAULT_WEIGHT, name, stack_size, location),
 	_delay_start(Lock::LOCKED),
-	_pd_session(*pd_session)
+	_pd_session(*pd_session),
+	_objects(objects)
 {
 	/* set magic value evaluated by thread_nova.cc to start a local thread */
 	if (native_thread().ec_sel == Native_thread::INVALID_INDEX) {
@@ -25,7 +25,7 @@ using namespace Genode;
 void Signal_transmitter::submit(unsigned cnt)
 {
 	{
-		Trace::Signal_submit trace_event(cnt);
+		Trace::Signal_submit trace_event(cnt, _context.local_name());
 	}
 
 	if (!_context.valid())
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/thread_state.h>
+#include <base/trace/types.h>
 
 /* core includes */
 #include <pager.h>
@@ -162,6 +163,12 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return scheduling statistics of the thread
+			 */
+			Trace::Scheduling_stats scheduling_stats() const {
+				return Trace::Scheduling_stats(); }
+
 
 			/*****************************
 			 ** OKL4-specific Accessors **
@@ -27,3 +27,9 @@ void Rm_client::unmap(addr_t, addr_t virt_base, size_t size)
 	if (locked_address_space.valid())
 		locked_address_space->flush(virt_base, size);
 }
+
+
+/*
+ * Mappings are transferred by the kernel as reply to a page fault only
+ */
+bool Rm_client::map(Mapping const &) { return false; }
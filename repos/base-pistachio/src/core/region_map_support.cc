@@ -48,3 +48,9 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 		L4_Unmap(L4_FpageAddRightsTo(&fp, L4_FullyAccessible));
 	}
 }
+
+
+/*
+ * Mappings are transferred by the kernel as reply to a page fault only
+ */
+bool Rm_client::map(Mapping const &) { return false; }
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/thread_state.h>
+#include <base/trace/types.h>
 #include <util/string.h>
 
 /* core includes */
@@ -135,6 +136,12 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		 */
 		unsigned long long execution_time() const { return 0; }
 
+		/**
+		 * Return scheduling statistics of the thread
+		 */
+		Trace::Scheduling_stats scheduling_stats() const {
+			return Trace::Scheduling_stats(); }
+
 
 		/************************
 		 ** Accessor functions **
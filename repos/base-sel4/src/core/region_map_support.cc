@@ -13,6 +13,7 @@
 
 /* core includes */
 #include <rm_session_component.h>
+#include <install_mapping.h>
 
 using namespace Genode;
 
@@ -24,3 +25,10 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 	if (locked_address_space.valid())
 		locked_address_space->flush(virt_base, size);
 }
+
+
+bool Rm_client::map(Mapping const &mapping)
+{
+	install_mapping(mapping, badge());
+	return true;
+}
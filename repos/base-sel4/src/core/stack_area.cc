@@ -62,7 +62,7 @@ class Stack_area_region_map : public Region_map
 		Local_addr attach(Dataspace_capability ds_cap, /* ignored capability */
 		                  size_t size, off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable) override
+		                  bool executable, bool, bool) override
 		{
 			size = round_page(size);
 
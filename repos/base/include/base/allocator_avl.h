@@ -61,6 +61,12 @@ class Genode::Allocator_avl_base : public Range_allocator
 				short  _id;         /* for debugging   */
 				size_t _max_avail;  /* biggest free block size of subtree */
 
+				/* neighbours within the free list of the block's size class */
+				Block *_size_class_next = nullptr;
+				Block *_size_class_prev = nullptr;
+
+				friend class Allocator_avl_base;
+
 				/**
 				 * Request max_avail value of subtree
 				 */
@@ -173,6 +179,29 @@ class Genode::Allocator_avl_base : public Range_allocator
 		Allocator       *_md_alloc;       /* meta-data allocator           */
 		size_t           _md_entry_size;  /* size of block meta-data entry */
 
+		/*
+		 * Free blocks are additionally kept in one list per power-of-two
+		 * size class. The lists are always maintained but consulted by
+		 * 'alloc_aligned' only if enabled via 'size_class_lookup'.
+		 */
+		enum { NUM_SIZE_CLASSES = 8*sizeof(size_t) };
+
+		Block *_size_classes[NUM_SIZE_CLASSES];
+		size_t _size_class_mask   = 0;      /* bit set for non-empty classes */
+		bool   _size_class_lookup = false;
+
+		void _size_class_insert(Block *b);
+		void _size_class_remove(Block *b);
+
+		/**
+		 * Find free block for an allocation via the size-class lists
+		 *
+		 * \return  fitting block, or nullptr if no block was found
+		 *          within a bounded number of probes
+		 */
+		Block *_find_by_size_class(size_t size, unsigned align,
+		                           addr_t from, addr_t to);
+
 		/**
 		 * Alloc meta-data block
 		 */
@@ -236,7 +265,11 @@ class Genode::Allocator_avl_base : public Range_allocator
 		 * we can attach custom information to block meta data.
 		 */
 		Allocator_avl_base(Allocator *md_alloc, size_t md_entry_size) :
-			_md_alloc(md_alloc), _md_entry_size(md_entry_size) { }
+			_md_alloc(md_alloc), _md_entry_size(md_entry_size)
+		{
+			for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+				_size_classes[i] = nullptr;
+		}
 
 		~Allocator_avl_base() { _revert_allocations_and_ranges(); }
 
@@ -253,6 +286,17 @@ class Genode::Allocator_avl_base : public Range_allocator
 		 */
 		bool any_block_addr(addr_t *out_addr);
 
+		/**
+		 * Enable or disable the lookup of free blocks by size class
+		 *
+		 * When enabled, 'alloc_aligned' first tries to find a fitting
+		 * free block in constant time via the size-class lists and
+		 * resorts to the best-fit search in the address tree only if
+		 * this attempt fails. This speeds up allocations at the cost
+		 * of a possibly less tight fit.
+		 */
+		void size_class_lookup(bool enabled) { _size_class_lookup = enabled; }
+
 		/**
 		 * Debug hook
 		 *
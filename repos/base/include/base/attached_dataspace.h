@@ -50,11 +50,19 @@ class Genode::Attached_dataspace : Noncopyable
 		/**
 		 * Constructor
 		 *
+		 * \param populate  establish the mapping up front instead of on
+		 *                  first access, see 'Region_map::attach'
+		 *
 		 * \throw Rm_session::Attach_failed
 		 * \throw Invalid_dataspace
 		 */
-		Attached_dataspace(Region_map &rm, Dataspace_capability ds)
-		: _ds(_check(ds)), _local_addr(rm.attach(_ds)) { }
+		Attached_dataspace(Region_map &rm, Dataspace_capability ds,
+		                   bool populate = false)
+		:
+			_ds(_check(ds)),
+			_local_addr(rm.attach(_ds, 0, 0, false, (void *)0, false, false,
+			                      populate))
+		{ }
 
 		/**
 		 * Constructor
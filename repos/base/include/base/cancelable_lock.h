@@ -67,6 +67,21 @@ class Genode::Cancelable_lock
 		Applicant* volatile _last_applicant;
 		Applicant  _owner;
 
+		enum { INITIAL_SPIN_ROUNDS = 4 };
+
+		/*
+		 * Number of rounds a contending thread polls the lock before it
+		 * blocks, adapted to the observed behaviour of the lock holders
+		 */
+		unsigned volatile _spin_rounds = INITIAL_SPIN_ROUNDS;
+
+		unsigned _spin();
+
+		/**
+		 * Account contended lock acquisition
+		 */
+		void _adapt_spinning(unsigned spins, bool blocked);
+
 	public:
 
 		enum State { LOCKED, UNLOCKED };
@@ -441,6 +441,13 @@ class Genode::Child : protected Rpc_object<Parent>
 		 */
 		void revoke_server(const Server *server);
 
+		/**
+		 * Return true if the child has a session to the specified server
+		 *
+		 * As for 'revoke_server', the server argument is not de-referenced.
+		 */
+		bool has_session_to(const Server *server);
+
 		/**
 		 * Instruct the child to yield resources
 		 *
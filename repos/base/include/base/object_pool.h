@@ -16,12 +16,90 @@
 #ifndef _INCLUDE__BASE__OBJECT_POOL_H_
 #define _INCLUDE__BASE__OBJECT_POOL_H_
 
-#include <util/avl_tree.h>
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
+#include <base/semaphore.h>
+#include <cpu/memory_barrier.h>
 
-namespace Genode { template <typename> class Object_pool; }
+namespace Genode {
+
+	class Object_pool_base;
+
+	template <typename> class Object_pool;
+}
+
+
+/**
+ * Type-agnostic synchronization of object-pool lookups and removals
+ *
+ * Lookups in the object pool do not take a lock. Instead, each lookup is
+ * enclosed in a read-side critical section, which is counted per epoch.
+ * A removal unlinks the entry and then waits until all lookups that might
+ * still refer to the entry have left their critical sections. Only after
+ * this grace period, the removed entry may be destructed by the caller.
+ */
+class Genode::Object_pool_base
+{
+	private:
+
+		volatile int _epoch = 0;
+		volatile int _readers[2] { 0, 0 };
+
+		/*
+		 * Reader counter a removal waits for, incremented by one, or 0
+		 */
+		volatile int _draining = 0;
+
+		/*
+		 * Blocks the removal until the last reader of the drained epoch
+		 * left its critical section
+		 */
+		Semaphore _drained;
+
+		void _dec_readers(int index);
+
+	protected:
+
+		/*
+		 * Serializes modifications of the pool, lookups do not take it
+		 */
+		Lock _lock;
+
+		/**
+		 * Enter read-side critical section
+		 *
+		 * \return  epoch token to be passed to '_leave_read'
+		 */
+		int _enter_read();
+
+		/**
+		 * Leave read-side critical section
+		 */
+		void _leave_read(int epoch);
+
+		/**
+		 * Wait until all read-side critical sections entered prior to the
+		 * call have been left
+		 *
+		 * The caller blocks instead of polling. So a preempted reader of
+		 * lower priority gets the chance to leave its critical section.
+		 *
+		 * Must be called with '_lock' held.
+		 */
+		void _wait_for_readers();
+
+		struct Read_guard
+		{
+			Object_pool_base &pool;
+			int const         epoch;
+
+			Read_guard(Object_pool_base &pool)
+			: pool(pool), epoch(pool._enter_read()) { }
+
+			~Read_guard() { pool._leave_read(epoch); }
+		};
+};
 
 
 /**
@@ -33,16 +111,15 @@ namespace Genode { template <typename> class Object_pool; }
  * objects managed by one and the same object pool.
  */
 template <typename OBJ_TYPE>
-class Genode::Object_pool
+class Genode::Object_pool : public Object_pool_base
 {
 	public:
 
-		class Entry : public Avl_node<Entry>
+		class Entry
 		{
 			private:
 
 				friend class Object_pool;
-				friend class Avl_tree<Entry>;
 
 				struct Entry_lock : Weak_object<Entry_lock>, Noncopyable
 				{
@@ -56,6 +133,9 @@ class Genode::Object_pool
 				Untyped_capability _cap;
 				Entry_lock         _lock { *this };
 
+				/* next entry within the same hash bucket */
+				Entry * volatile   _next = nullptr;
+
 				inline unsigned long _obj_id() { return _cap.local_name(); }
 
 			public:
@@ -65,24 +145,6 @@ class Genode::Object_pool
 
 				virtual ~Entry() { }
 
-				/**
-				 * Avl_node interface
-				 */
-				bool higher(Entry *e) { return e->_obj_id() > _obj_id(); }
-				void recompute() { }  /* for gcc-3.4 compatibility */
-
-				/**
-				 * Support for object pool
-				 */
-				Entry *find_by_obj_id(unsigned long obj_id)
-				{
-					if (obj_id == _obj_id()) return this;
-
-					Entry *obj = this->child(obj_id > _obj_id());
-
-					return obj ? obj->find_by_obj_id(obj_id) : 0;
-				}
-
 				/**
 				 * Assign capability to object pool entry
 				 */
@@ -93,15 +155,51 @@ class Genode::Object_pool
 
 	private:
 
-		Avl_tree<Entry> _tree;
-		Lock            _lock;
+		enum { NUM_BUCKETS = 256 };
+
+		Entry * volatile _buckets[NUM_BUCKETS] { };
+
+		static unsigned _bucket(unsigned long obj_id)
+		{
+			/* multiplicative hashing spreads consecutive IDs */
+			return (unsigned)((obj_id * 2654435761UL) >> 8) % NUM_BUCKETS;
+		}
+
+		/**
+		 * Unlink entry from its bucket, called with '_lock' held
+		 *
+		 * The '_next' pointer of the removed entry stays intact so that
+		 * concurrent lookups traversing the entry can proceed.
+		 */
+		bool _unlink(Entry *e)
+		{
+			Entry * volatile *link = &_buckets[_bucket(e->_obj_id())];
+
+			for (; *link; link = &(*link)->_next) {
+				if (*link != e)
+					continue;
+
+				*link = e->_next;
+				return true;
+			}
+			return false;
+		}
+
+		Entry *_any_entry()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				if (_buckets[i])
+					return _buckets[i];
+
+			return nullptr;
+		}
 
 	protected:
 
 		bool empty()
 		{
 			Lock::Guard lock_guard(_lock);
-			return _tree.first() == nullptr;
+			return _any_entry() == nullptr;
 		}
 
 	public:
@@ -109,13 +207,28 @@ class Genode::Object_pool
 		void insert(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+
+			Entry * const e = obj;
+			Entry * volatile &head = _buckets[_bucket(e->_obj_id())];
+
+			/* publish the completely initialized entry to lookups */
+			e->_next = head;
+			memory_barrier();
+			head = e;
 		}
 
+		/**
+		 * Remove object from pool
+		 *
+		 * When returning, no lookup refers to the object anymore. Hence,
+		 * the caller is free to destruct it.
+		 */
 		void remove(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+
+			if (_unlink(obj))
+				_wait_for_readers();
 		}
 
 		template <typename FUNC>
@@ -130,10 +243,10 @@ class Genode::Object_pool
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Read_guard read_guard(*this);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry *entry = _buckets[_bucket(capid)];
+				for (; entry && entry->_obj_id() != capid; entry = entry->_next);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -165,15 +278,20 @@ class Genode::Object_pool
 				{
 					Lock::Guard lock_guard(_lock);
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+					Entry *e = _any_entry();
+					if (!e) return;
+
+					obj = static_cast<OBJ_TYPE *>(e);
 
-					Weak_ptr ptr = obj->_lock.weak_ptr();
+					Weak_ptr ptr = e->_lock.weak_ptr();
 					{
 						Locked_ptr lock_ptr(ptr);
 						if (!lock_ptr.valid()) return;
 
-						_tree.remove(obj);
+						_unlink(e);
 					}
+
+					_wait_for_readers();
 				}
 
 				func(obj);
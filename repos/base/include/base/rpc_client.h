@@ -133,7 +133,7 @@ namespace Genode {
 		_marshal_args(call_buf, args);
 
 		{
-			Trace::Rpc_call trace_event(IF::name(), call_buf);
+			Trace::Rpc_call trace_event(IF::name(), call_buf, local_name());
 		}
 
 		/* perform RPC, unmarshal return value */
@@ -147,7 +147,7 @@ namespace Genode {
 		unmarshaller.extract(ret);
 
 		{
-			Trace::Rpc_returned trace_event(IF::name(), reply_buf);
+			Trace::Rpc_returned trace_event(IF::name(), reply_buf, local_name());
 		}
 
 		/* unmarshal RPC output arguments */
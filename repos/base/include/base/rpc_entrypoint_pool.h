@@ -0,0 +1,161 @@
+/*
+ * \brief  RPC entrypoint served by multiple threads
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+
+#include <base/rpc_server.h>
+#include <base/allocator.h>
+#include <base/snprintf.h>
+#include <util/misc_math.h>
+
+
+/**
+ * RPC entrypoint with additional worker threads
+ *
+ * The pool is a regular 'Rpc_entrypoint' whose object pool is shared with
+ * a number of worker threads. Objects are served by the pool's primary
+ * thread unless they declare to support concurrent dispatching via
+ * 'Rpc_object_base::concurrent_dispatch'. Such objects are assigned to
+ * the worker thread that serves the fewest objects at the time the object
+ * is managed. Each object is always served by the same
+ * thread, which implies that calls of one object are never executed
+ * concurrently.
+ *
+ * Because the pool is an 'Rpc_entrypoint', it can be used wherever an
+ * entrypoint is expected. In particular, lookups via 'apply' find the
+ * objects of all threads.
+ */
+class Genode::Rpc_entrypoint_pool : public Rpc_entrypoint
+{
+	public:
+
+		enum { MAX_WORKERS = 32 };
+
+	private:
+
+		struct Worker : Rpc_entrypoint
+		{
+			Worker(Pd_session *pd_session, size_t stack_size, char const *name,
+			       Affinity::Location location, Rpc_entrypoint_pool &pool)
+			:
+				Rpc_entrypoint(pd_session, stack_size, name, true, location, pool)
+			{ }
+		};
+
+		Allocator &_alloc;
+		unsigned   _num_workers = 0;
+		Worker    *_workers[MAX_WORKERS];
+		unsigned   _num_objects[MAX_WORKERS] { };  /* objects per worker */
+		Lock       _assign_lock;
+
+		static Affinity::Location _location(Affinity::Space space, unsigned i)
+		{
+			return space.total() ? space.location_of_index(i % space.total())
+			                     : Affinity::Location();
+		}
+
+	protected:
+
+		/**
+		 * Rpc_entrypoint interface
+		 */
+		Rpc_entrypoint &_serving_ep(Rpc_object_base &obj) override
+		{
+			if (!_num_workers || !obj.concurrent_dispatch())
+				return *this;
+
+			Lock::Guard guard(_assign_lock);
+
+			/* assign object to the least loaded worker when managed */
+			if (!obj._worker) {
+				unsigned least = 0;
+				for (unsigned i = 1; i < _num_workers; i++)
+					if (_num_objects[i] < _num_objects[least])
+						least = i;
+
+				_num_objects[least]++;
+				obj._worker = least + 1;
+			}
+
+			return *_workers[obj._worker - 1];
+		}
+
+		/**
+		 * Rpc_entrypoint interface
+		 */
+		void _release_serving_ep(Rpc_object_base &obj) override
+		{
+			Lock::Guard guard(_assign_lock);
+
+			if (!obj._worker)
+				return;
+
+			_num_objects[obj._worker - 1]--;
+			obj._worker = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param pd_session   PD session for creating capabilities
+		 * \param stack_size   stack size of each entrypoint thread
+		 * \param name         name of the entrypoint threads
+		 * \param alloc        allocator used for the worker threads
+		 * \param space        affinity space for pinning the threads, the
+		 *                     primary thread is placed at the first CPU,
+		 *                     worker 'i' at the CPU with index 'i + 1'.
+		 *                     If the space is empty, threads are not pinned.
+		 * \param num_workers  number of worker threads
+		 *
+		 * The worker threads serve requests right from the start. Only the
+		 * primary thread respects the 'start_on_construction' argument.
+		 */
+		Rpc_entrypoint_pool(Pd_session *pd_session, size_t stack_size,
+		                    char const *name, Allocator &alloc,
+		                    Affinity::Space space, unsigned num_workers,
+		                    bool start_on_construction = true)
+		:
+			Rpc_entrypoint(pd_session, stack_size, name,
+			               start_on_construction, _location(space, 0)),
+			_alloc(alloc)
+		{
+			num_workers = min(num_workers, (unsigned)MAX_WORKERS);
+
+			for (; _num_workers < num_workers; _num_workers++) {
+
+				char worker_name[32];
+				snprintf(worker_name, sizeof(worker_name), "%s.%u",
+				         name, _num_workers + 1);
+
+				_workers[_num_workers] = new (&_alloc)
+					Worker(pd_session, stack_size, worker_name,
+					       _location(space, _num_workers + 1), *this);
+			}
+		}
+
+		~Rpc_entrypoint_pool()
+		{
+			while (_num_workers)
+				destroy(&_alloc, _workers[--_num_workers]);
+		}
+
+		/**
+		 * Return number of worker threads
+		 */
+		unsigned num_workers() const { return _num_workers; }
+};
+
+#endif /* _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_ */
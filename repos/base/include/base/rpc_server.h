@@ -31,6 +31,7 @@ namespace Genode {
 	class Rpc_object_base;
 	template <typename, typename> struct Rpc_object;
 	class Rpc_entrypoint;
+	class Rpc_entrypoint_pool;
 }
 
 
@@ -126,7 +127,8 @@ class Genode::Rpc_dispatcher : public RPC_INTERFACE
 				_read_args(in, args);
 
 				{
-					Trace::Rpc_dispatch trace_event(This_rpc_function::name());
+					Trace::Rpc_dispatch trace_event(This_rpc_function::name(),
+					                                (unsigned long)this);
 				}
 
 				/*
@@ -144,7 +146,8 @@ class Genode::Rpc_dispatcher : public RPC_INTERFACE
 				out.insert(ret);
 
 				{
-					Trace::Rpc_reply trace_event(This_rpc_function::name());
+					Trace::Rpc_reply trace_event(This_rpc_function::name(),
+					                             (unsigned long)this);
 				}
 
 				/* write results to outgoing message */
@@ -195,6 +198,16 @@ class Genode::Rpc_dispatcher : public RPC_INTERFACE
 
 class Genode::Rpc_object_base : public Object_pool<Rpc_object_base>::Entry
 {
+	private:
+
+		friend class Rpc_entrypoint_pool;
+
+		/*
+		 * Worker thread of an 'Rpc_entrypoint_pool' assigned to the object,
+		 * incremented by one, or 0 if unassigned
+		 */
+		unsigned _worker = 0;
+
 	public:
 
 		virtual ~Rpc_object_base() { }
@@ -208,6 +221,19 @@ class Genode::Rpc_object_base : public Object_pool<Rpc_object_base>::Entry
 		 */
 		virtual Rpc_exception_code
 		dispatch(Rpc_opcode op, Ipc_unmarshaller &in, Msgbuf_base &out) = 0;
+
+		/**
+		 * Return true if the object may be served concurrently to other
+		 * objects of the same entrypoint
+		 *
+		 * By default, all objects of an entrypoint are served by a single
+		 * thread and are thereby serialized with each other. When managed
+		 * by an 'Rpc_entrypoint_pool', objects that return true are
+		 * distributed among the worker threads of the pool. Such objects
+		 * must synchronize accesses to state shared with other objects and
+		 * must not use the 'reply_dst' or 'omit_reply' mechanism.
+		 */
+		virtual bool concurrent_dispatch() const { return false; }
 };
 
 
@@ -310,6 +336,42 @@ class Genode::Rpc_entrypoint : Thread, public Object_pool<Rpc_object_base>
 		 */
 		Untyped_capability _manage(Rpc_object_base *obj);
 
+		/**
+		 * Pool of objects looked up when dispatching requests
+		 *
+		 * This is the entrypoint itself unless the entrypoint is a worker
+		 * thread of an 'Rpc_entrypoint_pool'.
+		 */
+		Object_pool<Rpc_object_base> &_objects;
+
+		/**
+		 * Return entrypoint thread that serves the specified object
+		 *
+		 * \noapi
+		 */
+		virtual Rpc_entrypoint &_serving_ep(Rpc_object_base &) { return *this; }
+
+		/**
+		 * Release the assignment of the object to its entrypoint thread
+		 *
+		 * Called when dissolving the object.
+		 *
+		 * \noapi
+		 */
+		virtual void _release_serving_ep(Rpc_object_base &) { }
+
+		/**
+		 * Constructor used for the worker threads of an 'Rpc_entrypoint_pool'
+		 *
+		 * \param objects  pool of objects dispatched by the thread
+		 *
+		 * \noapi
+		 */
+		Rpc_entrypoint(Pd_session *pd_session, size_t stack_size,
+		               char const *name, bool start_on_construction,
+		               Affinity::Location location,
+		               Object_pool<Rpc_object_base> &objects);
+
 		/**
 		 * Back end used to Dissolve RPC object from entry point
 		 *
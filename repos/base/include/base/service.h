@@ -441,6 +441,20 @@ class Genode::Service_registry
 		 */
 		void remove(Service *service) { _services.remove(service); }
 
+		/**
+		 * Apply functor to each registered service
+		 *
+		 * The functor must not modify the registry.
+		 */
+		template <typename FUNC>
+		void for_each(FUNC const &fn)
+		{
+			Lock::Guard lock_guard(_service_wait_queue_lock);
+
+			for (Service *s = _services.first(); s; s = s->next())
+				fn(*s);
+		}
+
 		/**
 		 * Unregister all services
 		 */
@@ -47,18 +47,39 @@ class Genode::Slab : public Allocator
 		size_t _num_blocks  = 0;
 		size_t _total_avail = 0;
 
-		/**
-		 * Block used for attempting the next allocation
+		/*
+		 * Slab blocks are kept in three lists according to their fill
+		 * state. Allocations are served from the partially used blocks
+		 * first and fall back to empty blocks, which makes the selection
+		 * of a block a constant-time operation.
 		 */
-		Block *_curr_sb = nullptr;
+		Block *_partial_blocks = nullptr;
+		Block *_empty_blocks   = nullptr;
+		Block *_full_blocks    = nullptr;
+
+		size_t _num_empty_blocks = 0;
 
 		Allocator   *_backing_store;
 
+		/**
+		 * Calculate number of entries that fit into one slab block
+		 */
+		static size_t _calc_entries_per_block(size_t slab_size,
+		                                      size_t block_size);
+
 		/**
 		 * Allocate and initialize new slab block
 		 */
 		Block *_new_slab_block();
 
+		/**
+		 * Return list head of the blocks with the fill state of 'block'
+		 */
+		Block *&_list_of(Block const &block);
+
+		void _enqueue(Block &block);
+		void _dequeue(Block &block);
+
 
 		/*****************************
 		 ** Methods used by 'Block' **
@@ -67,16 +88,16 @@ class Genode::Slab : public Allocator
 		void _release_backing_store(Block *);
 
 		/**
-		 * Insert block into slab block ring
+		 * Insert block into the list of empty blocks
 		 *
 		 * \noapi
 		 */
 		void _insert_sb(Block *);
 
 		/**
-		 * Release slab block
+		 * Release empty slab blocks exceeding the hysteresis threshold
 		 */
-		void _free_curr_sb();
+		void _release_empty_blocks();
 
 		/**
 		 * Free slab entry
@@ -145,6 +145,14 @@ class Genode::Thread
 		 */
 		static Trace::Logger *_logger();
 
+		/**
+		 * Return 'Trace::Logger' instance of calling thread if initialized
+		 *
+		 * In contrast to '_logger', this method never initializes the
+		 * logger. It returns 0 for the main thread.
+		 */
+		static Trace::Logger *_initialized_logger();
+
 		/**
 		 * Hook for platform-specific constructor supplements
 		 *
@@ -410,6 +418,16 @@ class Genode::Thread
 		 */
 		template <typename EVENT>
 		static void trace(EVENT const *event) { _logger()->log(event); }
+
+		/**
+		 * Log trace event only if tracing is readily set up for the thread
+		 *
+		 * This variant is meant for low-level mechanisms like locks, which
+		 * are used by the initialization of tracing itself.
+		 */
+		template <typename EVENT>
+		static void trace_if_ready(EVENT const *event) {
+			_initialized_logger()->log_if_ready(event); }
 };
 
 
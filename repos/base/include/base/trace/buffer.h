@@ -17,41 +17,140 @@
 #include <base/stdint.h>
 #include <base/thread.h>
 #include <cpu_session/cpu_session.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode { namespace Trace { class Buffer; } }
 
 
 /**
  * Buffer shared between CPU client thread and TRACE client
+ *
+ * The CPU client thread (writer) appends entries to the buffer. The TRACE
+ * client (reader) consumes the entries by using a 'Cursor', which keeps
+ * track of the read position and of the number of entries the reader
+ * missed. Each entry carries a sequence number so that the reader can tell
+ * the number of lost entries exactly.
+ *
+ * In 'OVERWRITE' mode, which is the default, the writer never blocks and
+ * overwrites the oldest entries if the reader does not keep up. In
+ * 'DROP_NEWEST' mode, the writer drops new entries instead of overwriting
+ * entries not yet consumed. The reader announces its position to the
+ * writer for this purpose.
  */
 class Genode::Trace::Buffer
 {
+	public:
+
+		enum Mode { OVERWRITE = 0, DROP_NEWEST = 1 };
+
+		class Entry;
+		class Cursor;
+
 	private:
 
-		unsigned volatile _head_offset;  /* in bytes, relative to 'entries' */
-		unsigned volatile _size;         /* in bytes */
-		unsigned volatile _wrapped;      /* count of buffer wraps */
+		/*
+		 * Members written by the CPU client
+		 */
+		unsigned volatile _head_offset;     /* in bytes, relative to 'entries' */
+		unsigned volatile _size;            /* in bytes */
+		unsigned volatile _wrapped;         /* count of buffer wraps */
+		unsigned volatile _reserved_offset; /* end of the region touched ... */
+		unsigned volatile _reserved_wrapped; /* ... during this lap */
+		unsigned long volatile _seqno;      /* sequence number of next entry */
+		unsigned long volatile _dropped;    /* entries dropped in 'DROP_NEWEST' mode */
+
+		/*
+		 * Members written by the TRACE client, which are zero as long as
+		 * the client does not use them because the buffer is allocated
+		 * from zero-initialized RAM
+		 */
+		unsigned volatile _mode;
+		unsigned volatile _tail_offset;     /* read position of the reader */
+		unsigned volatile _tail_wrapped;
+		unsigned long volatile _lost;       /* entries missed by the reader */
 
 		struct _Entry
 		{
-			size_t len;
-			char   data[0];
+			size_t        len;
+			unsigned long seqno;
+			char          data[0];
 		};
 
 		_Entry _entries[0];
 
+		/*
+		 * The 'entries' member marks the beginning of the trace buffer
+		 * entries. No other member variables must follow.
+		 */
+
 		_Entry *_head_entry() { return (_Entry *)((addr_t)_entries + _head_offset); }
 
+		_Entry const *_entry_at(unsigned offset) const {
+			return (_Entry const *)((addr_t)_entries + offset); }
+
 		void _buffer_wrapped()
 		{
 			_head_offset = 0;
+			memory_barrier();
 			_wrapped++;
 		}
 
-		/*
-		 * The 'entries' member marks the beginning of the trace buffer
-		 * entries. No other member variables must follow.
+		/**
+		 * Announce the region to be written to the reader
+		 *
+		 * The writer must not touch the buffer beyond 'end' before calling
+		 * this method.
 		 */
+		void _reserve_until(unsigned end)
+		{
+			_reserved_offset = end;
+			memory_barrier();
+			_reserved_wrapped = _wrapped;
+			memory_barrier();
+		}
+
+		/**
+		 * Mark the end of the current lap and wrap
+		 */
+		void _wrap()
+		{
+			unsigned const marker_end = _head_offset + sizeof(size_t);
+
+			if (marker_end <= _size) {
+				_reserve_until(marker_end);
+				_head_entry()->len = 0;
+			}
+
+			_buffer_wrapped();
+		}
+
+		/**
+		 * Return true if 'needed' bytes may be written at 'offset' during
+		 * the lap 'wrapped'
+		 */
+		bool _fits(unsigned offset, unsigned wrapped, size_t needed) const
+		{
+			if (_mode != DROP_NEWEST)
+				return true;
+
+			/* read the lap first, the reader updates the offset first */
+			unsigned const tail_wrapped = _tail_wrapped;
+			memory_barrier();
+			unsigned const tail_offset  = _tail_offset;
+
+			switch (wrapped - tail_wrapped) {
+			case 0:  return true;
+			case 1:  return offset + needed <= tail_offset;
+			default: return false;
+			}
+		}
+
+		char *_drop()
+		{
+			_seqno++;
+			_dropped++;
+			return 0;
+		}
 
 	public:
 
@@ -61,26 +160,55 @@ class Genode::Trace::Buffer
 
 		void init(size_t size)
 		{
-			_head_offset = 0;
-
 			/* compute number of bytes available for tracing data */
 			size_t const header_size = (addr_t)&_entries - (addr_t)this;
 
+			/*
+			 * If the buffer was used before, e.g., prior a policy change,
+			 * continue with a new lap so that the reader stays in sync.
+			 */
+			if (_size == size - header_size) {
+				_wrap();
+				return;
+			}
+
+			_head_offset      = 0;
+			_reserved_offset  = 0;
+			_reserved_wrapped = 0;
+			_seqno            = 0;
+			_dropped          = 0;
+
 			_size = size - header_size;
 
 			_wrapped = 0;
 		}
 
+		/**
+		 * Reserve space for an entry of up to 'len' bytes
+		 *
+		 * \return pointer to the entry data, or 0 if the entry must be
+		 *         dropped
+		 */
 		char *reserve(size_t len)
 		{
-			if (_head_offset + sizeof(_Entry) + len <= _size)
-				return _head_entry()->data;
+			size_t const needed = sizeof(_Entry) + len;
 
-			/* mark last entry with len 0 and wrap */
-			if (_head_offset + sizeof(_Entry) <= _size)
-				_head_entry()->len = 0;
+			if (needed > _size)
+				return _drop();
 
-			_buffer_wrapped();
+			if (_head_offset + needed > _size) {
+
+				if (!_fits(0, _wrapped + 1, needed))
+					return _drop();
+
+				/* mark last entry with len 0 and wrap */
+				_wrap();
+
+			} else if (!_fits(_head_offset, _wrapped, needed)) {
+				return _drop();
+			}
+
+			_reserve_until(_head_offset + needed);
 
 			return _head_entry()->data;
 		}
@@ -91,7 +219,11 @@ class Genode::Trace::Buffer
 			if (len == 0)
 				return;
 
-			_head_entry()->len = len;
+			_head_entry()->seqno = _seqno++;
+			_head_entry()->len   = len;
+
+			/* make the entry visible before advancing the head */
+			memory_barrier();
 
 			/* advance head offset, wrap when reaching buffer boundary */
 			_head_offset += sizeof(_Entry) + len;
@@ -111,14 +243,22 @@ class Genode::Trace::Buffer
 			private:
 
 				_Entry const *_entry;
+				size_t        _len   = 0;
+				unsigned long _seqno = 0;
 
 				friend class Buffer;
 
-				Entry(_Entry const *entry) : _entry(entry) { }
+				Entry(_Entry const *entry) : _entry(entry)
+				{
+					if (_entry) {
+						_len   = _entry->len;
+						_seqno = _entry->seqno;
+					}
+				}
 
 			public:
 
-				size_t      length() const { return _entry->len; }
+				size_t      length() const { return _len; }
 				char const *data()   const { return _entry->data; }
 				bool        last()   const { return _entry == 0; }
 
@@ -128,11 +268,148 @@ class Genode::Trace::Buffer
 				bool is_last() const { return last(); }
 		};
 
+		/**
+		 * Read position of a TRACE client
+		 */
+		class Cursor
+		{
+			private:
+
+				friend class Buffer;
+
+				unsigned      _offset  = 0;
+				unsigned      _wrapped = 0;
+				unsigned long _seqno   = 0; /* expected sequence number */
+				unsigned long _lost    = 0;
+				unsigned long _read    = 0;
+
+			public:
+
+				/**
+				 * Return number of entries missed by the reader
+				 */
+				unsigned long lost() const { return _lost; }
+
+				/**
+				 * Return number of entries consumed by the reader
+				 */
+				unsigned long read() const { return _read; }
+		};
+
+		/**
+		 * Select the behaviour of the writer if the buffer is full
+		 */
+		void mode(Mode mode) { _mode = mode; }
+
+		/**
+		 * Return number of entries produced by the writer, including
+		 * dropped ones
+		 */
+		unsigned long produced() const { return _seqno; }
+
+		/**
+		 * Return number of entries lost as observed by the reader or
+		 * dropped by the writer
+		 */
+		unsigned long lost() const { return max(_lost, _dropped); }
+
+		/**
+		 * Return entry at the cursor position
+		 *
+		 * If the writer has overwritten the entries at the cursor position,
+		 * the cursor is moved to the oldest entry still available. If no
+		 * unread entry exists, the returned entry is the last one.
+		 *
+		 * Because the writer may overwrite the entry while it is processed,
+		 * the result of the processing is valid only if 'advance' returns
+		 * true.
+		 */
+		Entry peek(Cursor &cursor)
+		{
+			for (;;) {
+
+				/* obtain consistent snapshot of the writer position */
+				unsigned wrapped, head;
+				do {
+					wrapped = _wrapped;
+					memory_barrier();
+					head = _head_offset;
+					memory_barrier();
+				} while (wrapped != _wrapped);
+
+				if (wrapped == cursor._wrapped && cursor._offset <= head) {
+
+					if (cursor._offset == head)
+						return Entry(0);
+
+					return Entry(_entry_at(cursor._offset));
+				}
+
+				if (wrapped == cursor._wrapped + 1) {
+
+					/* remaining entries of the previous lap */
+					bool const end_of_lap =
+						cursor._offset + sizeof(_Entry) > _size
+						|| _entry_at(cursor._offset)->len == 0;
+
+					Entry const entry(end_of_lap ? 0 : _entry_at(cursor._offset));
+
+					bool const intact =
+						cursor._offset + sizeof(_Entry) + entry.length() <= _size;
+
+					if (_valid(cursor) && intact) {
+						if (!end_of_lap)
+							return entry;
+
+						_move(cursor, 0, cursor._wrapped + 1);
+						continue;
+					}
+				}
+
+				/* entries at the cursor were overwritten */
+				_move(cursor, 0, wrapped);
+			}
+		}
+
+		/**
+		 * Move cursor past the entry returned by 'peek'
+		 *
+		 * \return true if the entry stayed intact while being processed
+		 */
+		bool advance(Cursor &cursor, Entry const &entry)
+		{
+			if (entry.last())
+				return false;
+
+			bool const valid = _valid(cursor);
+
+			if (valid) {
+				cursor._lost  += entry._seqno - cursor._seqno;
+				cursor._seqno  = entry._seqno + 1;
+				cursor._read++;
+				_lost = cursor._lost;
+			}
+
+			_move(cursor, cursor._offset + sizeof(_Entry) + entry.length(),
+			      cursor._wrapped);
+
+			return valid;
+		}
+
+		/**
+		 * Return first entry of the buffer
+		 *
+		 * \deprecated  use 'peek' and 'advance' with a 'Cursor', which
+		 *              detect overwritten entries
+		 */
 		Entry first() const
 		{
 			return _entries->len ? Entry(_entries) : Entry(0);
 		}
 
+		/**
+		 * \deprecated  use 'peek' and 'advance' with a 'Cursor'
+		 */
 		Entry next(Entry entry) const
 		{
 			if (entry.last())
@@ -147,6 +424,52 @@ class Genode::Trace::Buffer
 
 			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
 		}
+
+	private:
+
+		/**
+		 * Return true if the writer has not touched the cursor position
+		 * since the cursor's lap
+		 */
+		bool _valid(Cursor const &cursor) const
+		{
+			memory_barrier();
+
+			unsigned wrapped, reserved_wrapped, reserved;
+			do {
+				wrapped          = _wrapped;
+				reserved_wrapped = _reserved_wrapped;
+				memory_barrier();
+				reserved         = _reserved_offset;
+				memory_barrier();
+			} while (wrapped != _wrapped || reserved_wrapped != _reserved_wrapped);
+
+			if (wrapped == cursor._wrapped)
+				return true;
+
+			/*
+			 * In the subsequent lap, the writer touched the buffer up to the
+			 * end of its latest reservation, if any.
+			 */
+			if (reserved_wrapped != wrapped)
+				reserved = 0;
+
+			return wrapped == cursor._wrapped + 1 && cursor._offset >= reserved;
+		}
+
+		/**
+		 * Move cursor and announce the new position to the writer
+		 */
+		void _move(Cursor &cursor, unsigned offset, unsigned wrapped)
+		{
+			cursor._offset  = offset;
+			cursor._wrapped = wrapped;
+
+			/* update offset first, see '_fits' */
+			_tail_offset = offset;
+			memory_barrier();
+			_tail_wrapped = wrapped;
+		}
 };
 
 #endif /* _INCLUDE__BASE__TRACE__BUFFER_H_ */
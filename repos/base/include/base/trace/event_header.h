@@ -0,0 +1,68 @@
+/*
+ * \brief  Binary header of trace events
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__TRACE__EVENT_HEADER_H_
+#define _INCLUDE__BASE__TRACE__EVENT_HEADER_H_
+
+#include <base/fixed_stdint.h>
+#include <util/string.h>
+
+namespace Genode { namespace Trace { struct Event_header; } }
+
+
+/**
+ * Header preceding the policy-generated payload of each trace event
+ *
+ * The header is written by the 'Trace::Logger'. The payload of 'length'
+ * bytes follows the header immediately. Hence, a sequence of events can be
+ * stored as a plain byte stream of headers and payloads, which is the
+ * format understood by the 'trace_decode' tool. Within a trace buffer,
+ * events are not guaranteed to be naturally aligned. Therefore, the header
+ * must be accessed via 'read' and 'write'.
+ */
+struct Genode::Trace::Event_header
+{
+	enum Type {
+		TEXT            = 0,  /* event logged via 'Thread::trace(char const *)' */
+		RPC_CALL        = 1,
+		RPC_RETURNED    = 2,
+		RPC_DISPATCH    = 3,
+		RPC_REPLY       = 4,
+		SIGNAL_SUBMIT   = 5,
+		SIGNAL_RECEIVED = 6,
+		LOCK_CONTENTION = 7,
+		CHECKPOINT      = 8,
+	};
+
+	uint64_t timestamp; /* value of the CPU's cycle counter          */
+	uint64_t object;    /* event-specific object, e.g., RPC target    */
+	uint32_t thread;    /* component-local ID of the logging thread   */
+	uint32_t subject;   /* trace-subject ID, assigned by the consumer */
+	uint16_t type;
+	uint16_t cpu;       /* CPU affinity of the logging thread         */
+	uint32_t length;    /* payload size in bytes                      */
+
+	static Event_header read(void const *src)
+	{
+		Event_header header;
+		memcpy(&header, src, sizeof(header));
+		return header;
+	}
+
+	void write(void *dst) const { memcpy(dst, this, sizeof(*this)); }
+
+	static char const *payload(void const *event) {
+		return (char const *)event + sizeof(Event_header); }
+};
+
+#endif /* _INCLUDE__BASE__TRACE__EVENT_HEADER_H_ */
@@ -16,6 +16,7 @@
 
 #include <base/thread.h>
 #include <base/trace/policy.h>
+#include <base/trace/event_header.h>
 
 namespace Genode { namespace Trace {
 
@@ -25,16 +26,28 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Lock_contention;
+	struct Checkpoint;
 } }
 
 
+/*
+ * Each event type provides the 'TYPE' and the 'object' to be recorded in the
+ * 'Event_header'. For RPC calls, the object is the local name of the invoked
+ * capability. For RPCs dispatched at the server, it is the address of the
+ * RPC object.
+ */
+
 struct Genode::Trace::Rpc_call
 {
+	enum { TYPE = Event_header::RPC_CALL };
+
 	char        const *rpc_name;
 	Msgbuf_base const &msg;
+	unsigned long const object;
 
-	Rpc_call(char const *rpc_name, Msgbuf_base const &msg)
-	: rpc_name(rpc_name), msg(msg)
+	Rpc_call(char const *rpc_name, Msgbuf_base const &msg, unsigned long object)
+	: rpc_name(rpc_name), msg(msg), object(object)
 	{
 		Thread::trace(this);
 	}
@@ -46,11 +59,14 @@ struct Genode::Trace::Rpc_call
 
 struct Genode::Trace::Rpc_returned
 {
+	enum { TYPE = Event_header::RPC_RETURNED };
+
 	char        const *rpc_name;
 	Msgbuf_base const &msg;
+	unsigned long const object;
 
-	Rpc_returned(char const *rpc_name, Msgbuf_base const &msg)
-	: rpc_name(rpc_name), msg(msg)
+	Rpc_returned(char const *rpc_name, Msgbuf_base const &msg, unsigned long object)
+	: rpc_name(rpc_name), msg(msg), object(object)
 	{
 		Thread::trace(this);
 	}
@@ -62,11 +78,14 @@ struct Genode::Trace::Rpc_returned
 
 struct Genode::Trace::Rpc_dispatch
 {
+	enum { TYPE = Event_header::RPC_DISPATCH };
+
 	char const *rpc_name;
+	unsigned long const object;
 
-	Rpc_dispatch(char const *rpc_name)
+	Rpc_dispatch(char const *rpc_name, unsigned long object)
 	:
-		rpc_name(rpc_name)
+		rpc_name(rpc_name), object(object)
 	{
 		Thread::trace(this);
 	}
@@ -78,11 +97,14 @@ struct Genode::Trace::Rpc_dispatch
 
 struct Genode::Trace::Rpc_reply
 {
+	enum { TYPE = Event_header::RPC_REPLY };
+
 	char const *rpc_name;
+	unsigned long const object;
 
-	Rpc_reply(char const *rpc_name)
+	Rpc_reply(char const *rpc_name, unsigned long object)
 	:
-		rpc_name(rpc_name)
+		rpc_name(rpc_name), object(object)
 	{
 		Thread::trace(this);
 	}
@@ -94,9 +116,13 @@ struct Genode::Trace::Rpc_reply
 
 struct Genode::Trace::Signal_submit
 {
+	enum { TYPE = Event_header::SIGNAL_SUBMIT };
+
 	unsigned const num;
+	unsigned long const object;
 
-	Signal_submit(unsigned const num) : num(num)
+	Signal_submit(unsigned const num, unsigned long object)
+	: num(num), object(object)
 	{ Thread::trace(this); }
 
 	size_t generate(Policy_module &policy, char *dst) const {
@@ -106,12 +132,26 @@ struct Genode::Trace::Signal_submit
 
 struct Genode::Trace::Signal_received
 {
+	enum { TYPE = Event_header::SIGNAL_RECEIVED };
+
 	Signal_context const &signal_context;
 	unsigned const num;
-
-	Signal_received(Signal_context const &signal_context, unsigned num)
+	unsigned long const object;
+
+	/**
+	 * Constructor
+	 *
+	 * \param object  local name of the capability of the signal context
+	 *
+	 * The object matches the one recorded by the 'Signal_submit' event of
+	 * the sender on kernels that name capabilities system-wide (e.g.,
+	 * Linux and Fiasco.OC). On NOVA and base-hw, the names are local to
+	 * the component and cannot be used to pair the events.
+	 */
+	Signal_received(Signal_context const &signal_context, unsigned num,
+	                unsigned long object)
 	:
-		signal_context(signal_context), num(num)
+		signal_context(signal_context), num(num), object(object)
 	{
 		Thread::trace(this);
 	}
@@ -121,4 +161,59 @@ struct Genode::Trace::Signal_received
 };
 
 
+struct Genode::Trace::Lock_contention
+{
+	enum { TYPE = Event_header::LOCK_CONTENTION };
+
+	void const *lock;
+	unsigned const spins;
+	bool const blocked;
+	unsigned long const object;
+
+	Lock_contention(void const *lock, unsigned spins, bool blocked)
+	:
+		lock(lock), spins(spins), blocked(blocked), object((unsigned long)lock)
+	{
+		Thread::trace_if_ready(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.lock_contention(dst, lock, spins, blocked); }
+};
+
+
+/**
+ * Milestone reached by a component, e.g., during its startup
+ *
+ * A checkpoint is identified by its name, optionally refined by a 'detail'
+ * string such as a service name. The 'object' allows a trace consumer to
+ * relate the checkpoints of different threads, e.g., the checkpoints taken
+ * by a parent on behalf of the same child.
+ *
+ * If 'when' is non-zero, it denotes the timestamp at which the checkpoint
+ * was actually reached, which allows for recording checkpoints taken
+ * before tracing could be set up.
+ */
+struct Genode::Trace::Checkpoint
+{
+	enum { TYPE = Event_header::CHECKPOINT };
+
+	char const * const name;
+	char const * const detail;
+	uint64_t const when;
+	unsigned long const object;
+
+	Checkpoint(char const *name, char const *detail = "",
+	           void const *object = nullptr, uint64_t when = 0)
+	:
+		name(name), detail(detail), when(when), object((unsigned long)object)
+	{
+		Thread::trace(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.checkpoint(dst, name, detail, object); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
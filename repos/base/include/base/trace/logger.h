@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__TRACE__LOGGER_H_
 
 #include <base/trace/buffer.h>
+#include <base/trace/event_header.h>
 #include <cpu_session/cpu_session.h>
 
 namespace Genode { namespace Trace {
@@ -22,6 +23,7 @@ namespace Genode { namespace Trace {
 	class Control;
 	class Policy_module;
 	class Logger;
+	struct Checkpoint;
 } }
 
 
@@ -42,9 +44,59 @@ struct Genode::Trace::Logger
 		size_t             max_event_size;
 
 		bool               pending_init;
+		unsigned           thread_id;
+		unsigned           cpu_id;
 
 		bool _evaluate_control();
 
+		bool _ready() const;
+
+		/**
+		 * Return timestamp as provided by the policy
+		 */
+		uint64_t _timestamp() const;
+
+		/**
+		 * Return timestamp to be recorded for an event
+		 *
+		 * Events are recorded with the current time, except for checkpoints
+		 * that carry the time when they were reached.
+		 */
+		uint64_t _timestamp(void const *) const { return _timestamp(); }
+		uint64_t _timestamp(Checkpoint const *) const;
+
+		/**
+		 * Write event to trace buffer, preceded by the event header
+		 */
+		template <typename EVENT>
+		void _log(EVENT const *event)
+		{
+			Event_header header;
+			header.timestamp = _timestamp(event);
+
+			char * const dst = buffer->reserve(sizeof(header) + max_event_size);
+
+			/* the buffer is full and the consumer asked for dropping events */
+			if (!dst)
+				return;
+
+			size_t const len = event->generate(*policy_module, dst + sizeof(header));
+
+			/* omit events for which the policy produced no payload */
+			if (!len)
+				return;
+
+			header.object  = event->object;
+			header.thread  = thread_id;
+			header.subject = 0;
+			header.type    = EVENT::TYPE;
+			header.cpu     = cpu_id;
+			header.length  = len;
+			header.write(dst);
+
+			buffer->commit(sizeof(header) + len);
+		}
+
 	public:
 
 		Logger();
@@ -55,7 +107,13 @@ struct Genode::Trace::Logger
 
 		void init_pending(bool val) { pending_init = val; }
 
-		void init(Thread_capability, Cpu_session*, Control*);
+		/**
+		 * Initialize logger of a thread
+		 *
+		 * \param cpu_affinity  CPU of the thread as recorded in the event
+		 *                      headers
+		 */
+		void init(Thread_capability, Cpu_session*, Control*, unsigned cpu_affinity);
 
 		/**
 		 * Log binary data to trace buffer
@@ -70,7 +128,22 @@ struct Genode::Trace::Logger
 		{
 			if (!this || !_evaluate_control()) return;
 
-			buffer->commit(event->generate(*policy_module, buffer->reserve(max_event_size)));
+			_log(event);
+		}
+
+		/**
+		 * Log event to trace buffer if tracing is readily set up
+		 *
+		 * In contrast to 'log', this method never enables tracing or
+		 * loads a new policy, which involves RPCs and memory allocations.
+		 * Events that occur while such an update is pending are dropped.
+		 */
+		template <typename EVENT>
+		void log_if_ready(EVENT const *event)
+		{
+			if (!this || !_ready()) return;
+
+			_log(event);
 		}
 };
 
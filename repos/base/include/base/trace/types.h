@@ -18,6 +18,7 @@
 #include <util/string.h>
 #include <base/affinity.h>
 #include <base/session_label.h>
+#include <base/exception.h>
 
 namespace Genode { namespace Trace {
 
@@ -39,6 +40,8 @@ namespace Genode { namespace Trace {
 	struct Policy_id;
 	struct Subject_id;
 	struct Execution_time;
+	struct Buffer_stats;
+	struct Scheduling_stats;
 	struct Subject_info;
 } }
 
@@ -85,6 +88,48 @@ struct Genode::Trace::Execution_time
 };
 
 
+/**
+ * Event statistics of the trace buffer of a trace subject
+ */
+struct Genode::Trace::Buffer_stats
+{
+	unsigned long produced; /* events generated by the traced thread      */
+	unsigned long lost;     /* events dropped or missed by the TRACE client */
+
+	Buffer_stats() : produced(0), lost(0) { }
+	Buffer_stats(unsigned long produced, unsigned long lost)
+	: produced(produced), lost(lost) { }
+};
+
+
+/**
+ * Scheduling statistics of trace subject
+ *
+ * The values are kernel specific and remain zero on kernels that do not
+ * account them.
+ */
+struct Genode::Trace::Scheduling_stats
+{
+	unsigned long long wait_time;            /* time ready but not running */
+	unsigned long      voluntary_switches;   /* blocking of the thread     */
+	unsigned long      involuntary_switches; /* preemption of the thread   */
+	unsigned           last_cpu;             /* CPU the thread ran on last */
+
+	Scheduling_stats()
+	: wait_time(0), voluntary_switches(0), involuntary_switches(0),
+	  last_cpu(0) { }
+
+	Scheduling_stats(unsigned long long wait_time,
+	                 unsigned long voluntary_switches,
+	                 unsigned long involuntary_switches,
+	                 unsigned last_cpu)
+	:
+		wait_time(wait_time), voluntary_switches(voluntary_switches),
+		involuntary_switches(involuntary_switches), last_cpu(last_cpu)
+	{ }
+};
+
+
 /**
  * Subject information
  */
@@ -115,6 +160,8 @@ class Genode::Trace::Subject_info
 		Policy_id          _policy_id;
 		Execution_time     _execution_time;
 		Affinity::Location _affinity;
+		Buffer_stats       _buffer_stats;
+		Scheduling_stats   _scheduling_stats;
 
 	public:
 
@@ -124,11 +171,14 @@ class Genode::Trace::Subject_info
 		             Thread_name   const &thread_name,
 		             State state, Policy_id policy_id,
 		             Execution_time execution_time,
-		             Affinity::Location affinity)
+		             Affinity::Location affinity,
+		             Buffer_stats buffer_stats = Buffer_stats(),
+		             Scheduling_stats scheduling_stats = Scheduling_stats())
 		:
 			_session_label(session_label), _thread_name(thread_name),
 			_state(state), _policy_id(policy_id),
-			_execution_time(execution_time), _affinity(affinity)
+			_execution_time(execution_time), _affinity(affinity),
+			_buffer_stats(buffer_stats), _scheduling_stats(scheduling_stats)
 		{ }
 
 		Session_label const &session_label()  const { return _session_label; }
@@ -137,6 +187,8 @@ class Genode::Trace::Subject_info
 		Policy_id            policy_id()      const { return _policy_id; }
 		Execution_time       execution_time() const { return _execution_time; }
 		Affinity::Location   affinity()       const { return _affinity; }
+		Buffer_stats         buffer_stats()   const { return _buffer_stats; }
+		Scheduling_stats scheduling_stats()   const { return _scheduling_stats; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__TYPES_H_ */
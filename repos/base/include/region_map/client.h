@@ -44,9 +44,13 @@ class Genode::Region_map_client : public Rpc_client<Region_map>
 		Local_addr attach(Dataspace_capability ds, size_t size = 0,
 		                  off_t offset = 0, bool use_local_addr = false,
 		                  Local_addr local_addr = (void *)0,
-		                  bool executable = false) override;
+		                  bool executable = false,
+		                  bool copy_on_write = false,
+		                  bool populate = false) override;
 
+		void                 attach_batch(Attach_batch &)             override;
 		void                 detach(Local_addr)                       override;
+		void                 detach_batch(Detach_batch const &)       override;
 		void                 fault_handler(Signal_context_capability) override;
 		State                state()                                  override;
 		Dataspace_capability dataspace()                              override;
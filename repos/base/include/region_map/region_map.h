@@ -97,6 +97,163 @@ struct Genode::Region_map
 	class Unbound_thread    : public Exception { };
 
 
+	/**
+	 * Batch of attach operations
+	 *
+	 * A batch collects the arguments of several 'attach' operations, which
+	 * are performed by one call of 'attach_batch'. Instead of throwing an
+	 * exception, a failed operation is reported by the 'result' of its
+	 * entry. The remaining operations of the batch are performed anyway.
+	 */
+	struct Attach_batch
+	{
+		enum { MAX_ENTRIES = 16 };
+
+		enum Result { PENDING, OK, INVALID_DATASPACE, REGION_CONFLICT,
+		              OUT_OF_METADATA, INVALID_ARGS };
+
+		struct Entry
+		{
+			/* arguments, see 'attach' */
+			Dataspace_capability ds;
+			size_t               size           = 0;
+			off_t                offset         = 0;
+			bool                 use_local_addr = false;
+			Local_addr           local_addr     = (void *)0;
+			bool                 executable     = false;
+			bool                 copy_on_write  = false;
+			bool                 populate       = false;
+
+			Result     result = PENDING;
+			Local_addr addr;  /* local address of mapped dataspace */
+
+			/**
+			 * Throw the exception that corresponds to the result
+			 */
+			void throw_on_error() const
+			{
+				switch (result) {
+				case PENDING:
+				case OK:                break;
+				case INVALID_DATASPACE: throw Invalid_dataspace();
+				case REGION_CONFLICT:   throw Region_conflict();
+				case OUT_OF_METADATA:   throw Out_of_metadata();
+				case INVALID_ARGS:      throw Invalid_args();
+				}
+			}
+		};
+
+		class Full : public Exception { };
+
+		Entry    entries[MAX_ENTRIES];
+		unsigned count = 0;
+
+		bool full() const { return count == MAX_ENTRIES; }
+
+		/**
+		 * Append attach operation to batch
+		 *
+		 * \throw Full
+		 *
+		 * \return entry that holds the result of the operation
+		 */
+		Entry &add(Dataspace_capability ds,
+		           size_t size = 0, off_t offset = 0,
+		           bool use_local_addr = false,
+		           Local_addr local_addr = (void *)0,
+		           bool executable = false,
+		           bool copy_on_write = false,
+		           bool populate = false)
+		{
+			if (full())
+				throw Full();
+
+			Entry &e = entries[count++];
+			e.ds             = ds;
+			e.size           = size;
+			e.offset         = offset;
+			e.use_local_addr = use_local_addr;
+			e.local_addr     = local_addr;
+			e.executable     = executable;
+			e.copy_on_write  = copy_on_write;
+			e.populate       = populate;
+			e.result         = PENDING;
+			return e;
+		}
+	};
+
+	/**
+	 * Batch of detach operations
+	 */
+	struct Detach_batch
+	{
+		enum { MAX_ENTRIES = 16 };
+
+		class Full : public Exception { };
+
+		Local_addr local_addr[MAX_ENTRIES];
+		unsigned   count = 0;
+
+		bool full() const { return count == MAX_ENTRIES; }
+
+		/**
+		 * Append detach operation to batch
+		 *
+		 * \throw Full
+		 */
+		void add(Local_addr addr)
+		{
+			if (full())
+				throw Full();
+
+			local_addr[count++] = addr;
+		}
+	};
+
+	/**
+	 * Portion of an attach batch transferred by one RPC
+	 *
+	 * The dataspace capabilities cannot be part of the plain message
+	 * payload but are transferred as distinct RPC arguments. Hence, a chunk
+	 * refers to at most 'MAX_DATASPACES' different dataspaces by their
+	 * argument index. This limit corresponds to the maximum number of
+	 * capabilities per IPC message.
+	 */
+	struct Attach_chunk
+	{
+		enum { MAX_DATASPACES = 4, MAX_ENTRIES = Attach_batch::MAX_ENTRIES };
+
+		struct Entry
+		{
+			size_t              size;
+			off_t               offset;
+			addr_t              addr;  /* requested and resulting address */
+			unsigned char       ds;    /* index of dataspace argument */
+			bool                use_local_addr;
+			bool                executable;
+			bool                copy_on_write;
+			bool                populate;
+			Attach_batch::Result result;
+		};
+
+		Entry    entries[MAX_ENTRIES];
+		unsigned count = 0;
+	};
+
+	/**
+	 * Boolean attributes of an attachment
+	 *
+	 * The attributes are transferred as one RPC argument because the
+	 * number of RPC arguments is limited.
+	 */
+	struct Attach_attr
+	{
+		bool executable;
+		bool copy_on_write;
+		bool populate;
+	};
+
+
 	/**
 	 * Map dataspace into local address space
 	 *
@@ -108,19 +265,48 @@ struct Genode::Region_map
 	 *                         the specified 'local_addr'
 	 * \param local_addr       local destination address
 	 * \param executable       if the mapping should be executable
+	 * \param copy_on_write    if the mapping should be writeable while
+	 *                         the dataspace stays unmodified
+	 * \param populate         if the mapping should be established up
+	 *                         front instead of on first access
 	 *
 	 * \throw Attach_failed    if dataspace or offset is invalid,
 	 *                         or on region conflict
+	 * \throw Invalid_args     if 'copy_on_write' is not supported
+	 *                         by the region map
 	 * \throw Out_of_metadata  if meta-data backing store is exhausted
 	 *
 	 * \return                 local address of mapped dataspace
 	 *
+	 * A copy-on-write mapping starts with the content of the dataspace.
+	 * Each page is duplicated privately at the first write access to it.
+	 * Hence, pages that are only read do not consume memory. On Linux,
+	 * the pages are duplicated by the kernel. On the other kernels, core
+	 * does not allocate memory on behalf of its clients. There, a
+	 * copy-on-write region is mapped read-only and a write access is
+	 * reflected as 'WRITE_FAULT' to the fault handler of the region map,
+	 * which is expected to resolve the fault by attaching a private copy.
+	 * Therefore, core accepts copy-on-write mappings only at region maps
+	 * with a registered fault handler.
+	 *
+	 * A populated mapping spares the accessing threads the page faults
+	 * at the first access of each page, which is desired for
+	 * latency-critical components. On Linux, the kernel prefaults the
+	 * pages while attaching. On base-hw, seL4, and Fiasco.OC, core
+	 * installs the mappings of the region right away. NOVA, Fiasco,
+	 * Pistachio, and OKL4 accept mappings only as reply to a page fault.
+	 * There, core merely makes the backing store of the dataspace present
+	 * and the first access of each page still faults. The same holds for
+	 * regions of nested region maps and for region maps that are not yet
+	 * used by any thread at the time of the attachment.
 	 */
 	virtual Local_addr attach(Dataspace_capability ds,
 	                          size_t size = 0, off_t offset = 0,
 	                          bool use_local_addr = false,
 	                          Local_addr local_addr = (void *)0,
-	                          bool executable = false) = 0;
+	                          bool executable = false,
+	                          bool copy_on_write = false,
+	                          bool populate = false) = 0;
 
 	/**
 	 * Shortcut for attaching a dataspace at a predefined local address
@@ -136,11 +322,40 @@ struct Genode::Region_map
 	                             size_t size = 0, off_t offset = 0) {
 		return attach(ds, size, offset, true, local_addr, true); }
 
+	/**
+	 * Shortcut for attaching a dataspace copy-on-write at a predefined local address
+	 */
+	Local_addr attach_copy_on_write(Dataspace_capability ds, addr_t local_addr,
+	                                size_t size = 0, off_t offset = 0) {
+		return attach(ds, size, offset, true, local_addr, false, true); }
+
+	/**
+	 * Shortcut for attaching a dataspace with its mapping populated up front
+	 */
+	Local_addr attach_populated(Dataspace_capability ds,
+	                            size_t size = 0, off_t offset = 0) {
+		return attach(ds, size, offset, false, (void *)0, false, false, true); }
+
+	/**
+	 * Perform all attach operations of a batch
+	 *
+	 * In contrast to a sequence of 'attach' calls, a batch is transferred
+	 * to a remote region map via a single RPC per 'Attach_chunk', which
+	 * typically covers the whole batch. The default implementation
+	 * performs the operations one after another.
+	 */
+	virtual void attach_batch(Attach_batch &batch);
+
 	/**
 	 * Remove region from local address space
 	 */
 	virtual void detach(Local_addr local_addr) = 0;
 
+	/**
+	 * Remove all regions of a batch from local address space
+	 */
+	virtual void detach_batch(Detach_batch const &batch);
+
 	/**
 	 * Register signal handler for region-manager faults
 	 *
@@ -161,21 +376,68 @@ struct Genode::Region_map
 	 */
 	virtual Dataspace_capability dataspace() = 0;
 
+	/**
+	 * Server-side counterpart of the transfer of an 'Attach_chunk'
+	 *
+	 * The function translates the chunk into an 'Attach_batch' to be
+	 * processed by 'attach_batch'.
+	 */
+	void attach_chunk(Dataspace_capability, Dataspace_capability,
+	                  Dataspace_capability, Dataspace_capability,
+	                  Attach_chunk &);
+
+	/**
+	 * Interface for transferring an 'Attach_chunk' to a remote region map
+	 */
+	struct Attach_chunk_transfer
+	{
+		virtual void transfer(Dataspace_capability, Dataspace_capability,
+		                      Dataspace_capability, Dataspace_capability,
+		                      Attach_chunk &) = 0;
+	};
+
+	/**
+	 * Client-side counterpart of 'attach_chunk'
+	 *
+	 * The function packs the batch into chunks, each referring to at most
+	 * 'Attach_chunk::MAX_DATASPACES' dataspaces, hands each chunk to
+	 * 'transfer', and propagates the results back to the batch.
+	 */
+	static void attach_batch_chunked(Attach_batch &batch,
+	                                 Attach_chunk_transfer &transfer);
+
+	/**
+	 * Server-side counterpart of the 'attach' RPC
+	 */
+	Local_addr attach_with_attr(Dataspace_capability ds, size_t size,
+	                            off_t offset, bool use_local_addr,
+	                            Local_addr local_addr, Attach_attr attr)
+	{
+		return attach(ds, size, offset, use_local_addr, local_addr,
+		              attr.executable, attr.copy_on_write, attr.populate);
+	}
+
 
 	/*********************
 	 ** RPC declaration **
 	 *********************/
 
-	GENODE_RPC_THROW(Rpc_attach, Local_addr, attach,
+	GENODE_RPC_THROW(Rpc_attach, Local_addr, attach_with_attr,
 	                 GENODE_TYPE_LIST(Invalid_dataspace, Region_conflict,
 	                                  Out_of_metadata, Invalid_args),
-	                 Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
+	                 Dataspace_capability, size_t, off_t, bool, Local_addr,
+	                 Attach_attr);
+	GENODE_RPC(Rpc_attach_chunk, void, attach_chunk,
+	           Dataspace_capability, Dataspace_capability,
+	           Dataspace_capability, Dataspace_capability, Attach_chunk &);
 	GENODE_RPC(Rpc_detach, void, detach, Local_addr);
+	GENODE_RPC(Rpc_detach_batch, void, detach_batch, Detach_batch const &);
 	GENODE_RPC(Rpc_fault_handler, void, fault_handler, Signal_context_capability);
 	GENODE_RPC(Rpc_state, State, state);
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 
-	GENODE_RPC_INTERFACE(Rpc_attach, Rpc_detach, Rpc_fault_handler, Rpc_state,
+	GENODE_RPC_INTERFACE(Rpc_attach, Rpc_attach_chunk, Rpc_detach,
+	                     Rpc_detach_batch, Rpc_fault_handler, Rpc_state,
 	                     Rpc_dataspace);
 };
 
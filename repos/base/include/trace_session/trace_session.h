@@ -58,6 +58,14 @@ struct Genode::Trace::Session : Genode::Session
 
 	/**
 	 * Install a matching rule for automatically tracing new threads
+	 *
+	 * A thread created after installing the rule is traced right from its
+	 * start if the label of its CPU session equals 'label' or denotes a
+	 * child of the component with the given label. An empty 'thread' name
+	 * matches any thread. The subjects of such threads are reported by
+	 * 'subjects' in the 'TRACED' state.
+	 *
+	 * \throw Out_of_metadata
 	 */
 	virtual void rule(Session_label const &, Thread_name const &,
 	                  Policy_id, size_t buffer_size) = 0;
@@ -0,0 +1,302 @@
+/*
+ * \brief  Index for navigating XML documents
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <base/allocator.h>
+
+
+/**
+ * Table of the nodes of an XML document
+ *
+ * An 'Xml_node' scans the text of a node for its end tag and its sub nodes
+ * whenever it is constructed. Navigating a large document via 'sub_node'
+ * and 'next' thereby repeatedly scans the same text. The index parses the
+ * document once and records the position, the end tag, the first sub node,
+ * and the successor of each node. The nodes returned by 'xml' and all nodes
+ * reached from there use this information instead of scanning the text.
+ *
+ * The index refers to the document text, which must stay unmodified while
+ * the index is in use. Different from the plain 'Xml_node', the index
+ * requires the start and end tags of all nodes of the document to match.
+ *
+ * The nodes obtained from the index point to the tables of the index and
+ * to the document text. They must not be used after the index is
+ * destroyed or after the buffer of the document is freed or modified.
+ * This includes copies of the nodes and the pointers returned by their
+ * 'addr' and 'content_addr' methods.
+ */
+class Genode::Xml_index
+{
+	public:
+
+		typedef Xml_node::Invalid_syntax Invalid_syntax;
+
+	private:
+
+		typedef Xml_node::Index_entry Entry;
+		typedef Xml_node::Token       Token;
+		typedef Xml_node::Tag         Tag;
+		typedef Xml_node::Comment     Comment;
+
+		/**
+		 * Node with its start tag parsed but its end tag not yet found
+		 */
+		struct Open_node
+		{
+			unsigned pos;            /* index entry                */
+			unsigned content;        /* offset of node content     */
+			unsigned last_sub_node;  /* last sub node found so far */
+			Token    name;
+		};
+
+		Allocator  &_alloc;
+		char const *_doc;
+		size_t      _doc_len;
+
+		Entry   *_entries     = nullptr;
+		unsigned _num_entries = 0;
+		unsigned _capacity    = 0;
+
+		/* sub nodes of all nodes, grouped by their parent */
+		uint32_t *_sub_nodes = nullptr;
+
+		Xml_node::Index _tables { nullptr, nullptr };
+
+		/**
+		 * Enlarge array to hold at least 'num' + 1 elements
+		 */
+		template <typename T>
+		void _grow(T *&array, unsigned num, unsigned &capacity)
+		{
+			if (num < capacity)
+				return;
+
+			unsigned const new_capacity = capacity ? 2*capacity : 32;
+
+			T *new_array = (T *)_alloc.alloc(new_capacity*sizeof(T));
+			if (array) {
+				memcpy(new_array, array, num*sizeof(T));
+				_alloc.free(array, capacity*sizeof(T));
+			}
+
+			array    = new_array;
+			capacity = new_capacity;
+		}
+
+		unsigned _offset(Token t) const { return t.start() - _doc; }
+
+		/**
+		 * Add entry for a node
+		 *
+		 * \param offset  start of the node as returned by 'Xml_node::addr'
+		 */
+		unsigned _add_entry(unsigned offset)
+		{
+			_grow(_entries, _num_entries, _capacity);
+
+			_entries[_num_entries] = Entry { offset, offset, 0, 0, 0, 0 };
+
+			return _num_entries++;
+		}
+
+		/**
+		 * Record all nodes of the document in one pass
+		 *
+		 * Nodes at the top level of the document are recorded as a
+		 * sequence of successors. The sequence ends at the first node
+		 * that is not well formed, matching the behaviour of
+		 * 'Xml_node::next'.
+		 *
+		 * \throw Invalid_syntax  the first node of the document is not
+		 *                        well formed
+		 */
+		void _parse()
+		{
+			Open_node *stack     = nullptr;
+			unsigned   depth     = 0;
+			unsigned   stack_cap = 0;
+
+			unsigned prev_top = 0;     /* previous complete top-level node */
+			unsigned curr_top = 0;     /* top-level node currently parsed  */
+
+			Token t = Xml_node::skip_non_tag_characters(Token(_doc, _doc_len));
+
+			while (t.type() != Token::END) {
+
+				Comment comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag tag;
+				try { tag = Tag(t); }
+				catch (Invalid_syntax) { break; }
+
+				/* skip text */
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				t = tag.next_token();
+
+				if (tag.type() == Tag::END) {
+
+					if (!depth) break;
+
+					Open_node const &node = stack[depth - 1];
+
+					if (node.name.len() != tag.name().len()
+					 || strcmp(node.name.start(), tag.name().start(),
+					           node.name.len()))
+						break;
+
+					_entries[node.pos].end_tag = _offset(tag.token());
+					depth--;
+
+				} else {
+
+					/*
+					 * Like 'Xml_node::sub_node', let the first sub node
+					 * start right after the start tag of its parent, and
+					 * the document start at its first character.
+					 */
+					Open_node * const parent = depth ? &stack[depth - 1] : nullptr;
+
+					unsigned offset = _offset(tag.token());
+					if (parent && !_entries[parent->pos].num_sub_nodes)
+						offset = parent->content;
+					if (!_num_entries)
+						offset = 0;
+
+					unsigned const pos = _add_entry(offset);
+
+					if (parent) {
+						Entry &entry = _entries[parent->pos];
+
+						if (entry.num_sub_nodes++)
+							_entries[parent->last_sub_node].next = pos;
+						else
+							entry.first_sub_node = pos;
+
+						parent->last_sub_node = pos;
+					} else {
+						curr_top = pos;
+					}
+
+					if (tag.type() == Tag::START) {
+						_grow(stack, depth, stack_cap);
+						stack[depth++] = Open_node { pos, _offset(t), 0, tag.name() };
+					}
+				}
+
+				/* link completed top-level node to its predecessor */
+				if (!depth) {
+					if (curr_top)
+						_entries[prev_top].next = curr_top;
+					prev_top = curr_top;
+				}
+			}
+
+			if (stack)
+				_alloc.free(stack, stack_cap*sizeof(Open_node));
+
+			/* drop malformed top-level node */
+			if (depth)
+				_num_entries = curr_top;
+
+			if (!_num_entries)
+				throw Invalid_syntax();
+		}
+
+		/**
+		 * Store the references to the sub nodes of each node consecutively
+		 */
+		void _index_sub_nodes()
+		{
+			_sub_nodes = (uint32_t *)_alloc.alloc(_num_entries*sizeof(uint32_t));
+
+			unsigned n = 0;
+			for (unsigned i = 0; i < _num_entries; i++) {
+
+				_entries[i].sub_nodes = n;
+
+				for (unsigned pos = _entries[i].first_sub_node; pos;
+				     pos = _entries[pos].next)
+					_sub_nodes[n++] = pos;
+			}
+
+			_tables = Xml_node::Index { _entries, _sub_nodes };
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc    allocator used for the index
+		 * \param doc      start of the XML document
+		 * \param doc_len  length of the document
+		 *
+		 * \throw Invalid_syntax
+		 */
+		Xml_index(Allocator &alloc, char const *doc, size_t doc_len)
+		:
+			_alloc(alloc), _doc(doc), _doc_len(doc_len)
+		{
+			try { _parse(); _index_sub_nodes(); }
+			catch (...) { _free_entries(); throw; }
+		}
+
+		/**
+		 * Constructor for indexing the given XML node
+		 *
+		 * The index covers solely the node, not the nodes following it.
+		 */
+		Xml_index(Allocator &alloc, Xml_node node)
+		:
+			Xml_index(alloc, node.addr(), node.size())
+		{ }
+
+		~Xml_index() { _free_entries(); }
+
+		/**
+		 * Return first node of the indexed document
+		 */
+		Xml_node xml() const { return Xml_node(_doc, _doc_len, &_tables, 0); }
+
+		/**
+		 * Return number of nodes of the document
+		 */
+		unsigned num_nodes() const { return _num_entries; }
+
+	private:
+
+		void _free_entries()
+		{
+			if (_entries)
+				_alloc.free(_entries, _capacity*sizeof(Entry));
+
+			if (_sub_nodes)
+				_alloc.free(_sub_nodes, _num_entries*sizeof(uint32_t));
+
+			_entries   = nullptr;
+			_sub_nodes = nullptr;
+		}
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
@@ -20,6 +20,7 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 }
 
 
@@ -213,8 +214,42 @@ class Genode::Xml_node
 		 */
 		typedef Xml_attribute Attribute;
 
+		/**
+		 * Description of one node within an 'Xml_index'
+		 *
+		 * Offsets are relative to the start of the indexed document, node
+		 * references are indices into the entry array of the index. The
+		 * first node of the document is never the sub node or successor
+		 * of another node. Hence, the reference 0 denotes that no such
+		 * node exists.
+		 */
+		struct Index_entry
+		{
+			uint32_t offset;          /* start of node as returned by 'addr'  */
+			uint32_t end_tag;         /* end tag, unused for empty elements   */
+			uint32_t first_sub_node;
+			uint32_t next;
+			uint32_t num_sub_nodes;
+			uint32_t sub_nodes;       /* first sub node in 'Index::sub_nodes' */
+		};
+
+		/**
+		 * Tables of an 'Xml_index'
+		 *
+		 * The references to the sub nodes of each node are stored
+		 * consecutively in the 'sub_nodes' array, which allows for looking
+		 * up a sub node by its index without following the successors.
+		 */
+		struct Index
+		{
+			Index_entry const *entries;
+			uint32_t    const *sub_nodes;
+		};
+
 	private:
 
+		friend class Xml_index;
+
 		class Tag
 		{
 			public:
@@ -449,6 +484,13 @@ class Genode::Xml_node
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		/*
+		 * Nodes obtained from an 'Xml_index' refer to their index entry,
+		 * which spares the scanning for end tags and sub nodes.
+		 */
+		Index const *_index     = nullptr;
+		unsigned     _index_pos = 0;
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -565,6 +607,38 @@ class Genode::Xml_node
 			return Xml_node(at, _max_len - (at - addr()));
 		}
 
+		/**
+		 * Constructor used for nodes described by an 'Xml_index'
+		 *
+		 * \param doc      start of the indexed document
+		 * \param doc_len  length of the indexed document
+		 * \param index    tables of the index
+		 * \param pos      index entry of the node
+		 */
+		Xml_node(char const *doc, size_t doc_len,
+		         Index const *index, unsigned pos)
+		:
+			_addr(doc + index->entries[pos].offset),
+			_max_len(doc_len - index->entries[pos].offset),
+			_num_sub_nodes(index->entries[pos].num_sub_nodes),
+			_start_tag(skip_non_tag_characters(Token(_addr, _max_len))),
+			_end_tag(_start_tag.type() == Tag::START
+			         ? Tag(Token(doc + index->entries[pos].end_tag,
+			                     doc_len - index->entries[pos].end_tag))
+			         : _start_tag),
+			_index(index), _index_pos(pos)
+		{ }
+
+		/**
+		 * Return node of the same index
+		 */
+		Xml_node _indexed_node(unsigned pos) const
+		{
+			size_t const offset = _index->entries[_index_pos].offset;
+
+			return Xml_node(_addr - offset, _max_len + offset, _index, pos);
+		}
+
 	public:
 
 		/**
@@ -720,6 +794,14 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			if (_index) {
+				unsigned const next = _index->entries[_index_pos].next;
+				if (!next)
+					throw Nonexistent_sub_node();
+
+				return _indexed_node(next);
+			}
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -765,6 +847,14 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_index) {
+				Index_entry const &entry = _index->entries[_index_pos];
+				if (idx >= entry.num_sub_nodes)
+					throw Nonexistent_sub_node();
+
+				return _indexed_node(_index->sub_nodes[entry.sub_nodes + idx]);
+			}
+
 			if (_num_sub_nodes > 0) {
 
 				/* look up node at specified index */
@@ -790,7 +880,7 @@ class Genode::Xml_node
 
 				/* search for sub node of specified type */
 				try {
-					Xml_node curr_node = _sub_node(content_addr());
+					Xml_node curr_node = sub_node();
 					for ( ; true; curr_node = curr_node.next())
 						if (curr_node.has_type(type))
 							return curr_node;
@@ -148,6 +148,15 @@ LD_OPT_GC_SECTIONS ?= -gc-sections
 LD_OPT_ALIGN_SANE   = -z max-page-size=0x1000
 LD_OPT_PREFIX      := -Wl,
 LD_OPT             += $(LD_MARCH) $(LD_OPT_GC_SECTIONS) $(LD_OPT_ALIGN_SANE)
+
+#
+# Equip dynamic objects with a GNU hash table, which speeds up the symbol
+# lookup of the dynamic linker, in addition to the ELF hash table expected
+# by debuggers.
+#
+LD_OPT_HASH_STYLE  ?= --hash-style=both
+LD_OPT             += $(LD_OPT_HASH_STYLE)
+
 CXX_LINK_OPT       += $(addprefix $(LD_OPT_PREFIX),$(LD_OPT))
 CXX_LINK_OPT       += $(LD_OPT_NOSTDLIB)
 
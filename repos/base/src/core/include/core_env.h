@@ -21,6 +21,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/heap.h>
+#include <base/rpc_entrypoint_pool.h>
 #include <ram_session/client.h>
 #include <pd_session/client.h>
 #include <rm_session/capability.h>
@@ -120,6 +121,18 @@ namespace Genode {
 
 			enum { ENTRYPOINT_STACK_SIZE = 2048 * sizeof(Genode::addr_t) };
 
+			/*
+			 * Objects that support concurrent dispatching, i.e., RAM and RM
+			 * sessions, are served by one worker thread per additional CPU.
+			 */
+			enum { MAX_ENTRYPOINT_WORKERS = 7 };
+
+			static unsigned _num_entrypoint_workers()
+			{
+				unsigned const cpus = platform()->affinity_space().total();
+				return cpus > 1 ? min(cpus - 1, (unsigned)MAX_ENTRYPOINT_WORKERS) : 0;
+			}
+
 			/*
 			 * Initialize the stack area before creating the first thread,
 			 * which happens to be the '_entrypoint'.
@@ -127,7 +140,7 @@ namespace Genode {
 			bool _init_stack_area() { init_stack_area(); return true; }
 			bool _stack_area_initialized = _init_stack_area();
 
-			Rpc_entrypoint               _entrypoint;
+			Rpc_entrypoint_pool          _entrypoint;
 			Core_region_map              _region_map;
 			Core_ram_session             _ram_session;
 			Ram_session_capability const _ram_session_cap;
@@ -151,7 +164,10 @@ namespace Genode {
 			 */
 			Core_env()
 			:
-				_entrypoint(nullptr, ENTRYPOINT_STACK_SIZE, "entrypoint"),
+				_entrypoint(nullptr, ENTRYPOINT_STACK_SIZE, "entrypoint",
+				            *platform()->core_mem_alloc(),
+				            platform()->affinity_space(),
+				            _num_entrypoint_workers()),
 				_region_map(_entrypoint),
 				_ram_session(&_entrypoint, &_entrypoint,
 				             platform()->ram_alloc(), platform()->core_mem_alloc(),
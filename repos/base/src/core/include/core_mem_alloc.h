@@ -28,13 +28,32 @@ namespace Genode {
 	class Mapped_mem_allocator;
 	class Mapped_avl_allocator;
 
-	using Page_allocator = Allocator_avl_tpl<Empty, get_page_size()>;
+	class Page_allocator;
 	using Phys_allocator = Synced_range_allocator<Page_allocator>;
 	using Synced_mapped_allocator =
 		Synced_range_allocator<Mapped_avl_allocator>;
 };
 
 
+/**
+ * Page-granular allocator used for core's physical-memory ranges
+ *
+ * Core's physical-memory allocators serve the backing store of all RAM
+ * dataspaces. Hence, we enable the constant-time lookup of free blocks
+ * by size class.
+ */
+class Genode::Page_allocator : public Allocator_avl_tpl<Empty, get_page_size()>
+{
+	public:
+
+		explicit Page_allocator(Allocator *md_alloc)
+		: Allocator_avl_tpl<Empty, get_page_size()>(md_alloc)
+		{
+			size_class_lookup(true);
+		}
+};
+
+
 /**
  * Interface of an allocator that allows to return physical addresses
  * of its used virtual address ranges, and vice versa.
@@ -81,7 +100,10 @@ class Genode::Mapped_avl_allocator
 		 * \param md_alloc  metadata allocator
 		 */
 		explicit Mapped_avl_allocator(Allocator *md_alloc)
-		: Allocator_avl_tpl<Metadata, get_page_size()>(md_alloc) {}
+		: Allocator_avl_tpl<Metadata, get_page_size()>(md_alloc)
+		{
+			size_class_lookup(true);
+		}
 
 		/**
 		 * Returns related address for allocated range
@@ -37,7 +37,9 @@ class Genode::Core_region_map : public Region_map
 		Local_addr attach(Dataspace_capability, size_t size = 0,
 		                  off_t offset=0, bool use_local_addr = false,
 		                  Local_addr local_addr = 0,
-		                  bool executable = false) override;
+		                  bool executable = false,
+		                  bool copy_on_write = false,
+		                  bool populate = false) override;
 
 		void detach(Local_addr);
 
@@ -177,7 +177,8 @@ class Genode::Cpu_thread_component : public Rpc_object<Cpu_thread>,
 		{
 			return { _session_label, _name,
 			         _platform_thread.execution_time(),
-			         _platform_thread.affinity() };
+			         _platform_thread.affinity(),
+			         _platform_thread.scheduling_stats() };
 		}
 
 
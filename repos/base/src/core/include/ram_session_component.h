@@ -58,6 +58,23 @@ namespace Genode {
 			addr_t                  _phys_start;
 			addr_t                  _phys_end;
 
+			/*
+			 * Backing store of large dataspaces as requested via the
+			 * 'huge_pages' session argument
+			 *
+			 * The policy is regarded only by platforms where core obtains
+			 * the backing store of RAM dataspaces from a host kernel, i.e.,
+			 * base-linux. On the other platforms, core maps dataspaces
+			 * with the largest page size permitted by their alignment
+			 * anyway.
+			 */
+			enum Huge_pages { HUGE_PAGES_NO, HUGE_PAGES_TRANSPARENT,
+			                  HUGE_PAGES_HUGETLB };
+
+			Huge_pages const _huge_pages;
+
+			static Huge_pages _huge_pages_from_args(char const *args);
+
 			enum { MAX_LABEL_LEN = 64 };
 			char _label[MAX_LABEL_LEN];
 
@@ -65,7 +82,9 @@ namespace Genode {
 			 * List of RAM sessions that use us as their reference account
 			 */
 			Ram_ref_account_members _ref_members;
-			Lock                    _ref_members_lock;  /* protect '_ref_members' */
+			Lock                    _ref_members_lock;  /* protect '_ref_members',
+			                                               '_payload', and
+			                                               '_quota_limit'   */
 
 			/**
 			 * Register RAM session to use us as reference account
@@ -173,6 +192,13 @@ namespace Genode {
 			int transfer_quota(Ram_session_capability, size_t);
 			size_t quota() { return _quota_limit; }
 			size_t used()  { return _payload; }
+
+			/*
+			 * RAM sessions are self-contained except for quota transfers,
+			 * which are synchronized via '_ref_members_lock'. Hence, they
+			 * can be served by any thread of a multi-threaded entrypoint.
+			 */
+			bool concurrent_dispatch() const override { return true; }
 	};
 }
 
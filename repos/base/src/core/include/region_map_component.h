@@ -203,6 +203,14 @@ class Genode::Rm_client : public Pager_object, public Rm_faulter,
 		 */
 		void unmap(addr_t core_local_base, addr_t virt_base, size_t size);
 
+		/**
+		 * Install memory mapping ahead of a page fault
+		 *
+		 * \return  false if the kernel accepts mappings only as reply
+		 *          to a page fault
+		 */
+		bool map(Mapping const &mapping);
+
 		bool has_same_address_space(Rm_client const &other)
 		{
 			return other._address_space == _address_space;
@@ -334,6 +342,13 @@ class Genode::Region_map_component : public Rpc_object<Region_map>,
 			return _session_ep->apply(cap, lambda);
 		}
 
+		/**
+		 * Establish the mappings of a region ahead of the first access
+		 *
+		 * Must be called with '_lock' held.
+		 */
+		void _populate(Rm_region const &region);
+
 	public:
 
 		/**
@@ -404,7 +419,7 @@ class Genode::Region_map_component : public Rpc_object<Region_map>,
 		 ** Region map interface **
 		 **************************/
 
-		Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool) override;
+		Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool, bool, bool) override;
 		void             detach        (Local_addr) override;
 		void             fault_handler (Signal_context_capability handler) override;
 		State            state         () override;
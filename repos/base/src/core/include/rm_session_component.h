@@ -68,6 +68,13 @@ class Genode::Rm_session_component : public Rpc_object<Rm_session>
 		 */
 		void upgrade_ram_quota(size_t ram_quota) { _md_alloc.upgrade(ram_quota); }
 
+		/*
+		 * The list of region maps is protected by '_region_maps_lock'.
+		 * The region maps themselves are managed at the session's
+		 * entrypoint and, thereby, remain served by its primary thread.
+		 */
+		bool concurrent_dispatch() const override { return true; }
+
 
 		/**************************
 		 ** Rm_session interface **
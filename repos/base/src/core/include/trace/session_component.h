@@ -31,10 +31,31 @@ class Genode::Trace::Session_component
 :
 	public Genode::Rpc_object<Genode::Trace::Session,
 	                          Genode::Trace::Session_component>,
-	public Genode::Trace::Policy_owner
+	public Genode::Trace::Policy_owner,
+	public Genode::Trace::Source_listener
 {
 	private:
 
+		/**
+		 * Rule for tracing threads right from their creation
+		 */
+		struct Rule : List<Rule>::Element
+		{
+			Session_label const label;
+			Thread_name   const thread;
+			Policy_id     const policy;
+			size_t        const buffer_size;
+
+			Rule(Session_label const &label, Thread_name const &thread,
+			     Policy_id policy, size_t buffer_size)
+			:
+				label(label), thread(thread), policy(policy),
+				buffer_size(buffer_size)
+			{ }
+
+			bool matches(Source::Info const &) const;
+		};
+
 		Ram_session         &_ram;
 		Allocator_guard      _md_alloc;
 		Tslab<Subject, 4096> _subjects_slab;
@@ -45,6 +66,8 @@ class Genode::Trace::Session_component
 		Policy_registry     &_policies;
 		Subject_registry     _subjects;
 		unsigned             _policy_cnt;
+		Lock                 _rules_lock;
+		List<Rule>           _rules;
 
 		struct Argument_buffer
 		{
@@ -103,6 +126,13 @@ class Genode::Trace::Session_component
 		Subject_info subject_info(Subject_id);
 		Dataspace_capability buffer(Subject_id);
 		void free(Subject_id);
+
+
+		/*************************************
+		 ** Trace::Source_listener interface **
+		 *************************************/
+
+		void new_source(Source &);
 };
 
 #endif /* _CORE__INCLUDE__TRACE__SESSION_COMPONENT_H_ */
@@ -16,7 +16,10 @@
 
 #include <util/list.h>
 #include <util/string.h>
+#include <base/env.h>
 #include <base/lock.h>
+#include <base/thread.h>
+#include <base/trace/buffer.h>
 #include <base/trace/types.h>
 #include <base/weak_ptr.h>
 
@@ -26,6 +29,7 @@
 namespace Genode { namespace Trace {
 	class Source;
 	class Source_owner;
+	class Source_listener;
 	class Source_registry;
 
 	/**
@@ -56,6 +60,7 @@ class Genode::Trace::Source
 			Thread_name        name;
 			Execution_time     execution_time;
 			Affinity::Location affinity;
+			Scheduling_stats   scheduling_stats;
 		};
 
 		/**
@@ -103,6 +108,37 @@ class Genode::Trace::Source
 			_control.trace();
 		}
 
+		/**
+		 * Forget the trace buffer of 'owner' before it gets freed
+		 */
+		void release_buffer(Source_owner const *owner)
+		{
+			if (owned_by(owner))
+				_buffer = Dataspace_capability();
+		}
+
+		/**
+		 * Return event statistics of the trace buffer
+		 *
+		 * The buffer is attached to core only for reading the counters.
+		 * Keeping the buffers of all traced threads attached would
+		 * exhaust core's virtual address space.
+		 */
+		Buffer_stats buffer_stats() const
+		{
+			if (!_buffer.valid())
+				return Buffer_stats();
+
+			Buffer const *buffer = 0;
+			try { buffer = env()->rm_session()->attach(_buffer); }
+			catch (...) { return Buffer_stats(); }
+
+			Buffer_stats const stats(buffer->produced(), buffer->lost());
+
+			env()->rm_session()->detach(buffer);
+			return stats;
+		}
+
 		void enable()  { _control.enable(); }
 		void disable() { _control.disable(); }
 
@@ -137,6 +173,18 @@ class Genode::Trace::Source
 };
 
 
+/**
+ * Interface for getting notified about the creation of sources
+ */
+struct Genode::Trace::Source_listener : Genode::List<Source_listener>::Element
+{
+	/**
+	 * Called by the CPU service before the thread of 'source' is started
+	 */
+	virtual void new_source(Source &source) = 0;
+};
+
+
 /**
  * Registry to tracing sources
  *
@@ -149,6 +197,9 @@ class Genode::Trace::Source_registry
 		Lock         _lock;
 		List<Source> _entries;
 
+		Lock                  _listeners_lock;
+		List<Source_listener> _listeners;
+
 	public:
 
 		/***********************************
@@ -157,9 +208,14 @@ class Genode::Trace::Source_registry
 
 		void insert(Source *entry)
 		{
-			Lock::Guard guard(_lock);
-
-			_entries.insert(entry);
+			{
+				Lock::Guard guard(_lock);
+				_entries.insert(entry);
+			}
+
+			Lock::Guard guard(_listeners_lock);
+			for (Source_listener *l = _listeners.first(); l; l = l->next())
+				l->new_source(*entry);
 		}
 
 		void remove(Source *entry)
@@ -173,6 +229,18 @@ class Genode::Trace::Source_registry
 		 ** Interface used by TRACE service **
 		 *************************************/
 
+		void add_listener(Source_listener &listener)
+		{
+			Lock::Guard guard(_listeners_lock);
+			_listeners.insert(&listener);
+		}
+
+		void remove_listener(Source_listener &listener)
+		{
+			Lock::Guard guard(_listeners_lock);
+			_listeners.remove(&listener);
+		}
+
 		template <typename TEST, typename INSERT>
 		void export_sources(TEST &test, INSERT &insert)
 		{
@@ -238,19 +238,24 @@ class Genode::Trace::Subject
 		{
 			Execution_time execution_time;
 			Affinity::Location affinity;
+			Buffer_stats buffer_stats;
+			Scheduling_stats scheduling_stats;
 
 			{
 				Locked_ptr<Source> source(_source);
 
 				if (source.valid()) {
 					Trace::Source::Info const info = source->info();
-					execution_time = info.execution_time;
-					affinity       = info.affinity;
+					execution_time   = info.execution_time;
+					affinity         = info.affinity;
+					scheduling_stats = info.scheduling_stats;
+					buffer_stats     = source->buffer_stats();
 				}
 			}
 
 			return Subject_info(_label, _name, _state(), _policy_id,
-			                    execution_time, affinity);
+			                    execution_time, affinity, buffer_stats,
+			                    scheduling_stats);
 		}
 
 		Dataspace_capability buffer() const { return _buffer.dataspace(); }
@@ -264,6 +269,8 @@ class Genode::Trace::Subject
 			if (!source.valid())
 				return 0;
 
+			source->release_buffer(this);
+
 			return _buffer.flush() + _policy.flush();
 		}
 };
@@ -396,6 +403,26 @@ class Genode::Trace::Subject_registry
 			_sources.export_sources(_tester, _inserter);
 		}
 
+		/**
+		 * Import a single source that was just created
+		 *
+		 * \throw  Allocator::Out_of_memory
+		 */
+		Subject_id import_source(Source &source)
+		{
+			Lock::Guard guard(_lock);
+
+			Source::Info const info = source.info();
+			Weak_ptr<Source>   ptr  = source.weak_ptr();
+
+			Subject *subject = new (&_md_alloc)
+				Subject(Subject_id(_id_cnt++), source.unique_id(), ptr,
+				        info.label, info.name);
+
+			_entries.insert(subject);
+			return subject->id();
+		}
+
 		/**
 		 * Retrieve existing subject IDs
 		 */
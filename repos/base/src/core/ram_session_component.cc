@@ -78,16 +78,27 @@ int Ram_session_component::_transfer_quota(Ram_session_component *dst, size_t am
 	if ((ref_account() != dst) && (dst->ref_account() != this))
 		return -2;
 
-	/* decrease quota limit of this session - check against used quota */
-	if (_quota_limit < amount + _payload) {
-		PWRN("Insufficient quota for transfer: %s", _label);
-		PWRN("  have %zu, need %zu", _quota_limit - _payload, amount);
-		return -3;
-	}
+	/*
+	 * The sessions may be served by different entrypoint threads. So each
+	 * quota limit is modified only while holding the lock of its session.
+	 * The locks are taken one after another to rule out deadlocks between
+	 * transfers in opposite directions.
+	 */
+	{
+		Lock::Guard lock_guard(_ref_members_lock);
+
+		/* decrease quota limit of this session - check against used quota */
+		if (_quota_limit < amount + _payload) {
+			PWRN("Insufficient quota for transfer: %s", _label);
+			PWRN("  have %zu, need %zu", _quota_limit - _payload, amount);
+			return -3;
+		}
 
-	_quota_limit -= amount;
+		_quota_limit -= amount;
+	}
 
 	/* increase quota_limit of recipient */
+	Lock::Guard lock_guard(dst->_ref_members_lock);
 	dst->_quota_limit += amount;
 
 	return 0;
@@ -263,6 +274,19 @@ int Ram_session_component::transfer_quota(Ram_session_capability ram_session_cap
 }
 
 
+Ram_session_component::Huge_pages
+Ram_session_component::_huge_pages_from_args(char const *args)
+{
+	char value[16];
+	Arg_string::find_arg(args, "huge_pages").string(value, sizeof(value), "no");
+
+	if (strcmp(value, "transparent") == 0) return HUGE_PAGES_TRANSPARENT;
+	if (strcmp(value, "hugetlb") == 0)     return HUGE_PAGES_HUGETLB;
+
+	return HUGE_PAGES_NO;
+}
+
+
 Ram_session_component::Ram_session_component(Rpc_entrypoint  *ds_ep,
                                              Rpc_entrypoint  *ram_session_ep,
                                              Range_allocator *ram_alloc,
@@ -274,7 +298,8 @@ Ram_session_component::Ram_session_component(Rpc_entrypoint  *ds_ep,
 	_quota_limit(quota_limit), _payload(0),
 	_md_alloc(md_alloc, Arg_string::find_arg(args, "ram_quota").ulong_value(0)),
 	_ds_slab(&_md_alloc), _ref_account(0),
-	_phys_start(Arg_string::find_arg(args, "phys_start").ulong_value(0))
+	_phys_start(Arg_string::find_arg(args, "phys_start").ulong_value(0)),
+	_huge_pages(_huge_pages_from_args(args))
 {
 	Arg_string::find_arg(args, "label").string(_label, sizeof(_label), "");
 
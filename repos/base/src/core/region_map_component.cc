@@ -216,6 +216,15 @@ int Rm_client::pager(Ipc_pager &pager)
 		if (!src_fault_area.valid() || !dst_fault_area.valid())
 			PERR("Invalid mapping");
 
+		/*
+		 * Reflect write faults at copy-on-write regions to the fault
+		 * handler, which resolves them by attaching a private copy
+		 */
+		if (pf_type == Region_map::State::WRITE_FAULT && !region->write()) {
+			region_map->fault(this, pf_addr - region_offset, pf_type);
+			return 2;
+		}
+
 		/*
 		 * Check if dataspace is compatible with page-fault type
 		 */
@@ -232,7 +241,7 @@ int Rm_client::pager(Ipc_pager &pager)
 
 		Mapping mapping(dst_fault_area.base(), src_fault_area.base(),
 		                dsc->cacheability(), dsc->io_mem(),
-		                map_size_log2, dsc->writable());
+		                map_size_log2, dsc->writable() && region->write());
 
 		/*
 		 * On kernels with a mapping database, the 'dsc' dataspace is a leaf
@@ -299,7 +308,8 @@ Region_map::Local_addr
 Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
                              off_t offset, bool use_local_addr,
                              Region_map::Local_addr local_addr,
-                             bool executable)
+                             bool executable, bool copy_on_write,
+                             bool populate)
 {
 	/* serialize access */
 	Lock::Guard lock_guard(_lock);
@@ -308,6 +318,14 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 	if (offset < 0 || align_addr(offset, get_page_size_log2()) != offset)
 		throw Invalid_args();
 
+	/*
+	 * Core has no backing store accounted for the private copies of
+	 * copy-on-write pages. Hence, write faults at such regions are
+	 * reflected to the fault handler, which must be present.
+	 */
+	if (copy_on_write && !_fault_notifier.context().valid())
+		throw Invalid_args();
+
 	auto lambda = [&] (Dataspace_component *dsc) {
 		/* check dataspace validity */
 		if (!dsc) throw Invalid_dataspace();
@@ -374,7 +392,7 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 		}
 
 		/* store attachment info in meta data */
-		_map.metadata(r, Rm_region((addr_t)r, size, true, dsc, offset, this));
+		_map.metadata(r, Rm_region((addr_t)r, size, !copy_on_write, dsc, offset, this));
 		Rm_region *region = _map.metadata(r);
 
 		/* also update region list */
@@ -390,6 +408,10 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 		/* inform dataspace about attachment */
 		dsc->attached_to(region);
 
+		/* nested region maps are populated by their own attachments */
+		if (populate && !dsc->sub_rm().valid())
+			_populate(*region);
+
 		if (verbose)
 			PDBG("attach ds %p (a=%lx,s=%zx,o=%lx) @ [%lx,%lx)",
 			     (Dataspace_component *)dsc, dsc->phys_addr(), dsc->size(),
@@ -416,6 +438,58 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 }
 
 
+void Region_map_component::_populate(Rm_region const &region)
+{
+	Dataspace_component &dsc = *region.dataspace();
+
+	addr_t const ds_base = dsc.map_src_addr();
+	bool   const write   = dsc.writable() && region.write();
+
+	/*
+	 * All clients share the address space of the region map. Hence,
+	 * installing the mappings for one of them suffices.
+	 */
+	Rm_client *client = _clients.first();
+
+	/*
+	 * Split the region into the flexpages that the pager would use to
+	 * answer the faults at the region
+	 */
+	for (addr_t offset = 0; offset < region.size(); ) {
+
+		Fault_area src_fault_area(ds_base + region.offset() + offset);
+		Fault_area dst_fault_area(region.base() + offset);
+		src_fault_area.constrain(ds_base, dsc.size());
+		dst_fault_area.constrain(region.base(), region.size());
+
+		size_t map_size_log2 = dst_fault_area.common_size_log2(dst_fault_area,
+		                                                       src_fault_area);
+		map_size_log2 = constrain_map_size_log2(map_size_log2);
+
+		src_fault_area.constrain(map_size_log2);
+		dst_fault_area.constrain(map_size_log2);
+		if (!src_fault_area.valid() || !dst_fault_area.valid())
+			return;
+
+		Mapping mapping(dst_fault_area.base(), src_fault_area.base(),
+		                dsc.cacheability(), dsc.io_mem(), map_size_log2, write);
+
+		/* make the backing store present in core */
+		if (!dsc.io_mem())
+			mapping.prepare_map_operation();
+
+		/*
+		 * If the kernel does not accept mappings ahead of a page fault,
+		 * the pager resolves the faults at the prepared backing store.
+		 */
+		if (client && !client->map(mapping))
+			client = nullptr;
+
+		offset = dst_fault_area.base() + (1UL << map_size_log2) - region.base();
+	}
+}
+
+
 static void unmap_managed(Region_map_component *rm, Rm_region *region, int level)
 {
 	for (Rm_region *managed = rm->dataspace_component()->regions()->first();
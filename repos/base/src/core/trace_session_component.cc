@@ -108,10 +108,73 @@ void Session_component::trace(Subject_id subject_id, Policy_id policy_id,
 }
 
 
-void Session_component::rule(Session_label const &, Thread_name const &,
-                             Policy_id, size_t)
+void Session_component::rule(Session_label const &label, Thread_name const &thread,
+                             Policy_id policy_id, size_t buffer_size)
 {
-	/* not implemented yet */
+	Rule *rule = nullptr;
+	try {
+		rule = new (&_md_alloc) Rule(label, thread, policy_id, buffer_size); }
+	catch (Allocator::Out_of_memory) { throw Out_of_metadata(); }
+
+	bool first_rule = false;
+	{
+		Lock::Guard guard(_rules_lock);
+
+		first_rule = !_rules.first();
+		_rules.insert(rule);
+	}
+
+	/*
+	 * Start listening for new sources with the first rule. The registry
+	 * calls 'new_source' with its listener lock held. Hence, the listener
+	 * must be added without holding the rules lock.
+	 */
+	if (first_rule)
+		_sources.add_listener(*this);
+}
+
+
+/**
+ * A rule matches the threads of the component with the rule's label and
+ * those of the component's children. An empty label or thread name matches
+ * any thread.
+ */
+bool Session_component::Rule::matches(Source::Info const &info) const
+{
+	if (thread.length() > 1 && strcmp(thread.string(), info.name.string()))
+		return false;
+
+	if (label.length() <= 1)
+		return true;
+
+	size_t const len = label.length() - 1;
+	char const *rest = info.label.string() + len;
+
+	return !strcmp(label.string(), info.label.string(), len)
+	    && (!*rest || !strcmp(rest, " -> ", 4));
+}
+
+
+void Session_component::new_source(Source &source)
+{
+	Lock::Guard guard(_rules_lock);
+
+	Source::Info const info = source.info();
+
+	for (Rule *rule = _rules.first(); rule; rule = rule->next()) {
+
+		if (!rule->matches(info))
+			continue;
+
+		try {
+			trace(_subjects.import_source(source), rule->policy,
+			      rule->buffer_size);
+		} catch (...) {
+			PWRN("could not trace thread \"%s\" of \"%s\"",
+			     info.name.string(), info.label.string());
+		}
+		return;
+	}
 }
 
 
@@ -168,5 +231,12 @@ Session_component::Session_component(Allocator &md_alloc, size_t ram_quota,
 
 Session_component::~Session_component()
 {
+	_sources.remove_listener(*this);
+
+	while (Rule *rule = _rules.first()) {
+		_rules.remove(rule);
+		destroy(&_md_alloc, rule);
+	}
+
 	_policies.destroy_policies_owned_by(*this);
 }
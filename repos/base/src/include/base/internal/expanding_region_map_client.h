@@ -22,7 +22,52 @@
 /* base-internal includes */
 #include <base/internal/upgradeable_client.h>
 
-namespace Genode { class Expanding_region_map_client; }
+namespace Genode {
+
+	class Expanding_region_map_client;
+
+	template <typename FUNC, typename HANDLER>
+	void retry_attach_batch(Region_map::Attach_batch &, FUNC const &,
+	                        HANDLER const &);
+}
+
+
+/**
+ * Perform attach batch and repeat the operations that failed for the lack
+ * of meta data
+ *
+ * \param attach   functor that performs the attach operations of a batch
+ * \param upgrade  functor that upgrades the meta-data quota
+ */
+template <typename FUNC, typename HANDLER>
+void Genode::retry_attach_batch(Region_map::Attach_batch &batch,
+                                FUNC const &attach, HANDLER const &upgrade)
+{
+	typedef Region_map::Attach_batch Attach_batch;
+
+	attach(batch);
+
+	for (;;) {
+
+		Attach_batch retry;
+		unsigned     index[Attach_batch::MAX_ENTRIES];
+
+		for (unsigned i = 0; i < batch.count; i++)
+			if (batch.entries[i].result == Attach_batch::OUT_OF_METADATA) {
+				index[retry.count] = i;
+				retry.entries[retry.count++] = batch.entries[i];
+			}
+
+		if (!retry.count)
+			return;
+
+		upgrade();
+		attach(retry);
+
+		for (unsigned i = 0; i < retry.count; i++)
+			batch.entries[index[i]] = retry.entries[i];
+	}
+}
 
 
 struct Genode::Expanding_region_map_client : Region_map_client
@@ -34,14 +79,24 @@ struct Genode::Expanding_region_map_client : Region_map_client
 
 	Local_addr attach(Dataspace_capability ds, size_t size, off_t offset,
 	                  bool use_local_addr, Local_addr local_addr,
-	                  bool executable) override
+	                  bool executable, bool copy_on_write,
+	                  bool populate) override
 	{
 		return retry<Region_map::Out_of_metadata>(
 			[&] () {
 				return Region_map_client::attach(ds, size, offset,
 				                                 use_local_addr,
 				                                 local_addr,
-				                                 executable); },
+				                                 executable,
+				                                 copy_on_write,
+				                                 populate); },
+			[&] () { _pd_client.upgrade_ram(8*1024); });
+	}
+
+	void attach_batch(Attach_batch &batch) override
+	{
+		retry_attach_batch(batch,
+			[&] (Attach_batch &b) { Region_map_client::attach_batch(b); },
 			[&] () { _pd_client.upgrade_ram(8*1024); });
 	}
 };
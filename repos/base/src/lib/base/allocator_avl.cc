@@ -100,6 +100,98 @@ void Allocator_avl_base::Block::recompute()
  ** Allocator_avl implementation **
  **********************************/
 
+/**
+ * Return index of the power-of-two size class that contains 'size'
+ */
+static inline unsigned size_class(size_t size)
+{
+	return 8*sizeof(size_t) - 1 - __builtin_clzl(size);
+}
+
+
+void Allocator_avl_base::_size_class_insert(Block *b)
+{
+	unsigned const c = size_class(b->size());
+
+	b->_size_class_prev = nullptr;
+	b->_size_class_next = _size_classes[c];
+
+	if (_size_classes[c])
+		_size_classes[c]->_size_class_prev = b;
+
+	_size_classes[c]  = b;
+	_size_class_mask |= (size_t)1 << c;
+}
+
+
+void Allocator_avl_base::_size_class_remove(Block *b)
+{
+	unsigned const c = size_class(b->size());
+
+	if (b->_size_class_prev)
+		b->_size_class_prev->_size_class_next = b->_size_class_next;
+	else
+		_size_classes[c] = b->_size_class_next;
+
+	if (b->_size_class_next)
+		b->_size_class_next->_size_class_prev = b->_size_class_prev;
+
+	b->_size_class_next = b->_size_class_prev = nullptr;
+
+	if (!_size_classes[c])
+		_size_class_mask &= ~((size_t)1 << c);
+}
+
+
+Allocator_avl_base::Block *
+Allocator_avl_base::_find_by_size_class(size_t size, unsigned align,
+                                        addr_t from, addr_t to)
+{
+	/*
+	 * Limit the number of blocks inspected per size class to keep the
+	 * lookup time bounded. Blocks may not fit because of the alignment
+	 * or address-range constraints.
+	 */
+	enum { MAX_PROBES = 4 };
+
+	if (!size || align >= 8*sizeof(size_t) - 1)
+		return nullptr;
+
+	auto probe = [&] (unsigned c) -> Block *
+	{
+		Block *b = _size_classes[c];
+		for (unsigned i = 0; b && i < MAX_PROBES; i++, b = b->_size_class_next)
+			if (b->_fits(size, align, from, to))
+				return b;
+		return nullptr;
+	};
+
+	/* try blocks of the size class of the requested size first */
+	unsigned const exact = size_class(size);
+	if (Block *b = probe(exact))
+		return b;
+
+	/*
+	 * Each block of a size class above the one of 'size' plus the worst-case
+	 * alignment padding is large enough. Take the smallest non-empty one.
+	 */
+	size_t const padding = ((size_t)1 << align) - 1;
+	if (!_sum_in_range(size, padding))
+		return nullptr;
+
+	unsigned const min_class = size_class(size + padding) + 1;
+	if (min_class >= NUM_SIZE_CLASSES)
+		return nullptr;
+
+	size_t mask = _size_class_mask & ~(((size_t)1 << min_class) - 1);
+	for (; mask; mask &= mask - 1)
+		if (Block *b = probe(__builtin_ctzl(mask)))
+			return b;
+
+	return nullptr;
+}
+
+
 Allocator_avl_base::Block *Allocator_avl_base::_alloc_block_metadata()
 {
 	void *b = 0;
@@ -136,6 +228,9 @@ int Allocator_avl_base::_add_block(Block *block_metadata,
 	/* insert block into avl tree */
 	_addr_tree.insert(block_metadata);
 
+	if (!used)
+		_size_class_insert(block_metadata);
+
 	return 0;
 }
 
@@ -144,8 +239,11 @@ void Allocator_avl_base::_destroy_block(Block *b)
 {
 	if (!b) return;
 
-	/* remove block from both avl trees */
+	/* remove block from avl tree and size-class list */
 	_addr_tree.remove(b);
+
+	if (!b->used())
+		_size_class_remove(b);
 	_md_alloc->free(b, _md_entry_size);
 }
 
@@ -277,9 +375,14 @@ Allocator_avl_base::alloc_aligned(size_t size, void **out_addr, int align,
 	if (!_alloc_two_blocks_metadata(&dst1, &dst2))
 		return Alloc_return(Alloc_return::OUT_OF_METADATA);
 
+	Block *b = _size_class_lookup
+	         ? _find_by_size_class(size, align, from, to) : nullptr;
+
 	/* find best fitting block */
-	Block *b = _addr_tree.first();
-	b = b ? b->find_best_fit(size, align, from, to) : 0;
+	if (!b) {
+		b = _addr_tree.first();
+		b = b ? b->find_best_fit(size, align, from, to) : 0;
+	}
 
 	if (!b) {
 		_md_alloc->free(dst1, sizeof(Block));
@@ -279,6 +279,18 @@ void Child::revoke_server(Server const *server)
 }
 
 
+bool Child::has_session_to(Server const *server)
+{
+	Lock::Guard lock_guard(_lock);
+
+	for (Session *s = _session_list.first(); s; s = s->next())
+		if (s->server() == server)
+			return true;
+
+	return false;
+}
+
+
 void Child::yield(Resource_args const &args)
 {
 	Lock::Guard guard(_yield_request_lock);
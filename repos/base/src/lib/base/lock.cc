@@ -13,7 +13,9 @@
 
 /* Genode includes */
 #include <base/cancelable_lock.h>
+#include <base/trace/events.h>
 #include <cpu/memory_barrier.h>
+#include <util/misc_math.h>
 
 /* base-internal includes */
 #include <base/internal/spin_lock.h>
@@ -60,10 +62,79 @@ void Cancelable_lock::Applicant::wake_up()
  ** Cancelable lock **
  *********************/
 
+/*
+ * Before a contending thread blocks, it polls the lock for a few rounds
+ * with an exponentially growing delay between the polls. If the lock holder
+ * leaves its critical section in the meantime, the thread saves the context
+ * switches for blocking and waking up. Whether the lock holder is running
+ * on another CPU cannot be determined in a kernel-independent way. Instead,
+ * the number of rounds is adapted per lock. It is increased whenever
+ * spinning succeeded and halved whenever the thread had to block anyway,
+ * e.g., because the lock holder got preempted. So spinning quickly ceases
+ * where it does not pay off, in particular on uniprocessor machines.
+ */
+enum { MIN_SPIN_ROUNDS     = 1,
+       MAX_SPIN_ROUNDS     = 10,
+       SPIN_DELAY_UNIT     = 16,
+       MAX_SPIN_DELAY_LOG2 = 6 };
+
+
+static inline void spin_delay(unsigned round)
+{
+	unsigned const iterations =
+		SPIN_DELAY_UNIT << Genode::min(round, (unsigned)MAX_SPIN_DELAY_LOG2);
+
+	for (unsigned volatile i = 0; i < iterations; i++);
+}
+
+
+unsigned Cancelable_lock::_spin()
+{
+	unsigned const rounds = _spin_rounds;
+
+	for (unsigned round = 1; round <= rounds; round++) {
+
+		spin_delay(round);
+
+		if (_state == UNLOCKED)
+			return round;
+	}
+	return rounds;
+}
+
+
+void Cancelable_lock::_adapt_spinning(unsigned spins, bool blocked)
+{
+	/* report contention to the tracing policy, if tracing is active */
+	Trace::Lock_contention trace_event(this, spins, blocked);
+
+	if (!spins)
+		return;
+
+	/*
+	 * The update is not synchronized. Concurrent updates may get lost,
+	 * which is fine for a heuristic.
+	 */
+	if (blocked)
+		_spin_rounds = max(_spin_rounds/2, (unsigned)MIN_SPIN_ROUNDS);
+	else
+		_spin_rounds = min(_spin_rounds + 1, (unsigned)MAX_SPIN_ROUNDS);
+}
+
+
 void Cancelable_lock::lock()
 {
 	Applicant myself(Thread::myself());
 
+	/*
+	 * Spin only if the lock is held but nobody waits for it. Otherwise, the
+	 * lock is handed over to the waiting applicants on 'unlock' without
+	 * becoming free in between.
+	 */
+	unsigned spins = 0;
+	if (_state == LOCKED && !_owner.applicant_to_wake_up() && _owner != myself)
+		spins = _spin();
+
 	spinlock_lock(&_spinlock_state);
 
 	/* reset ownership if one thread 'lock' twice */
@@ -76,6 +147,9 @@ void Cancelable_lock::lock()
 		_owner          =  myself;
 		_last_applicant = &_owner;
 		spinlock_unlock(&_spinlock_state);
+
+		if (spins)
+			_adapt_spinning(spins, false);
 		return;
 	}
 
@@ -133,6 +207,8 @@ void Cancelable_lock::lock()
 		throw Blocking_canceled();
 	}
 	spinlock_unlock(&_spinlock_state);
+
+	_adapt_spinning(spins, true);
 }
 
 
@@ -0,0 +1,97 @@
+/*
+ * \brief  Synchronization of object-pool lookups and removals
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/object_pool.h>
+#include <cpu/atomic.h>
+
+using namespace Genode;
+
+
+/**
+ * Add 'amount' to 'value'
+ *
+ * \return  new value
+ */
+static inline int atomic_add(volatile int *value, int amount)
+{
+	for (;;) {
+		int const old = *value;
+		if (cmpxchg(value, old, old + amount))
+			return old + amount;
+	}
+}
+
+
+void Object_pool_base::_dec_readers(int index)
+{
+	/*
+	 * The last reader wakes up a removal waiting for the counter. Because
+	 * the removal announces itself before checking the counter, either
+	 * the removal observes the zero or the reader observes the removal.
+	 */
+	if (atomic_add(&_readers[index], -1) == 0 && _draining == index + 1)
+		_drained.up();
+}
+
+
+int Object_pool_base::_enter_read()
+{
+	for (;;) {
+		int const epoch = _epoch;
+
+		atomic_add(&_readers[epoch & 1], 1);
+
+		/*
+		 * If a removal switched the epoch in the meanwhile, it may have
+		 * missed our increment. So we retry with the new epoch. The
+		 * 'cmpxchg' used by 'atomic_add' acts as memory barrier.
+		 */
+		if (_epoch == epoch)
+			return epoch & 1;
+
+		_dec_readers(epoch & 1);
+	}
+}
+
+
+void Object_pool_base::_leave_read(int epoch)
+{
+	_dec_readers(epoch);
+}
+
+
+void Object_pool_base::_wait_for_readers()
+{
+	/*
+	 * Switch the epoch and wait for the readers of the previous epoch to
+	 * drain. Lookups that enter after the switch cannot observe the
+	 * already unlinked entry.
+	 */
+	int const old_epoch = _epoch;
+	int const index     = old_epoch & 1;
+
+	_epoch    = old_epoch + 1;
+	_draining = index + 1;
+	memory_barrier();
+
+	/*
+	 * A wake-up may be stale, e.g., if a lookup that retried with the new
+	 * epoch dropped the counter to zero only temporarily. Hence, the
+	 * counter is checked again after each wake-up.
+	 */
+	while (_readers[index])
+		_drained.down();
+
+	_draining = 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * \brief  Generic batch operations of region maps
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <region_map/region_map.h>
+#include <util/misc_math.h>
+
+using namespace Genode;
+
+
+void Region_map::attach_batch(Attach_batch &batch)
+{
+	for (unsigned i = 0; i < batch.count; i++) {
+
+		Attach_batch::Entry &e = batch.entries[i];
+
+		try {
+			e.addr   = attach(e.ds, e.size, e.offset, e.use_local_addr,
+			                  e.local_addr, e.executable, e.copy_on_write,
+			                  e.populate);
+			e.result = Attach_batch::OK;
+		}
+		catch (Invalid_dataspace) { e.result = Attach_batch::INVALID_DATASPACE; }
+		catch (Region_conflict)   { e.result = Attach_batch::REGION_CONFLICT; }
+		catch (Out_of_metadata)   { e.result = Attach_batch::OUT_OF_METADATA; }
+		catch (Invalid_args)      { e.result = Attach_batch::INVALID_ARGS; }
+	}
+}
+
+
+void Region_map::detach_batch(Detach_batch const &batch)
+{
+	for (unsigned i = 0; i < batch.count && i < Detach_batch::MAX_ENTRIES; i++)
+		detach(batch.local_addr[i]);
+}
+
+
+void Region_map::attach_chunk(Dataspace_capability ds0, Dataspace_capability ds1,
+                              Dataspace_capability ds2, Dataspace_capability ds3,
+                              Attach_chunk &chunk)
+{
+	Dataspace_capability const ds[Attach_chunk::MAX_DATASPACES] =
+		{ ds0, ds1, ds2, ds3 };
+
+	unsigned const count = min(chunk.count, (unsigned)Attach_chunk::MAX_ENTRIES);
+
+	Attach_batch batch;
+	for (unsigned i = 0; i < count; i++) {
+
+		Attach_chunk::Entry const &e = chunk.entries[i];
+
+		/* an out-of-range index refers to an invalid dataspace */
+		batch.add(e.ds < Attach_chunk::MAX_DATASPACES ? ds[e.ds]
+		                                              : Dataspace_capability(),
+		          e.size, e.offset, e.use_local_addr, e.addr,
+		          e.executable, e.copy_on_write, e.populate);
+	}
+
+	attach_batch(batch);
+
+	for (unsigned i = 0; i < count; i++) {
+		chunk.entries[i].result = batch.entries[i].result;
+		chunk.entries[i].addr   = batch.entries[i].result == Attach_batch::OK
+		                        ? (addr_t)batch.entries[i].addr : 0;
+	}
+	chunk.count = count;
+}
+
+
+void Region_map::attach_batch_chunked(Attach_batch &batch,
+                                      Attach_chunk_transfer &transfer)
+{
+	unsigned i = 0;
+	while (i < batch.count) {
+
+		Dataspace_capability ds[Attach_chunk::MAX_DATASPACES];
+		unsigned             num_ds = 0;
+		Attach_chunk         chunk;
+		unsigned const       first = i;
+
+		/* fill chunk until it refers to the maximum number of dataspaces */
+		for (; i < batch.count && chunk.count < Attach_chunk::MAX_ENTRIES; i++) {
+
+			Attach_batch::Entry &e = batch.entries[i];
+
+			unsigned d = 0;
+			while (d < num_ds && !(ds[d] == e.ds))
+				d++;
+
+			if (d == num_ds) {
+				if (num_ds == Attach_chunk::MAX_DATASPACES)
+					break;
+				ds[num_ds++] = e.ds;
+			}
+
+			Attach_chunk::Entry &c = chunk.entries[chunk.count++];
+			c.size           = e.size;
+			c.offset         = e.offset;
+			c.addr           = e.local_addr;
+			c.ds             = d;
+			c.use_local_addr = e.use_local_addr;
+			c.executable     = e.executable;
+			c.copy_on_write  = e.copy_on_write;
+			c.populate       = e.populate;
+			c.result         = Attach_batch::PENDING;
+		}
+
+		transfer.transfer(ds[0], ds[1], ds[2], ds[3], chunk);
+
+		for (unsigned j = 0; j < i - first; j++) {
+			Attach_batch::Entry &e = batch.entries[first + j];
+
+			e.result = j < chunk.count ? chunk.entries[j].result
+			                           : Attach_batch::INVALID_ARGS;
+			e.addr   = e.result == Attach_batch::OK ? chunk.entries[j].addr : 0;
+		}
+	}
+}
@@ -28,11 +28,13 @@ using namespace Genode;
 
 Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 {
-	Untyped_capability new_obj_cap = _alloc_rpc_cap(_pd_session, _cap);
+	Rpc_entrypoint &ep = _serving_ep(*obj);
+
+	Untyped_capability new_obj_cap = _alloc_rpc_cap(_pd_session, ep._cap);
 
 	/* add server object to object pool */
 	obj->cap(new_obj_cap);
-	insert(obj);
+	_objects.insert(obj);
 
 	/* return capability that uses the object id as badge */
 	return new_obj_cap;
@@ -69,7 +71,7 @@ void Rpc_entrypoint::entry()
 		exc = Rpc_exception_code(Rpc_exception_code::INVALID_OBJECT);
 		_snd_buf.reset();
 
-		apply(request.badge, [&] (Rpc_object_base *obj)
+		_objects.apply(request.badge, [&] (Rpc_object_base *obj)
 		{
 			if (!obj) { return;}
 			try { exc = obj->dispatch(opcode, unmarshaller, _snd_buf); }
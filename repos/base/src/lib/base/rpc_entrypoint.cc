@@ -27,13 +27,15 @@ using namespace Genode;
 void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 {
 	/* make sure nobody is able to find this object */
-	remove(obj);
+	_objects.remove(obj);
 
 	_free_rpc_cap(_pd_session, obj->cap());
 
 	/* effectively invalidate the capability used before */
 	obj->cap(Untyped_capability());
 
+	_release_serving_ep(*obj);
+
 	/* now the object may be safely destructed */
 }
 
@@ -68,12 +70,23 @@ bool Rpc_entrypoint::is_myself() const
 Rpc_entrypoint::Rpc_entrypoint(Pd_session *pd_session, size_t stack_size,
                                char const *name, bool start_on_construction,
                                Affinity::Location location)
+:
+	Rpc_entrypoint(pd_session, stack_size, name, start_on_construction,
+	               location, *this)
+{ }
+
+
+Rpc_entrypoint::Rpc_entrypoint(Pd_session *pd_session, size_t stack_size,
+                               char const *name, bool start_on_construction,
+                               Affinity::Location location,
+                               Object_pool<Rpc_object_base> &objects)
 :
 	Thread(Cpu_session::Weight::DEFAULT_WEIGHT, name, stack_size, location),
 	_cap(Untyped_capability()),
 	_cap_valid(Lock::LOCKED), _delay_start(Lock::LOCKED),
 	_delay_exit(Lock::LOCKED),
-	_pd_session(*pd_session)
+	_pd_session(*pd_session),
+	_objects(objects)
 {
 	Thread::start();
 	_block_until_cap_valid();
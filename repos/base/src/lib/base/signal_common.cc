@@ -154,7 +154,8 @@ Signal Signal_receiver::pending_signal()
 		if (result.num == 0)
 			PWRN("returning signal with num == 0");
 
-		Trace::Signal_received trace_event(*context, result.num);
+		Trace::Signal_received trace_event(*context, result.num,
+		                                   context->_cap.local_name());
 
 		/* return last received signal */
 		return result;
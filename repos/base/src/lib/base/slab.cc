@@ -25,51 +25,61 @@ class Genode::Slab::Block
 {
 	public:
 
-		Block *next = this;  /* next block in ring     */
-		Block *prev = this;  /* previous block in ring */
+		Block *next = nullptr;  /* next block in fill-state list     */
+		Block *prev = nullptr;  /* previous block in fill-state list */
 
-	private:
+		enum { BITS_PER_WORD = sizeof(addr_t)*8 };
 
-		enum { FREE, USED };
+		/**
+		 * Return number of bitmap words needed for 'num_entries' entries
+		 */
+		static size_t bitmap_words(size_t num_entries) {
+			return (num_entries + BITS_PER_WORD - 1)/BITS_PER_WORD; }
+
+	private:
 
 		Slab  &_slab;                              /* back reference to slab     */
 		size_t _avail = _slab._entries_per_block;  /* free entries of this block */
+		size_t _free_word = 0;                     /* first bitmap word that may
+		                                              contain a free entry       */
 
 		/*
 		 * Each slab block consists of three areas, a fixed-size header
-		 * that contains the member variables declared above, a byte array
-		 * called state table that holds the allocation state for each slab
-		 * entry, and an area holding the actual slab entries. The number
-		 * of state-table elements corresponds to the maximum number of slab
-		 * entries per slab block (the '_entries_per_block' member variable of
-		 * the Slab allocator).
+		 * that contains the member variables declared above, a bitmap
+		 * that holds one bit per slab entry, and an area holding the
+		 * actual slab entries. A set bit marks a free entry, which allows
+		 * us to find a free entry by looking at one machine word at a
+		 * time.
 		 */
 
-		char _data[];  /* dynamic data (state table and slab entries) */
+		addr_t _bitmap[];  /* dynamic data (bitmap and slab entries) */
 
 		/*
 		 * Caution! no member variables allowed below this line!
 		 */
 
-		/**
-		 * Return the allocation state of a slab entry
-		 */
-		inline bool _state(int idx) { return _data[idx]; }
+		size_t _num_words() const {
+			return bitmap_words(_slab._entries_per_block); }
 
 		/**
-		 * Set the allocation state of a slab entry
+		 * Return mask of the bits of bitmap word 'w' that refer to entries
 		 */
-		inline void _state(int idx, bool state) { _data[idx] = state; }
+		addr_t _valid_mask(size_t w) const
+		{
+			size_t const bits = _slab._entries_per_block - w*BITS_PER_WORD;
+			return (bits >= BITS_PER_WORD) ? ~(addr_t)0
+			                               : ((addr_t)1 << bits) - 1;
+		}
 
 		/**
 		 * Request address of slab entry by its index
 		 */
-		Entry *_slab_entry(int idx);
+		Entry *_slab_entry(size_t idx);
 
 		/**
 		 * Determine block index of specified slab entry
 		 */
-		int _slab_entry_idx(Entry *e);
+		size_t _slab_entry_idx(Entry *e);
 
 	public:
 
@@ -78,14 +88,14 @@ class Genode::Slab::Block
 		 */
 		explicit Block(Slab &slab) : _slab(slab)
 		{
-			for (unsigned i = 0; i < _avail; i++)
-				_state(i, FREE);
+			for (size_t w = 0; w < _num_words(); w++)
+				_bitmap[w] = _valid_mask(w);
 		}
 
 		/**
 		 * Request number of available entries in block
 		 */
-		unsigned avail() const { return _avail; }
+		size_t avail() const { return _avail; }
 
 		/**
 		 * Allocate slab entry from block
@@ -138,21 +148,18 @@ struct Genode::Slab::Entry
  ** Slab block **
  ****************/
 
-Slab::Entry *Slab::Block::_slab_entry(int idx)
+Slab::Entry *Slab::Block::_slab_entry(size_t idx)
 {
 	/*
-	 * The slab slots start after the state array that consists
-	 * of 'num_elem' bytes. We align the first slot to a four-aligned
-	 * address.
+	 * The slab slots start right after the bitmap, which is made of
+	 * machine words. Hence, the first slot is naturally word-aligned.
 	 */
-
 	size_t const entry_size = sizeof(Entry) + _slab._slab_size;
-	return (Entry *)&_data[align_addr(_slab._entries_per_block, log2(sizeof(addr_t)))
-	                            + entry_size*idx];
+	return (Entry *)((addr_t)&_bitmap[_num_words()] + entry_size*idx);
 }
 
 
-int Slab::Block::_slab_entry_idx(Slab::Entry *e)
+size_t Slab::Block::_slab_entry_idx(Slab::Entry *e)
 {
 	size_t const entry_size = sizeof(Entry) + _slab._slab_size;
 	return ((addr_t)e - (addr_t)_slab_entry(0))/entry_size;
@@ -161,12 +168,17 @@ int Slab::Block::_slab_entry_idx(Slab::Entry *e)
 
 void *Slab::Block::alloc()
 {
-	for (unsigned i = 0; i < _slab._entries_per_block; i++) {
-		if (_state(i) != FREE)
+	for (size_t w = _free_word; w < _num_words(); w++) {
+
+		if (!_bitmap[w])
 			continue;
 
-		_state(i, USED);
-		Entry * const e = _slab_entry(i);
+		size_t const bit = __builtin_ctzl(_bitmap[w]);
+
+		_bitmap[w] &= ~((addr_t)1 << bit);
+		_free_word  = w;
+
+		Entry * const e = _slab_entry(w*BITS_PER_WORD + bit);
 		construct_at<Entry>(e, *this);
 		return e->data;
 	}
@@ -176,10 +188,12 @@ void *Slab::Block::alloc()
 
 Slab::Entry *Slab::Block::any_used_entry()
 {
-	for (unsigned i = 0; i < _slab._entries_per_block; i++)
-		if (_state(i) == USED)
-			return _slab_entry(i);
+	for (size_t w = 0; w < _num_words(); w++) {
 
+		addr_t const used = ~_bitmap[w] & _valid_mask(w);
+		if (used)
+			return _slab_entry(w*BITS_PER_WORD + __builtin_ctzl(used));
+	}
 	return nullptr;
 }
 
@@ -187,7 +201,14 @@ Slab::Entry *Slab::Block::any_used_entry()
 void Slab::Block::inc_avail(Entry &e)
 {
 	/* mark slab entry as free */
-	_state(_slab_entry_idx(&e), FREE);
+	size_t const idx = _slab_entry_idx(&e);
+	size_t const w   = idx/BITS_PER_WORD;
+
+	_bitmap[w] |= (addr_t)1 << (idx % BITS_PER_WORD);
+
+	if (w < _free_word)
+		_free_word = w;
+
 	_avail++;
 }
 
@@ -196,39 +217,46 @@ void Slab::Block::inc_avail(Entry &e)
  ** Slab **
  **********/
 
+size_t Slab::_calc_entries_per_block(size_t slab_size, size_t block_size)
+{
+	if (block_size <= sizeof(Block))
+		return 0;
+
+	size_t const avail      = block_size - sizeof(Block);
+	size_t const entry_size = slab_size + sizeof(Entry);
+
+	/*
+	 * Each entry costs its size plus one bit in the bitmap. Start with
+	 * this estimate and correct it by the rounding of the bitmap to
+	 * whole machine words.
+	 */
+	size_t n = (avail*8)/(entry_size*8 + 1);
+	while (n && n*entry_size + Block::bitmap_words(n)*sizeof(addr_t) > avail)
+		n--;
+
+	return n;
+}
+
+
 Slab::Slab(size_t slab_size, size_t block_size, void *initial_sb,
            Allocator *backing_store)
 :
 	_slab_size(slab_size),
 	_block_size(block_size),
-
-	/*
-	 * Calculate number of entries per slab block.
-	 *
-	 * The 'sizeof(umword_t)' is for the alignment of the first slab entry.
-	 * The 1 is for one byte state entry.
-	 */
-	_entries_per_block((_block_size - sizeof(Block) - sizeof(umword_t))
-	                   / (_slab_size + sizeof(Entry) + 1)),
-
+	_entries_per_block(_calc_entries_per_block(_slab_size, _block_size)),
 	_initial_sb((Block *)initial_sb),
 	_nested(false),
-	_curr_sb((Block *)initial_sb),
 	_backing_store(backing_store)
 {
-	/* if no initial slab block was specified, try to get one */
-	if (!_curr_sb && _backing_store)
-		_curr_sb = _new_slab_block();
+	Block *block = _initial_sb ? construct_at<Block>(_initial_sb, *this)
+	                           : _new_slab_block();
 
-	if (!_curr_sb) {
+	if (!block) {
 		PERR("failed to obtain initial slab block");
 		throw Out_of_memory();
 	}
 
-	/* init first slab block */
-	construct_at<Block>(_curr_sb, *this);
-	_total_avail = _entries_per_block;
-	_num_blocks  = 1;
+	_insert_sb(block);
 }
 
 
@@ -238,11 +266,13 @@ Slab::~Slab()
 		return;
 
 	/* free backing store */
-	while (_num_blocks > 1)
-		_free_curr_sb();
-
-	/* release last block */
-	_release_backing_store(_curr_sb);
+	Block **lists[] = { &_full_blocks, &_partial_blocks, &_empty_blocks };
+	for (Block **list : lists) {
+		while (Block *block = *list) {
+			_dequeue(*block);
+			_release_backing_store(block);
+		}
+	}
 }
 
 
@@ -256,6 +286,46 @@ Slab::Block *Slab::_new_slab_block()
 }
 
 
+Slab::Block *&Slab::_list_of(Block const &block)
+{
+	if (block.avail() == 0)                  return _full_blocks;
+	if (block.avail() == _entries_per_block) return _empty_blocks;
+	return _partial_blocks;
+}
+
+
+void Slab::_enqueue(Block &block)
+{
+	Block *&list = _list_of(block);
+
+	block.prev = nullptr;
+	block.next = list;
+	if (list)
+		list->prev = &block;
+	list = &block;
+
+	if (&list == &_empty_blocks)
+		_num_empty_blocks++;
+}
+
+
+void Slab::_dequeue(Block &block)
+{
+	Block *&list = _list_of(block);
+
+	if (block.prev) block.prev->next = block.next;
+	else            list = block.next;
+
+	if (block.next)
+		block.next->prev = block.prev;
+
+	block.next = block.prev = nullptr;
+
+	if (&list == &_empty_blocks)
+		_num_empty_blocks--;
+}
+
+
 void Slab::_release_backing_store(Block *block)
 {
 	if (block->avail() != _entries_per_block)
@@ -273,33 +343,45 @@ void Slab::_release_backing_store(Block *block)
 }
 
 
-void Slab::_free_curr_sb()
+void Slab::_release_empty_blocks()
 {
-	/* block to free */
-	Block * const block = _curr_sb;
-
-	/* advance '_curr_sb' because the old pointer won't be valid any longer */
-	_curr_sb = _curr_sb->next;
+	/*
+	 * Empty blocks are released lazily. As long as no more than
+	 * 'MAX_EMPTY_BLOCKS' empty blocks exist, we keep them around. Once
+	 * this threshold is exceeded, we shrink the number of empty blocks
+	 * down to 'MIN_EMPTY_BLOCKS'. The gap between both thresholds
+	 * prevents the slab from thrashing when the number of used entries
+	 * oscillates around a block boundary.
+	 */
+	enum { MIN_EMPTY_BLOCKS = 1, MAX_EMPTY_BLOCKS = 2 };
 
-	/* never free the initial block */
-	if (_num_blocks <= 1)
+	if (!_backing_store || _num_empty_blocks <= MAX_EMPTY_BLOCKS)
 		return;
 
-	/* remove block from ring */
-	block->prev->next = block->next;
-	block->next->prev = block->prev;
+	while (_num_empty_blocks > MIN_EMPTY_BLOCKS && _num_blocks > 1) {
+
+		/* never release the initial block, we did not allocate it */
+		Block *block = _empty_blocks;
+		if (block == _initial_sb)
+			block = block->next;
 
-	_release_backing_store(block);
+		if (!block)
+			return;
+
+		/*
+		 * Remove the block from the slab before handing it back to the
+		 * backing store because the backing store may, in turn, free
+		 * entries of this slab.
+		 */
+		_dequeue(*block);
+		_release_backing_store(block);
+	}
 }
 
 
 void Slab::_insert_sb(Block *sb)
 {
-	sb->prev = _curr_sb;
-	sb->next = _curr_sb->next;
-
-	_curr_sb->next->prev = sb;
-	_curr_sb->next = sb;
+	_enqueue(*sb);
 
 	_total_avail += _entries_per_block;
 	_num_blocks++;
@@ -331,21 +413,20 @@ bool Slab::alloc(size_t size, void **out_addr)
 
 		if (!sb) return false;
 
-		/*
-		 * The new block has the maximum number of available slots and
-		 * so we can insert it at the beginning of the sorted block
-		 * list.
-		 */
 		_insert_sb(sb);
 	}
 
-	/* skip completely occupied slab blocks, detect cycles */
-	Block const * const orig_curr_sb = _curr_sb;
-	for (; _curr_sb->avail() == 0; _curr_sb = _curr_sb->next)
-		if (_curr_sb->next == orig_curr_sb)
-			break;
+	/*
+	 * Prefer partially used blocks to keep the number of empty blocks,
+	 * which are candidates for being released, high.
+	 */
+	Block * const block = _partial_blocks ? _partial_blocks : _empty_blocks;
+	if (!block)
+		return false;
 
-	*out_addr = _curr_sb->alloc();
+	_dequeue(*block);
+	*out_addr = block->alloc();
+	_enqueue(*block);
 
 	if (*out_addr == nullptr)
 		return false;
@@ -364,38 +445,24 @@ void Slab::_free(void *addr)
 
 	Block &block = e->block;
 
+	_dequeue(block);
 	e->~Entry();
+	_enqueue(block);
+
 	_total_avail++;
 
-	/*
-	 * Release completely free slab blocks if the total number of free slab
-	 * entries exceeds the capacity of two slab blocks. This way we keep
-	 * a modest amount of available entries around so that thrashing effects
-	 * are mitigated.
-	 */
-	_curr_sb = &block;
-	while (_total_avail > 2*_entries_per_block
-	 && _num_blocks > 1
-	 && _curr_sb->avail() == _entries_per_block) {
-		_free_curr_sb();
-	}
+	_release_empty_blocks();
 }
 
 
 void *Slab::any_used_elem()
 {
-	if (_total_avail == _num_blocks*_entries_per_block)
+	Block * const block = _full_blocks ? _full_blocks : _partial_blocks;
+	if (!block)
 		return nullptr;
 
-	/*
-	 * We know that there exists at least one used element.
-	 */
-
-	/* skip completely free slab blocks */
-	for (; _curr_sb->avail() == _entries_per_block; _curr_sb = _curr_sb->next);
-
 	/* found a block with used elements - return address of the first one */
-	Entry *e = _curr_sb->any_used_entry();
+	Entry *e = block->any_used_entry();
 
 	return e ? e->data : nullptr;
 }
@@ -15,9 +15,11 @@
 #include <base/env.h>
 #include <base/thread.h>
 #include <base/trace/policy.h>
+#include <base/trace/events.h>
 #include <dataspace/client.h>
 #include <util/construct_at.h>
 #include <cpu_thread/client.h>
+#include <cpu/atomic.h>
 
 /* local includes */
 #include <base/internal/trace_control.h>
@@ -122,23 +124,76 @@ bool Trace::Logger::_evaluate_control()
 }
 
 
+bool Trace::Logger::_ready() const
+{
+	return !inhibit_tracing && control && enabled && policy_module && buffer
+	    && !control->tracing_inhibited() && !control->state_changed()
+	    && policy_version == control->policy_version();
+}
+
+
+uint64_t Trace::Logger::_timestamp() const
+{
+	return policy_module->timestamp();
+}
+
+
+uint64_t Trace::Logger::_timestamp(Checkpoint const *checkpoint) const
+{
+	return checkpoint->when ? checkpoint->when : _timestamp();
+}
+
+
 void Trace::Logger::log(char const *msg, size_t len)
 {
 	if (!this || !_evaluate_control()) return;
 
-	memcpy(buffer->reserve(len), msg, len);
-	buffer->commit(len);
+	if (!len) return;
+
+	Event_header header;
+	header.timestamp = policy_module->timestamp();
+	header.object    = 0;
+	header.thread    = thread_id;
+	header.subject   = 0;
+	header.type      = Event_header::TEXT;
+	header.cpu       = cpu_id;
+	header.length    = len;
+
+	char * const dst = buffer->reserve(sizeof(header) + len);
+	if (!dst)
+		return;
+
+	header.write(dst);
+	memcpy(dst + sizeof(header), msg, len);
+	buffer->commit(sizeof(header) + len);
+}
+
+
+/**
+ * Return component-local ID for a newly initialized logger
+ */
+static unsigned new_thread_id()
+{
+	static int volatile next_id;
+
+	for (;;) {
+		int const id = next_id;
+		if (cmpxchg(&next_id, id, id + 1))
+			return id;
+	}
 }
 
 
 void Trace::Logger::init(Thread_capability thread, Cpu_session *cpu_session,
-                         Trace::Control *attached_control)
+                         Trace::Control *attached_control, unsigned cpu_affinity)
 {
 	if (!attached_control)
 		return;
 
 	thread_cap = thread;
 	cpu        = cpu_session;
+	thread_id  = new_thread_id();
+	cpu_id     = cpu_affinity;
 
 	unsigned const index    = Cpu_thread_client(thread).trace_control_index();
 	Dataspace_capability ds = cpu->trace_control();
@@ -160,7 +215,9 @@ Trace::Logger::Logger()
 	policy_version(0),
 	policy_module(0),
 	max_event_size(0),
-	pending_init(false)
+	pending_init(false),
+	thread_id(0),
+	cpu_id(0)
 { }
 
 
@@ -214,8 +271,27 @@ Trace::Logger *Thread::_logger()
 			}
 
 		logger->init(thread_cap, cpu,
-		             myself ? myself->_trace_control : main_trace_control);
+		             myself ? myself->_trace_control : main_trace_control,
+		             myself ? myself->_affinity.xpos() : 0);
 	}
 
 	return logger;
 }
+
+
+Trace::Logger *Thread::_initialized_logger()
+{
+	if (inhibit_tracing)
+		return 0;
+
+	/*
+	 * The logger of the main thread is a function-local static object.
+	 * Accessing it may involve the guard lock of the C++ runtime, which
+	 * must be avoided here.
+	 */
+	Thread * const myself = Thread::myself();
+	if (!myself || !myself->_trace_logger.initialized())
+		return 0;
+
+	return &myself->_trace_logger;
+}
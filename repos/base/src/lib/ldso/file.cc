@@ -23,6 +23,9 @@
 #include <region_map/client.h>
 #include <util/retry.h>
 
+/* base-internal includes */
+#include <base/internal/expanding_region_map_client.h>
+
 char const *Linker::ELFMAG = "\177ELF";
 
 using namespace Linker;
@@ -127,7 +130,51 @@ class Linker::Rm_area
 				[&] () { env()->parent()->upgrade(env()->pd_session_cap(), "ram_quota=8K"); });
 		}
 
+		/**
+		 * Overwritten from 'Region_map_client'
+		 */
+		Local_addr attach_copy_on_write(Dataspace_capability ds, addr_t local_addr,
+		                                size_t size = 0, off_t offset = 0)
+		{
+			return retry<Region_map::Out_of_metadata>(
+				[&] () {
+					return _rm.attach_copy_on_write(ds, local_addr - _base, size, offset);
+				},
+				[&] () { env()->parent()->upgrade(env()->pd_session_cap(), "ram_quota=8K"); });
+		}
+
 		void detach(Local_addr local_addr) { _rm.detach((addr_t)local_addr - _base); }
+
+		/**
+		 * Perform batch of attach operations at absolute addresses
+		 */
+		void attach_batch(Region_map::Attach_batch &batch)
+		{
+			typedef Region_map::Attach_batch Attach_batch;
+
+			for (unsigned i = 0; i < batch.count; i++)
+				batch.entries[i].local_addr =
+					(addr_t)batch.entries[i].local_addr - _base;
+
+			retry_attach_batch(batch,
+				[&] (Attach_batch &b) { _rm.attach_batch(b); },
+				[&] () { env()->parent()->upgrade(env()->pd_session_cap(), "ram_quota=8K"); });
+
+			for (unsigned i = 0; i < batch.count; i++)
+				if (batch.entries[i].result == Attach_batch::OK)
+					batch.entries[i].addr = (addr_t)batch.entries[i].addr + _base;
+		}
+
+		/**
+		 * Perform batch of detach operations at absolute addresses
+		 */
+		void detach_batch(Region_map::Detach_batch batch)
+		{
+			for (unsigned i = 0; i < batch.count; i++)
+				batch.local_addr[i] = (addr_t)batch.local_addr[i] - _base;
+
+			_rm.detach_batch(batch);
+		}
 };
 
 
@@ -138,7 +185,12 @@ struct Linker::Elf_file : File
 {
 	Rom_connection           rom;
 	Ram_dataspace_capability ram_cap[Phdr::MAX_PHDR];
+	addr_t                   bss_addr[Phdr::MAX_PHDR] { }; /* RAM of copy-on-write segments */
 	bool                     loaded;
+
+	/* whole file, attached on demand for accessing sections */
+	mutable Elf::Ehdr const *content = nullptr;
+
 	Elf_file(char const *name, bool load = true)
 	:
 	 rom(name), loaded(load)
@@ -153,6 +205,9 @@ struct Linker::Elf_file : File
 	{
 		if (loaded)
 			unload_segments();
+
+		if (content)
+			env()->rm_session()->detach(content);
 	}
 
 	/**
@@ -203,6 +258,29 @@ struct Linker::Elf_file : File
 		size          = round_page(ph->p_vaddr + ph->p_memsz) - start;
 	}
 
+	void const *section(char const *name, Elf::Size &size) const override
+	{
+		if (!content)
+			content = env()->rm_session()->attach(const_cast<Elf_file *>(this)->rom.dataspace());
+
+		char     const *base = (char const *)content;
+		Elf::Shdr const *shdr = (Elf::Shdr const *)(base + content->e_shoff);
+
+		if (!content->e_shoff || content->e_shstrndx >= content->e_shnum)
+			return nullptr;
+
+		char const *names = base + shdr[content->e_shstrndx].sh_offset;
+
+		for (unsigned i = 0; i < content->e_shnum; i++) {
+			if (strcmp(names + shdr[i].sh_name, name))
+				continue;
+
+			size = shdr[i].sh_size;
+			return base + shdr[i].sh_offset;
+		}
+		return nullptr;
+	}
+
 	/**
 	 * Find PT_LOAD segemnts
 	 */
@@ -229,6 +307,45 @@ struct Linker::Elf_file : File
 	bool is_rw(Elf::Phdr const &ph) {
 		return ((ph.p_flags & PF_MASK) == (PF_R | PF_W)); }
 
+	/**
+	 * Attach operations for mapping segments
+	 *
+	 * The segments of a file are mapped by one batch of attach operations
+	 * to save round trips to the region map.
+	 */
+	struct Segment_batch
+	{
+		enum Kind { RX, RW_COW, BSS };
+
+		typedef Region_map::Attach_batch Attach_batch;
+
+		Attach_batch batch;
+		Kind         kind[Attach_batch::MAX_ENTRIES];
+		unsigned     nr  [Attach_batch::MAX_ENTRIES];  /* index of segment */
+
+		/* a segment needs at most two attach operations */
+		bool full() const { return batch.count + 2 > Attach_batch::MAX_ENTRIES; }
+
+		void add(Kind k, unsigned segment, Dataspace_capability ds,
+		         size_t size, off_t offset, addr_t local_addr,
+		         bool executable = false, bool copy_on_write = false)
+		{
+			kind[batch.count] = k;
+			nr  [batch.count] = segment;
+			batch.add(ds, size, offset, true, local_addr, executable,
+			          copy_on_write);
+		}
+	};
+
+	/**
+	 * Return true as long as copy-on-write mappings are supported
+	 */
+	static bool &cow_supported()
+	{
+		static bool supported = true;
+		return supported;
+	}
+
 	/**
 	 * Load PT_LOAD segments
 	 */
@@ -247,37 +364,145 @@ struct Linker::Elf_file : File
 			PDBG("reloc_base: " EFMT " start: " EFMT " end: " EFMT,
 			     reloc_base, start, reloc_base + start + size);
 
+		Segment_batch batch;
+
 		for (unsigned i = 0; i < p.count; i++) {
 			Elf::Phdr *ph = &p.phdr[i];
 
+			if (batch.full())
+				map_segments(batch, p);
+
 			if (is_rx(*ph))
-				load_segment_rx(*ph);
+				add_segment_rx(batch, *ph, i);
 
 			else if (is_rw(*ph))
-				load_segment_rw(*ph, i);
+				add_segment_rw(batch, *ph, i);
 
 			else {
 				PERR("LD: Non-RW/RX segment");
 				throw Invalid_file();
 			}
 		}
+
+		map_segments(batch, p);
+	}
+
+	/**
+	 * Add mapping of read-only segment to batch
+	 */
+	void add_segment_rx(Segment_batch &batch, Elf::Phdr const &p, unsigned nr)
+	{
+		batch.add(Segment_batch::RX, nr, rom.dataspace(),
+		          round_page(p.p_memsz), trunc_page(p.p_offset),
+		          trunc_page(p.p_vaddr) + reloc_base, true);
 	}
 
 	/**
-	 * Map read-only segment
+	 * Add mappings of read-write segment to batch
+	 *
+	 * The file content of the segment is mapped such that each page gets
+	 * duplicated not before it is written to. Pages that are only read
+	 * are shared with all other users of the ELF file. Only the pages
+	 * beyond the file content (.bss) are backed by a RAM dataspace.
+	 *
+	 * If copy-on-write mappings are not supported, the segment is copied
+	 * right away.
 	 */
-	void load_segment_rx(Elf::Phdr const &p)
+	void add_segment_rw(Segment_batch &batch, Elf::Phdr const &p, unsigned nr)
 	{
-		Rm_area::r()->attach_executable(rom.dataspace(),
-		                                trunc_page(p.p_vaddr) + reloc_base,
-		                                round_page(p.p_memsz),
-		                                trunc_page(p.p_offset));
+		if (!cow_supported()) {
+			load_segment_rw_copy(p, nr);
+			return;
+		}
+
+		addr_t const start    = trunc_page(p.p_vaddr) + reloc_base;
+		addr_t const file_end = round_page(p.p_vaddr + p.p_filesz) + reloc_base;
+		addr_t const mem_end  = round_page(p.p_vaddr + p.p_memsz)  + reloc_base;
+
+		if (file_end > start)
+			batch.add(Segment_batch::RW_COW, nr, rom.dataspace(),
+			          file_end - start, trunc_page(p.p_offset), start,
+			          false, true);
+
+		if (mem_end > file_end) {
+			ram_cap[nr]  = env()->ram_session()->alloc(mem_end - file_end);
+			bss_addr[nr] = file_end;
+			batch.add(Segment_batch::BSS, nr, ram_cap[nr], 0, 0, file_end);
+		}
+	}
+
+	/**
+	 * Perform attach operations of batch and complete the segments
+	 */
+	void map_segments(Segment_batch &batch, Phdr const &p)
+	{
+		typedef Region_map::Attach_batch Attach_batch;
+
+		Rm_area::r()->attach_batch(batch.batch);
+
+		/*
+		 * A rejected copy-on-write mapping leads to copying the segment.
+		 * Hence, the .bss part of the segment is released.
+		 */
+		bool copy[Phdr::MAX_PHDR] { };
+
+		for (unsigned i = 0; i < batch.batch.count; i++)
+			if (batch.kind[i] == Segment_batch::RW_COW
+			 && batch.batch.entries[i].result == Attach_batch::INVALID_ARGS) {
+				copy[batch.nr[i]] = true;
+				cow_supported()   = false;
+			}
+
+		for (unsigned i = 0; i < batch.batch.count; i++) {
+
+			Attach_batch::Entry const &e  = batch.batch.entries[i];
+			unsigned            const  nr = batch.nr[i];
+
+			if (!copy[nr]) {
+				e.throw_on_error();
+				continue;
+			}
+
+			if (batch.kind[i] == Segment_batch::BSS) {
+				if (e.result == Attach_batch::OK)
+					Rm_area::r()->detach(bss_addr[nr]);
+
+				env()->ram_session()->free(ram_cap[nr]);
+				ram_cap[nr]  = Ram_dataspace_capability();
+				bss_addr[nr] = 0;
+			}
+		}
+
+		for (unsigned i = 0; i < batch.batch.count; i++) {
+
+			unsigned const nr = batch.nr[i];
+
+			if (copy[nr]) {
+				if (batch.kind[i] == Segment_batch::RW_COW)
+					load_segment_rw_copy(p.phdr[nr], nr);
+				continue;
+			}
+
+			/* clear the part of the last file page that belongs to the .bss */
+			if (batch.kind[i] == Segment_batch::RW_COW) {
+				Elf::Phdr const &ph = p.phdr[nr];
+
+				addr_t const file_end = round_page(ph.p_vaddr + ph.p_filesz) + reloc_base;
+				addr_t const dst      = ph.p_vaddr + reloc_base;
+
+				if (ph.p_filesz < ph.p_memsz)
+					memset((void *)(dst + ph.p_filesz), 0,
+					       min(file_end, dst + ph.p_memsz) - (dst + ph.p_filesz));
+			}
+		}
+
+		batch = Segment_batch();
 	}
 
 	/**
 	 * Copy read-write segment
 	 */
-	void load_segment_rw(Elf::Phdr const &p, int nr)
+	void load_segment_rw_copy(Elf::Phdr const &p, int nr)
 	{
 		void  *src = env()->rm_session()->attach(rom.dataspace(), 0, p.p_offset);
 		addr_t dst = p.p_vaddr + reloc_base;
@@ -303,8 +528,27 @@ struct Linker::Elf_file : File
 		loadable_segments(p);
 
 		/* detach from RM area */
-		for (unsigned i = 0; i < p.count; i++)
-			Rm_area::r()->detach(trunc_page(p.phdr[i].p_vaddr) + reloc_base);
+		Region_map::Detach_batch batch;
+		for (unsigned i = 0; i < p.count; i++) {
+
+			if (batch.count + 2 > Region_map::Detach_batch::MAX_ENTRIES) {
+				Rm_area::r()->detach_batch(batch);
+				batch = Region_map::Detach_batch();
+			}
+
+			addr_t const start = trunc_page(p.phdr[i].p_vaddr) + reloc_base;
+
+			/*
+			 * The .bss of a segment without file content starts at the
+			 * segment start, at which nothing else is attached then.
+			 */
+			if (bss_addr[i] != start)
+				batch.add(start);
+
+			if (bss_addr[i])
+				batch.add(bss_addr[i]);
+		}
+		Rm_area::r()->detach_batch(batch);
 
 		/* free region from RM area */
 		Rm_area::r()->free_region(trunc_page(p.phdr[0].p_vaddr) + reloc_base);
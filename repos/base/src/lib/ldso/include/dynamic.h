@@ -18,6 +18,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -51,6 +53,105 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * The table is not part of the 'System V ABI' but defined by the GNU
+ * toolchain. It starts with a header of four 32-bit words followed by a
+ * bloom filter of address-sized words, the buckets, and the chains. The
+ * table covers only the symbols starting at 'symoffset'. The symbols of a
+ * bucket are stored consecutively in the symbol table. Each symbol has a
+ * chain entry holding its hash value, whose lowest bit marks the last
+ * symbol of the bucket.
+ */
+struct Linker::Gnu_hash_table
+{
+	typedef Genode::uint32_t uint32_t;
+
+	enum { BLOOM_BITS = sizeof(Elf::Addr)*8 };
+
+	uint32_t const *_words() const { return (uint32_t const *)this; }
+
+	uint32_t nbuckets()    const { return _words()[0]; }
+	uint32_t symoffset()   const { return _words()[1]; }
+	uint32_t bloom_size()  const { return _words()[2]; }
+	uint32_t bloom_shift() const { return _words()[3]; }
+
+	Elf::Addr const *bloom()   const { return (Elf::Addr const *)(_words() + 4); }
+	uint32_t  const *buckets() const { return (uint32_t const *)(bloom() + bloom_size()); }
+
+	/**
+	 * Return hash value stored for the symbol at 'sym_index'
+	 */
+	uint32_t chain(unsigned long sym_index) const {
+		return (buckets() + nbuckets())[sym_index - symoffset()]; }
+
+	/**
+	 * Return false if the table definitely lacks a symbol with 'hash'
+	 *
+	 * The bloom filter has two bits set per symbol. Most lookups of
+	 * symbols not defined by the object are rejected here without
+	 * touching the buckets, chains, or strings.
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		if (!bloom_size())
+			return true;
+
+		Elf::Addr const word = bloom()[(hash / BLOOM_BITS) % bloom_size()];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BLOOM_BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift()) % BLOOM_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols of the symbol table
+	 *
+	 * In contrast to the ELF hash table, the number is not stored in the
+	 * table. It is determined by the end of the chain of the last bucket.
+	 */
+	unsigned long nsyms() const
+	{
+		unsigned long last = 0;
+		for (uint32_t i = 0; i < nbuckets(); i++)
+			last = Genode::max(last, (unsigned long)buckets()[i]);
+
+		if (last < symoffset())
+			return symoffset();
+
+		while (!(chain(last) & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	/**
+	 * GNU hash function (Bernstein hash)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long    const sysv;
+	Genode::uint32_t const gnu;
+
+	Symbol_hash(char const *name)
+	: sysv(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -77,7 +178,9 @@ struct Linker::Dynamic
 	Object     const     *obj;
 	Elf::Dyn   const     *dynamic;
 
-	Hash_table          *hash_table    = nullptr;
+	Hash_table          *hash_table     = nullptr;
+	Gnu_hash_table      *gnu_hash_table = nullptr;
+	unsigned long        num_symbols    = 0;
 
 	Elf::Rela           *reloca        = nullptr;
 	unsigned long        reloca_size   = 0;
@@ -156,6 +259,7 @@ struct Linker::Dynamic
 				case DT_PLTRELSZ: pltrel_size = d->un.val;                           break;
 				case DT_PLTGOT  : section<typeof(pltgot)>(&pltgot, d);               break;
 				case DT_HASH    : section<typeof(hash_table)>(&hash_table, d);       break;
+				case DT_GNU_HASH: section<typeof(gnu_hash_table)>(&gnu_hash_table, d); break;
 				case DT_RELA    : section<typeof(reloca)>(&reloca, d);               break;
 				case DT_RELASZ  : reloca_size = d->un.val;                           break;
 				case DT_SYMTAB  : section<typeof(symtab)>(&symtab, d);               break;
@@ -171,6 +275,12 @@ struct Linker::Dynamic
 					break;
 			}
 		}
+
+		/* the ELF hash table is authoritative for the number of symbols */
+		if (hash_table)
+			num_symbols = hash_table->nchains();
+		else if (gnu_hash_table)
+			num_symbols = gnu_hash_table->nsyms();
 	}
 
 	void relocate()
@@ -179,6 +179,7 @@ namespace Linker {
 		DT_PLTREL   = 20,  /* PLT relcation */
 		DT_DEBUG    = 21,  /* debug structure location */
 		DT_JMPREL   = 23,  /* address of PLT relocation */
+		DT_GNU_HASH = 0x6ffffef5, /* address of GNU hash table */
 	};
 
 
@@ -252,6 +253,23 @@ namespace Linker {
 			Elf32_Word    p_align;    /* segment alignment        */
 		};
 
+		/**
+		 * Section header
+		 */
+		struct Shdr
+		{
+			Elf32_Word    sh_name;      /* section name (string-table index) */
+			Elf32_Word    sh_type;      /* section type                      */
+			Elf32_Word    sh_flags;     /* section flags                     */
+			Elf32_Addr    sh_addr;      /* section virtual address           */
+			Elf32_Off     sh_offset;    /* section file offset               */
+			Elf32_Word    sh_size;      /* section size in bytes             */
+			Elf32_Word    sh_link;      /* link to another section           */
+			Elf32_Word    sh_info;      /* additional section information    */
+			Elf32_Word    sh_addralign; /* section alignment                 */
+			Elf32_Word    sh_entsize;   /* entry size if section holds table */
+		};
+
 		/**
 		 * Dynamic structure (section .dynamic)
 		 */
@@ -370,6 +388,23 @@ namespace Linker {
 			Elf64_Xword   p_align;    /* segment alignment        */
 		};
 
+		/**
+		 * Section header
+		 */
+		struct Shdr
+		{
+			Elf64_Word    sh_name;      /* section name (string-table index) */
+			Elf64_Word    sh_type;      /* section type                      */
+			Elf64_Xword   sh_flags;     /* section flags                     */
+			Elf64_Addr    sh_addr;      /* section virtual address           */
+			Elf64_Off     sh_offset;    /* section file offset               */
+			Elf64_Xword   sh_size;      /* section size in bytes             */
+			Elf64_Word    sh_link;      /* link to another section           */
+			Elf64_Word    sh_info;      /* additional section information    */
+			Elf64_Xword   sh_addralign; /* section alignment                 */
+			Elf64_Xword   sh_entsize;   /* entry size if section holds table */
+		};
+
 		/**
 		 * Dynamic structure (section .dynamic)
 		 */
@@ -61,6 +61,18 @@ struct Linker::File
 
 	virtual ~File() { }
 
+	/**
+	 * Return content of the section 'name'
+	 *
+	 * The content stays accessible as long as the file exists.
+	 *
+	 * \param size  returned size of the section in bytes
+	 *
+	 * \return section content, or nullptr if the file lacks the section
+	 */
+	virtual void const *section(char const *name, Elf::Size &size) const {
+		return nullptr; }
+
 	Elf::Phdr const *elf_phdr(unsigned index) const
 	{
 		if (index < phdr.count)
@@ -72,6 +72,8 @@ struct Linker::Init : Genode::List<Object>
 			obj->relocate();
 		}
 
+		startup_checkpoint("relocated");
+
 		/*
 		 * Recursive initialization call is not allowed here. This might happend
 		 * when Shared_objects (e.g. dlopen and friends) are constructed from within
@@ -104,6 +106,8 @@ struct Linker::Init : Genode::List<Object>
 		}
 
 		in_progress = false;
+
+		startup_checkpoint("initialized");
 	}
 };
 
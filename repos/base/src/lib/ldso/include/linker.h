@@ -123,6 +123,15 @@ namespace Linker {
 	 */
 	void load_linker_phdr();
 
+	/**
+	 * Record that the program startup reached the checkpoint 'name'
+	 *
+	 * The checkpoints are submitted as trace events right before the
+	 * program is entered. Checkpoints reached afterwards, e.g., during the
+	 * initialization of a shared object loaded via 'dlopen', are ignored.
+	 */
+	void startup_checkpoint(char const *name);
+
 	/**
 	 * Exceptions
 	 */
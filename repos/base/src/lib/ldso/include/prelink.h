@@ -0,0 +1,242 @@
+/**
+ * \brief  Symbol resolutions computed in advance by the prelink tool
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__PRELINK_H_
+#define _INCLUDE__PRELINK_H_
+
+#include <dynamic.h>
+
+namespace Linker { class Prelink; }
+
+
+/**
+ * Content of the '.prelink' section of a dynamic binary
+ *
+ * The 'tool/prelink' host tool resolves the symbol references of a dynamic
+ * binary and all its shared objects in the same way as the linker does at
+ * runtime and stores the results in the '.prelink' section of the binary.
+ * The section consists of a header followed by one table per object of the
+ * dependency list. Each table starts with the 32-bit number of its entries.
+ * An entry names the object and the symbol that defines the symbol
+ * referenced by the table's object at 'sym_index'.
+ *
+ * The resolutions are valid only for the very same dependency list.
+ * Therefore, the header contains a CRC-32 checksum over the names, the
+ * symbol tables, and the string tables of all objects in the order of the
+ * dependency list. Changes of code or data that leave the symbol tables
+ * untouched do not affect symbol resolution and are not covered.
+ *
+ * The section is added by 'objcopy' without any alignment guarantees.
+ * Hence, its content is accessed via 'memcpy'.
+ */
+class Linker::Prelink
+{
+	public:
+
+		struct Header
+		{
+			char             magic[8];
+			Genode::uint32_t checksum;
+			Genode::uint32_t num_objects;
+		};
+
+		struct Entry
+		{
+			Genode::uint32_t sym_index;     /* symbol referenced by the object */
+			Genode::uint32_t def_object;    /* index within dependency list    */
+			Genode::uint32_t def_sym_index; /* symbol of the defining object   */
+		};
+
+	private:
+
+		enum { MAX_OBJECTS = 128 };
+
+		struct Table
+		{
+			Object           *obj         = nullptr;
+			char       const *entries     = nullptr;
+			Genode::uint32_t  num_entries = 0;
+		};
+
+		Table    _tables[MAX_OBJECTS];
+		unsigned _num_objects = 0;
+		bool     _valid       = false;
+
+		/**
+		 * Continue CRC-32 checksum 'crc' over 'len' bytes at 'data'
+		 *
+		 * The checksum is the one of zlib, which is used by the prelink tool.
+		 */
+		static Genode::uint32_t _crc32(Genode::uint32_t crc, void const *data,
+		                               Genode::size_t len)
+		{
+			static Genode::uint32_t table[256];
+			static bool             table_initialized = false;
+
+			if (!table_initialized) {
+				for (Genode::uint32_t i = 0; i < 256; i++) {
+					Genode::uint32_t c = i;
+					for (unsigned j = 0; j < 8; j++)
+						c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+					table[i] = c;
+				}
+				table_initialized = true;
+			}
+
+			unsigned char const *p = (unsigned char const *)data;
+
+			crc = ~crc;
+			for (Genode::size_t i = 0; i < len; i++)
+				crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+			return ~crc;
+		}
+
+		static Genode::uint32_t _checksum(Genode::Fifo<Dependency> &deps)
+		{
+			Genode::uint32_t crc = 0;
+
+			for (Dependency *d = deps.head(); d; d = d->next()) {
+				Dynamic const *dyn = d->obj->dynamic();
+
+				crc = _crc32(crc, d->obj->name(), Genode::strlen(d->obj->name()) + 1);
+				crc = _crc32(crc, dyn->symtab, dyn->num_symbols*sizeof(Elf::Sym));
+				crc = _crc32(crc, dyn->strtab, dyn->strtab_size);
+			}
+			return crc;
+		}
+
+		static Genode::uint32_t _read_uint32(char const *src)
+		{
+			Genode::uint32_t value;
+			Genode::memcpy(&value, src, sizeof(value));
+			return value;
+		}
+
+		void _invalid(char const *reason)
+		{
+			if (verbose)
+				Genode::printf("  prelink information not used: %s\n", reason);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param section  content of the '.prelink' section, or nullptr
+		 *                 if the binary is not prelinked
+		 * \param size     size of the section in bytes
+		 * \param deps     dependency list of the binary
+		 */
+		Prelink(void const *section, Elf::Size size, Genode::Fifo<Dependency> &deps)
+		{
+			if (!section)
+				return;
+
+			char const *p   = (char const *)section;
+			char const *end = p + size;
+
+			Header header;
+			if (size < sizeof(header)) {
+				_invalid("malformed section");
+				return;
+			}
+
+			Genode::memcpy(&header, p, sizeof(header));
+			p += sizeof(header);
+
+			if (Genode::memcmp(header.magic, "PRELINK1", sizeof(header.magic))) {
+				_invalid("unknown format");
+				return;
+			}
+
+			for (Dependency *d = deps.head(); d; d = d->next())
+				if (_num_objects++ < MAX_OBJECTS)
+					_tables[_num_objects - 1].obj = d->obj;
+
+			if (_num_objects != header.num_objects || _num_objects > MAX_OBJECTS) {
+				_invalid("dependencies changed");
+				return;
+			}
+
+			if (_checksum(deps) != header.checksum) {
+				_invalid("dependencies changed");
+				return;
+			}
+
+			for (unsigned i = 0; i < _num_objects; i++) {
+
+				if (end - p < (long)sizeof(Genode::uint32_t)) {
+					_invalid("malformed section");
+					return;
+				}
+
+				_tables[i].num_entries = _read_uint32(p);
+				_tables[i].entries     = p + sizeof(Genode::uint32_t);
+
+				p = _tables[i].entries;
+				if ((unsigned long)(end - p) / sizeof(Entry) < _tables[i].num_entries) {
+					_invalid("malformed section");
+					return;
+				}
+				p += _tables[i].num_entries*sizeof(Entry);
+			}
+
+			_valid = true;
+		}
+
+		/**
+		 * Call 'fn' for each symbol resolution of object 'obj'
+		 *
+		 * The functor is called with the index of the symbol referenced by
+		 * 'obj', the defining symbol, and the relocation base of the
+		 * defining object.
+		 *
+		 * \return false if no resolutions exist for 'obj'
+		 */
+		template <typename FN>
+		bool for_each_resolution(Object const *obj, FN const &fn) const
+		{
+			if (!_valid)
+				return false;
+
+			for (unsigned i = 0; i < _num_objects; i++) {
+
+				Table const &table = _tables[i];
+				if (table.obj != obj)
+					continue;
+
+				for (Genode::uint32_t j = 0; j < table.num_entries; j++) {
+
+					Entry e;
+					Genode::memcpy(&e, table.entries + j*sizeof(Entry), sizeof(e));
+
+					if (e.def_object >= _num_objects)
+						continue;
+
+					Object        *def = _tables[e.def_object].obj;
+					Dynamic const *dyn = def->dynamic();
+
+					if (e.def_sym_index >= dyn->num_symbols)
+						continue;
+
+					fn(e.sym_index, dyn->symtab + e.def_sym_index, def->reloc_base());
+				}
+				return true;
+			}
+			return false;
+		}
+};
+
+#endif /* _INCLUDE__PRELINK_H_ */
@@ -18,10 +18,13 @@
 #include <util/list.h>
 #include <util/string.h>
 #include <base/thread.h>
+#include <base/trace/events.h>
+#include <trace/timestamp.h>
 
 /* local includes */
 #include <dynamic.h>
 #include <init.h>
+#include <prelink.h>
 
 using namespace Linker;
 
@@ -32,10 +35,12 @@ namespace Linker {
 	struct Binary;
 	struct Link_map;
 	struct Debug;
+	class  Symbol_cache;
 
 };
 
 static    Binary *binary = 0;
+static    Prelink const *prelink = 0;
 bool      Linker::bind_now = false;
 bool      Linker::verbose  = false;
 Link_map *Link_map::first;
@@ -46,6 +51,141 @@ Link_map *Link_map::first;
 int genode_atexit(Linker::Func);
 
 
+/**
+ * Checkpoints of the program startup
+ *
+ * While loading the program, the checkpoints are merely recorded. Taking
+ * them as trace events right away would attribute the lazy setup of the
+ * trace logger, which involves several RPCs, to the first startup phase.
+ * Instead, the checkpoints are submitted with their original timestamps
+ * just before entering the program.
+ */
+struct Startup_checkpoints
+{
+	enum { MAX_CHECKPOINTS = 8 };
+
+	struct Entry
+	{
+		char const               *name;
+		Genode::Trace::Timestamp  when;
+	};
+
+	Entry    entries[MAX_CHECKPOINTS];
+	unsigned num       = 0;
+	bool     submitted = false;
+
+	void record(char const *name)
+	{
+		if (!submitted && num < MAX_CHECKPOINTS)
+			entries[num++] = { name, Genode::Trace::timestamp() };
+	}
+
+	void submit()
+	{
+		for (unsigned i = 0; i < num; i++)
+			Genode::Trace::Checkpoint(entries[i].name, "", nullptr,
+			                          entries[i].when);
+		submitted = true;
+	}
+};
+
+
+static Startup_checkpoints &startup_checkpoints()
+{
+	static Startup_checkpoints inst;
+	return inst;
+}
+
+
+void Linker::startup_checkpoint(char const *name)
+{
+	startup_checkpoints().record(name);
+}
+
+
+/**
+ * Results of symbol lookups by index, used while relocating an object
+ *
+ * The relocations of an object tend to refer to the same symbols many
+ * times, e.g., via the GOT, the PLT, and data relocations. Because the
+ * search through the objects of the dependency list is the dominating
+ * cost of relocating, the results are cached per symbol index. The cache
+ * is installed at the relocated object for the duration of the relocation
+ * only, which keeps the results valid without tracking objects that are
+ * loaded or unloaded later on.
+ */
+class Linker::Symbol_cache
+{
+	private:
+
+		struct Entry
+		{
+			Elf::Sym const *sym;
+			Elf::Addr       base;
+		};
+
+		Symbol_cache *&_slot;
+
+		unsigned long const _num_entries;
+		Genode::size_t const _size = _num_entries*sizeof(Entry);
+
+		Entry *_entries = nullptr;
+
+	public:
+
+		unsigned long lookups = 0;
+		unsigned long hits    = 0;
+
+		/**
+		 * Constructor
+		 *
+		 * \param slot         pointer at the relocated object to install the
+		 *                     cache at
+		 * \param num_entries  number of symbols of the relocated object
+		 *
+		 * If the memory for the cache cannot be allocated, all lookups
+		 * miss the cache.
+		 */
+		Symbol_cache(Symbol_cache *&slot, unsigned long num_entries)
+		: _slot(slot), _num_entries(num_entries)
+		{
+			if (_num_entries && Genode::env()->heap()->alloc(_size, (void **)&_entries))
+				Genode::memset(_entries, 0, _size);
+
+			_slot = this;
+		}
+
+		~Symbol_cache()
+		{
+			_slot = nullptr;
+
+			if (_entries)
+				Genode::env()->heap()->free(_entries, _size);
+		}
+
+		/**
+		 * Return cached symbol and its relocation base in 'base'
+		 */
+		Elf::Sym const *lookup(unsigned sym_index, Elf::Addr *base)
+		{
+			lookups++;
+
+			if (!_entries || sym_index >= _num_entries || !_entries[sym_index].sym)
+				return nullptr;
+
+			hits++;
+			*base = _entries[sym_index].base;
+			return _entries[sym_index].sym;
+		}
+
+		void insert(unsigned sym_index, Elf::Sym const *sym, Elf::Addr base)
+		{
+			if (_entries && sym_index < _num_entries)
+				_entries[sym_index] = { sym, base };
+		}
+};
+
+
 /**************************************************************
  ** ELF object types (shared object, dynamic binaries, ldso  **
  **************************************************************/
@@ -61,6 +201,11 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 	unsigned flags     = 0;
 	bool     relocated = false;
 
+	/**
+	 * Cache of symbol lookups, installed while relocating the object
+	 */
+	Symbol_cache *symbol_cache = nullptr;
+
 	Elf_object(Dependency const *dep, Elf::Addr reloc_base)
 	: Object(reloc_base), dyn(dep)
 	{ }
@@ -102,7 +247,7 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 	 */
 	Elf::Sym const *symbol(unsigned sym_index) const
 	{
-		if (sym_index > dyn.hash_table->nchains())
+		if (sym_index >= dyn.num_symbols)
 			return 0;
 
 		return dyn.symtab + sym_index;
@@ -116,13 +261,30 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 	}
 
 	/**
-	 * Lookup symbol name in this ELF
+	 * Return true if the symbol is a definition of 'name'
 	 */
-	Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+	bool symbol_matches(Elf::Sym const *sym, char const *name) const
+	{
+		/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+		if (sym->type() > STT_FUNC)
+			return false;
+
+		if (sym->st_value == 0)
+			return false;
+
+		/* check for symbol name */
+		char const *sym_name = symbol_name(sym);
+		return name[0] == sym_name[0] && !Genode::strcmp(name, sym_name);
+	}
+
+	/**
+	 * Lookup symbol name via the ELF hash table
+	 */
+	Elf::Sym const *lookup_symbol_sysv(char const *name, unsigned long hash) const
 	{
 		Hash_table *h = dyn.hash_table;
 
-		if (!h->buckets())
+		if (!h->nbuckets())
 			return nullptr;
 
 		unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
@@ -131,25 +293,69 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 		for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
 		{
 			/* bad object */
-			if (sym_index > h->nchains())
+			if (sym_index >= h->nchains())
 				return nullptr;
 
-			Elf::Sym const *sym      = symbol(sym_index);
-			char const     *sym_name = symbol_name(sym);
+			Elf::Sym const *sym = symbol(sym_index);
+			if (symbol_matches(sym, name))
+				return sym;
+		}
 
-			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-			if (sym->type() > STT_FUNC)
-				continue;
+		return nullptr;
+	}
 
-			if (sym->st_value == 0)
-				continue;
+	/**
+	 * Lookup symbol name via the GNU hash table
+	 */
+	Elf::Sym const *lookup_symbol_gnu(char const *name, Genode::uint32_t hash) const
+	{
+		Gnu_hash_table *h = dyn.gnu_hash_table;
 
-			/* check for symbol name */
-			if (name[0] != sym_name[0] || Genode::strcmp(name, sym_name))
-				continue;
+		if (!h->nbuckets() || !h->may_contain(hash))
+			return nullptr;
+
+		unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
 
-			return sym;
+		/* empty bucket */
+		if (sym_index < h->symoffset())
+			return nullptr;
+
+		/* traverse the symbols of the bucket */
+		for (;; sym_index++) {
+
+			/* bad object */
+			if (sym_index >= dyn.num_symbols)
+				return nullptr;
+
+			Genode::uint32_t const chain_hash = h->chain(sym_index);
+
+			/* compare the strings only if the hash values match */
+			if ((chain_hash | 1) == (hash | 1)) {
+				Elf::Sym const *sym = symbol(sym_index);
+				if (symbol_matches(sym, name))
+					return sym;
+			}
+
+			/* last symbol of the bucket */
+			if (chain_hash & 1)
+				return nullptr;
 		}
+	}
+
+	/**
+	 * Lookup symbol name in this ELF
+	 *
+	 * The GNU hash table is preferred because its bloom filter avoids
+	 * most of the string comparisons for symbols that are not defined
+	 * by this ELF.
+	 */
+	Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
+	{
+		if (dyn.gnu_hash_table)
+			return lookup_symbol_gnu(name, hash.gnu);
+
+		if (dyn.hash_table)
+			return lookup_symbol_sysv(name, hash.sysv);
 
 		return nullptr;
 	}
@@ -172,10 +378,35 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 
 	void relocate() override
 	{
-		if (!relocated)
-			dyn.relocate();
+		if (relocated)
+			return;
+
+		Genode::Trace::Timestamp const start = verbose ? Genode::Trace::timestamp() : 0;
+
+		Symbol_cache cache(symbol_cache, dyn.num_symbols);
+
+		/* populate cache with the symbol resolutions of the prelink tool */
+		bool const prelinked = prelink && prelink->for_each_resolution(this,
+			[&] (unsigned sym_index, Elf::Sym const *sym, Elf::Addr base) {
+				cache.insert(sym_index, sym, base); });
+
+		dyn.relocate();
+
+		/*
+		 * If all symbols are resolved already, binding the jump slots right
+		 * away is cheaper than binding them lazily later on.
+		 */
+		if (prelinked && !bind_now)
+			Reloc_bind_now r(dyn.dep, dyn.pltrel, dyn.pltrel_size);
 
 		relocated = true;
+
+		if (verbose)
+			Genode::printf("  %s: relocated in %llu cycles, %lu of %lu symbol "
+			               "lookups cached%s\n", name(),
+			               (unsigned long long)(Genode::Trace::timestamp() - start),
+			               cache.hits, cache.lookups,
+			               prelinked ? " (prelinked)" : "");
 	}
 
 	void info(Genode::addr_t addr, Genode::Address_info &info) override
@@ -184,9 +415,7 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 		info.base = map.addr;
 		info.addr = 0;
 
-		Hash_table *h = dyn.hash_table;
-
-		for (unsigned long sym_index = 0; sym_index < h->nchains(); sym_index++)
+		for (unsigned long sym_index = 0; sym_index < dyn.num_symbols; sym_index++)
 		{
 			Elf::Sym const *sym = symbol(sym_index);
 
@@ -260,7 +489,10 @@ struct Linker::Ld : Dependency, Elf_object
 		 * Use DT_HASH table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		map.addr = trunc_page((Elf::Addr)dynamic()->hash_table);
+		Elf::Addr const table = dynamic()->hash_table
+		                      ? (Elf::Addr)dynamic()->hash_table
+		                      : (Elf::Addr)dynamic()->gnu_hash_table;
+		map.addr = trunc_page(table);
 	}
 
 	void load_phdr()
@@ -268,6 +500,20 @@ struct Linker::Ld : Dependency, Elf_object
 		_file = Linker::load(name(), false);
 	}
 
+	/**
+	 * Relocate without symbol cache
+	 *
+	 * When the linker relocates itself, neither global data nor the heap
+	 * can be used.
+	 */
+	void relocate() override
+	{
+		if (!relocated)
+			dyn.relocate();
+
+		relocated = true;
+	}
+
 	void relocate_global() { dynamic()->relocate_non_plt(true); }
 	void update_dependency(Dependency const *dep) { dynamic()->dep = dep; }
 
@@ -344,15 +590,27 @@ struct Linker::Binary : Root_object, Elf_object
 		/* load dependencies */
 		binary->load_needed(&dep);
 
+		startup_checkpoint("loaded");
+
+		/* use symbol resolutions of the prelink tool if present */
+		Elf::Size   prelink_size    = 0;
+		void const *prelink_section = _file->section(".prelink", prelink_size);
+
+		Prelink prelink_info(prelink_section, prelink_size, dep);
+		if (prelink_section)
+			prelink = &prelink_info;
+
 		/* relocate and call constructors */
 		Init::list()->initialize();
+
+		prelink = nullptr;
 	}
 
 	Elf::Addr lookup_symbol(char const *name)
 	{
 		Elf::Sym const *symbol = 0;
 
-		if ((symbol = Elf_object::lookup_symbol(name, Hash_table::hash(name))))
+		if ((symbol = Elf_object::lookup_symbol(name, Symbol_hash(name))))
 			return reloc_base() + symbol->st_value;
 
 		return 0;
@@ -369,6 +627,9 @@ struct Linker::Binary : Root_object, Elf_object
 		Func * const dtors_end   = (Func *)lookup_symbol("_dtors_end");
 		for (Func * dtor = dtors_start; dtor != dtors_end; genode_atexit(*dtor++));
 
+		startup_checkpoint("constructed");
+		startup_checkpoints().submit();
+
 		/* call component entry point */
 		/* XXX the function type for call_component_construct() is a candidate
 		 * for a base-internal header */
@@ -441,7 +702,19 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const *dep,
 		return symbol;
 	}
 
-	return lookup_symbol(e->symbol_name(symbol), dep, base, undef, other);
+	/* only plain lookups are cached, which are the vast majority */
+	Symbol_cache * const cache = (undef || other) ? nullptr : e->symbol_cache;
+
+	if (cache)
+		if (Elf::Sym const *cached = cache->lookup(sym_index, base))
+			return cached;
+
+	Elf::Sym const *result = lookup_symbol(e->symbol_name(symbol), dep, base,
+	                                       undef, other);
+	if (cache)
+		cache->insert(sym_index, result, *base);
+
+	return result;
 }
 
 
@@ -449,7 +722,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const *dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = dep->root ? dep->root->dep.head() : dep;
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -547,6 +820,8 @@ struct Failed_to_load_program { };
 
 void Component::construct(Genode::Env &env)
 {
+	startup_checkpoint("ldso");
+
 	/* load program headers of linker now */
 	if (!Ld::linker()->file())
 		Ld::linker()->load_phdr();
@@ -0,0 +1,101 @@
+/*
+ * \brief  Benchmark for the allocation of RAM dataspaces under churn
+ * \author Genode Labs
+ * \date   2016-06-06
+ *
+ * The test allocates and frees RAM dataspaces of various sizes in an
+ * interleaved fashion. This way, core's physical-memory allocator has to
+ * deal with a fragmented address space, which stresses the lookup of
+ * free blocks.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <ram_session/ram_session.h>
+#include <timer_session/connection.h>
+
+using Genode::size_t;
+using Genode::printf;
+
+
+enum { NUM_SLOTS = 256, NUM_ROUNDS = 16 };
+
+static Genode::Ram_dataspace_capability slots[NUM_SLOTS];
+
+
+/**
+ * Return dataspace size for the given slot and round
+ *
+ * The sizes range from 4 KiB to 256 KiB, spread over the slots such that
+ * neighbouring slots are of different sizes.
+ */
+static size_t ds_size(unsigned slot, unsigned round)
+{
+	return 4096*(1 + ((slot*7 + round*13) % 64));
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- dataspace churn test ---\n");
+
+	static Timer::Connection timer;
+
+	Genode::Ram_session &ram = *Genode::env()->ram_session();
+
+	unsigned long ops = 0;
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+
+		unsigned long const round_start_ms = timer.elapsed_ms();
+
+		/*
+		 * Replace every dataspace of the slots selected by the round's
+		 * stride, which frees and allocates dataspaces in scattered
+		 * places of the physical address space.
+		 */
+		unsigned const stride = 1 + (round % 3);
+		for (unsigned i = 0; i < NUM_SLOTS; i += stride) {
+
+			if (slots[i].valid()) {
+				ram.free(slots[i]);
+				ops++;
+			}
+
+			try {
+				slots[i] = ram.alloc(ds_size(i, round));
+				ops++;
+			} catch (...) {
+				PERR("allocation of dataspace failed");
+				return -1;
+			}
+		}
+
+		printf("round %u took %lu ms (used quota: %zu)\n", round,
+		       timer.elapsed_ms() - round_start_ms, ram.used());
+	}
+
+	for (unsigned i = 0; i < NUM_SLOTS; i++)
+		if (slots[i].valid())
+			ram.free(slots[i]);
+
+	unsigned long const duration_ms = timer.elapsed_ms() - start_ms;
+
+	printf("timing: %lu alloc/free operations took %lu ms\n",
+	       ops, duration_ms);
+
+	if (duration_ms)
+		printf("timing: %lu operations per second\n",
+		       ops*1000/duration_ms);
+
+	printf("--- finished dataspace churn test ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-ds_churn
+SRC_CC = main.cc
+LIBS   = base
@@ -20,6 +20,9 @@
 
 #include <cap_session/connection.h>
 #include <base/rpc_server.h>
+#include <base/rpc_entrypoint_pool.h>
+#include <timer_session/connection.h>
+#include <util/misc_math.h>
 
 namespace Test {
 
@@ -34,7 +37,9 @@ namespace Test {
 		GENODE_RPC(Rpc_test_cap, void, test_cap, Genode::Native_capability);
 		GENODE_RPC(Rpc_test_cap_reply, Genode::Native_capability,
 		           test_cap_reply, Genode::Native_capability);
-		GENODE_RPC_INTERFACE(Rpc_test_untyped, Rpc_test_cap, Rpc_test_cap_reply);
+		GENODE_RPC(Rpc_test_busy, unsigned long, test_busy, unsigned);
+		GENODE_RPC_INTERFACE(Rpc_test_untyped, Rpc_test_cap, Rpc_test_cap_reply,
+		                     Rpc_test_busy);
 	};
 
 	struct Client : Genode::Rpc_client<Session>
@@ -45,6 +50,8 @@ namespace Test {
 		void test_cap(Genode::Native_capability cap) { call<Rpc_test_cap>(cap); }
 		Genode::Native_capability test_cap_reply(Genode::Native_capability cap) {
 			return call<Rpc_test_cap_reply>(cap); }
+		unsigned long test_busy(unsigned rounds) {
+			return call<Rpc_test_busy>(rounds); }
 	};
 
 	struct Component : Genode::Rpc_object<Session, Component>
@@ -55,6 +62,10 @@ namespace Test {
 		void test_cap(Genode::Native_capability);
 		/* Test to transfer a object capability during send+reply */
 		Genode::Native_capability test_cap_reply(Genode::Native_capability);
+		/* Benchmark to keep the server busy for the given number of rounds */
+		unsigned long test_busy(unsigned);
+
+		bool concurrent_dispatch() const override { return true; }
 	};
 
 	typedef Genode::Capability<Session> Capability;
@@ -78,6 +89,92 @@ namespace Test {
 		               cap.local_name());
 		return cap;
 	}
+
+	unsigned long Component::test_busy(unsigned rounds)
+	{
+		unsigned long volatile sum = 0;
+		for (unsigned i = 0; i < rounds; i++)
+			sum = sum + i;
+
+		return sum;
+	}
+
+	/**
+	 * Client thread issuing a series of busy calls
+	 */
+	struct Caller : Genode::Thread
+	{
+		Client         client;
+		unsigned const calls;
+		unsigned const rounds;
+
+		Caller(Capability cap, Genode::Affinity::Location location,
+		       unsigned calls, unsigned rounds)
+		:
+			Thread(Weight::DEFAULT_WEIGHT, "caller", 4096, location),
+			client(cap), calls(calls), rounds(rounds)
+		{ }
+
+		void entry()
+		{
+			for (unsigned i = 0; i < calls; i++)
+				client.test_busy(rounds);
+		}
+	};
+
+	/**
+	 * Measure the duration of one busy-call series per client
+	 *
+	 * \param num_clients  number of client threads, each using its own
+	 *                     session object
+	 * \param cpus         affinity space for placing clients and servers
+	 * \param workers      number of worker threads of the entrypoint pool
+	 * \param threads      number of threads serving the components
+	 *
+	 * \return  duration in milliseconds
+	 */
+	unsigned long benchmark(Timer::Connection &timer, unsigned num_clients,
+	                        Genode::Affinity::Space cpus, unsigned workers,
+	                        unsigned &threads)
+	{
+		using namespace Genode;
+
+		enum { STACK_SIZE = 8192, CALLS = 200, ROUNDS = 100000, MAX_CLIENTS = 64 };
+
+		num_clients = min(num_clients, (unsigned)MAX_CLIENTS);
+
+		Rpc_entrypoint_pool pool(env()->pd_session(), STACK_SIZE, "pool",
+		                         *env()->heap(), cpus, workers);
+
+		/* the components are served by the workers only, if there are any */
+		threads = pool.num_workers() ? pool.num_workers() : 1;
+
+		Component components[MAX_CLIENTS];
+		Caller   *callers[MAX_CLIENTS];
+
+		for (unsigned i = 0; i < num_clients; i++)
+			callers[i] = new (env()->heap())
+				Caller(pool.manage(&components[i]),
+				       cpus.location_of_index(i % cpus.total()),
+				       CALLS, ROUNDS);
+
+		unsigned long const start = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_clients; i++)
+			callers[i]->start();
+
+		for (unsigned i = 0; i < num_clients; i++)
+			callers[i]->join();
+
+		unsigned long const duration = timer.elapsed_ms() - start;
+
+		for (unsigned i = 0; i < num_clients; i++) {
+			destroy(env()->heap(), callers[i]);
+			pool.dissolve(&components[i]);
+		}
+
+		return duration;
+	}
 }
 
 /**
@@ -135,5 +232,26 @@ int main(int argc, char **argv)
 
 	printf("done\n");
 
+	/*
+	 * Benchmark: Issue busy calls from one client thread per CPU, first
+	 * served by a single entrypoint thread, then by an entrypoint pool with
+	 * one thread per CPU.
+	 */
+	static Timer::Connection timer;
+
+	unsigned threads = 0;
+
+	unsigned long const single =
+		Test::benchmark(timer, cpus.total(), cpus, 0, threads);
+	printf("timing: %u server thread%s, %u clients: %lu ms\n",
+	       threads, threads > 1 ? "s" : "", cpus.total(), single);
+
+	unsigned long const pool =
+		Test::benchmark(timer, cpus.total(), cpus, cpus.total(), threads);
+	printf("timing: %u server thread%s, %u clients: %lu ms\n",
+	       threads, threads > 1 ? "s" : "", cpus.total(), pool);
+
+	printf("--- benchmark finished ---\n");
+
 	sleep_forever();
 }
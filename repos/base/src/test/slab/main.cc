@@ -25,7 +25,8 @@ using Genode::printf;
 
 struct Array_of_slab_elements
 {
-	Genode::Slab &slab;
+	Genode::Slab   &slab;
+	Timer::Session &timer;
 
 	size_t const num_elem;
 	size_t const slab_size;
@@ -44,24 +45,53 @@ struct Array_of_slab_elements
 	 *
 	 * \throw Alloc_failed
 	 */
-	Array_of_slab_elements(Genode::Slab &slab, size_t num_elem, size_t slab_size)
+	Array_of_slab_elements(Genode::Slab &slab, Timer::Session &timer,
+	                       size_t num_elem, size_t slab_size)
 	:
-		slab(slab), num_elem(num_elem), slab_size(slab_size)
+		slab(slab), timer(timer), num_elem(num_elem), slab_size(slab_size)
 	{
 		elem = (void **)Genode::env()->heap()->alloc(_elem_array_size());
 
 		printf(" allocate %zu elements\n", num_elem);
+		unsigned long const start_ms = timer.elapsed_ms();
 		for (size_t i = 0; i < num_elem; i++)
 			if (!slab.alloc(slab_size, &elem[i]))
 				throw Alloc_failed();
+
+		printf(" timing: alloc %zu elements took %lu ms\n",
+		       num_elem, timer.elapsed_ms() - start_ms);
+	}
+
+	/**
+	 * Free and re-allocate every other element
+	 *
+	 * This access pattern leaves all slab blocks partially used, which
+	 * stresses the selection of a block with free entries.
+	 */
+	void churn()
+	{
+		unsigned long const start_ms = timer.elapsed_ms();
+		for (size_t i = 0; i < num_elem; i += 2)
+			slab.free(elem[i], slab_size);
+
+		for (size_t i = 0; i < num_elem; i += 2)
+			if (!slab.alloc(slab_size, &elem[i]))
+				throw Alloc_failed();
+
+		printf(" timing: churn %zu elements took %lu ms\n",
+		       num_elem, timer.elapsed_ms() - start_ms);
 	}
 
 	~Array_of_slab_elements()
 	{
 		printf(" free %zu elements\n", num_elem);
+		unsigned long const start_ms = timer.elapsed_ms();
 		for (size_t i = 0; i < num_elem; i++)
 			slab.free(elem[i], slab_size);
 
+		printf(" timing: free %zu elements took %lu ms\n",
+		       num_elem, timer.elapsed_ms() - start_ms);
+
 		Genode::env()->heap()->free(elem, _elem_array_size());
 	}
 };
@@ -83,15 +113,17 @@ int main(int argc, char **argv)
 			printf("round %u (used quota: %zu, time: %ld ms)\n",
 			       i, alloc.consumed(), timer.elapsed_ms());
 
-			Array_of_slab_elements array(slab, i*100000, SLAB_SIZE);
-			printf(" allocation completed (used quota: %zu", alloc.consumed());
+			Array_of_slab_elements array(slab, timer, i*100000, SLAB_SIZE);
+			printf(" allocation completed (used quota: %zu)\n", alloc.consumed());
+
+			array.churn();
 		}
 
 		printf(" finished (used quota: %zu, time: %ld ms)\n",
 		       alloc.consumed(), timer.elapsed_ms());
 
 		/*
-		 * The slab keeps two empty blocks around. For the test, we also need to
+		 * The slab keeps at most two empty blocks around. For the test, we also need to
 		 * take the overhead of the two block allocations at the heap into
 		 * account.
 		 */
@@ -101,6 +101,7 @@ int main(int argc, char *argv[])
 	char const *file_name3    = "test3.tst";
 	char const *file_name4    = "test4.tst";
 	char const *file_name5    = "test5.tst";
+	char const *file_name6    = "test6.tst";
 	char const *pattern       = "a single line of text";
 
 	size_t      pattern_size  = strlen(pattern) + 1;
@@ -250,6 +251,43 @@ int main(int argc, char *argv[])
 		               (ret == 0) && (stat_buf.st_size == 0),
 		               "file_name=%s", file_name4);
 
+		/*
+		 * Test write and read of more than 64 KiB per call, which exceeds
+		 * the size of a single packet of a file-system session
+		 */
+		{
+			size_t const large_size = 256*1024;
+			char * const large_buf  = (char *)malloc(large_size);
+
+			for (size_t j = 0; j < large_size; j++)
+				large_buf[j] = j % 251;
+
+			CALL_AND_CHECK(fd, open(file_name6, O_CREAT | O_WRONLY | O_TRUNC), fd >= 0, "file_name=%s", file_name6);
+			CALL_AND_CHECK(count, write(fd, large_buf, large_size), (size_t)count == large_size, "");
+			CALL_AND_CHECK(ret, close(fd), ret == 0, "");
+			CALL_AND_CHECK(ret, stat(file_name6, &stat_buf),
+			               (ret == 0) && ((size_t)stat_buf.st_size == large_size),
+			               "file_name=%s", file_name6);
+
+			memset(large_buf, 0, large_size);
+
+			CALL_AND_CHECK(fd, open(file_name6, O_RDONLY), fd >= 0, "file_name=%s", file_name6);
+			for (size_t n = 0; n < large_size; n += count) {
+				CALL_AND_CHECK(count, read(fd, large_buf + n, large_size - n), count > 0, "");
+			}
+			CALL_AND_CHECK(ret, close(fd), ret == 0, "");
+
+			for (size_t j = 0; j < large_size; j++) {
+				if (large_buf[j] != (char)(j % 251)) {
+					printf("unexpected content of file at offset %zu\n", j);
+					return -1;
+				}
+			}
+			printf("file content is correct\n");
+
+			free(large_buf);
+		}
+
 		/* test 'fchdir()' */
 		CALL_AND_CHECK(fd, open(dir_name, O_RDONLY), fd >= 0, "dir_name=%s", dir_name);
 		CALL_AND_CHECK(ret, fchdir(fd), ret == 0, "");
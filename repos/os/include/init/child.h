@@ -21,16 +21,19 @@
 #include <cap_session/connection.h>
 #include <base/printf.h>
 #include <base/child.h>
+#include <base/trace/events.h>
 #include <os/session_policy.h>
 
 /* init includes */
 #include <init/child_config.h>
 #include <init/child_policy.h>
+#include <init/route_table.h>
 
 namespace Init {
 
 	class Routed_service;
 	class Name_registry;
+	class Startup_turn;
 	class Child_registry;
 	class Child;
 }
@@ -157,6 +160,61 @@ namespace Init {
 	}
 
 
+	/**
+	 * Return true if the session label originates from the named child
+	 */
+	inline bool label_from_child(char const *label, char const *child_name)
+	{
+		Genode::size_t const child_name_len = Genode::strlen(child_name);
+
+		if (Genode::strcmp(child_name, label, child_name_len) != 0)
+			return false;
+
+		label += child_name_len;
+
+		return *label == 0 || Genode::strcmp(" -> ", label, 4) == 0;
+	}
+
+
+	/**
+	 * Private copy of an XML node
+	 *
+	 * Init keeps unchanged children when its configuration is updated. The
+	 * XML nodes of such children must stay valid after the original
+	 * configuration is gone.
+	 */
+	class Xml_node_copy
+	{
+		private:
+
+			Genode::size_t const _size;
+			char         * const _buf;
+
+		public:
+
+			Xml_node_copy(Genode::Xml_node node)
+			:
+				_size(node.size()),
+				_buf((char *)Genode::env()->heap()->alloc(_size))
+			{
+				Genode::memcpy(_buf, node.addr(), _size);
+			}
+
+			~Xml_node_copy() { Genode::env()->heap()->free(_buf, _size); }
+
+			Genode::Xml_node xml() const { return Genode::Xml_node(_buf, _size); }
+
+			/**
+			 * Return true if the copy has the same content as 'node'
+			 */
+			bool equals(Genode::Xml_node node) const
+			{
+				return node.size() == _size
+				    && Genode::memcmp(node.addr(), _buf, _size) == 0;
+			}
+	};
+
+
 	/**
 	 * Return true if service XML node matches service request
 	 *
@@ -249,7 +307,12 @@ class Init::Routed_service : public Genode::Service
 		struct Applicant : public Genode::Cancelable_lock,
 		                   public Genode::List<Applicant>::Element
 		{
-			Applicant() : Cancelable_lock(Genode::Lock::LOCKED) { }
+			Genode::Session_label const label;
+
+			bool canceled = false;
+
+			Applicant(Genode::Session_label const &label)
+			: Cancelable_lock(Genode::Lock::LOCKED), label(label) { }
 		};
 
 		Genode::Lock            _applicants_lock;
@@ -293,10 +356,17 @@ class Init::Routed_service : public Genode::Service
 			 */
 			_applicants_lock.lock();
 			if (!_announced) {
-				Applicant myself;
+				Applicant myself(Genode::label_from_args(args));
 				_applicants.insert(&myself);
 				_applicants_lock.unlock();
 				myself.lock();
+
+				/*
+				 * Once canceled, the service may be gone already. So we
+				 * must not access any member.
+				 */
+				if (myself.canceled)
+					throw Unavailable();
 			} else
 				_applicants_lock.unlock();
 
@@ -313,6 +383,32 @@ class Init::Routed_service : public Genode::Service
 			return cap;
 		}
 
+		/**
+		 * Cancel session requests that wait for the announcement
+		 *
+		 * \param client  name of the child whose requests are canceled,
+		 *                or 0 to cancel all requests
+		 *
+		 * The canceled requests fail with 'Unavailable'. This is needed
+		 * whenever init destructs the server or the requesting child.
+		 */
+		void cancel_applicants(char const *client = 0)
+		{
+			Genode::Lock::Guard guard(_applicants_lock);
+
+			for (Applicant *a = _applicants.first(), *next = 0; a; a = next) {
+
+				next = a->next();
+
+				if (client && !label_from_child(a->label.string(), client))
+					continue;
+
+				_applicants.remove(a);
+				a->canceled = true;
+				a->unlock();
+			}
+		}
+
 		void upgrade(Genode::Session_capability sc, const char *args)
 		{
 			try { Genode::Root_client(_root).upgrade(sc, args); }
@@ -349,6 +445,29 @@ struct Init::Name_registry
 };
 
 
+/**
+ * Hook for ordering the construction of children
+ *
+ * When init constructs several children concurrently, the children must
+ * still be named and supplied with resources in the order of their start
+ * nodes. Otherwise, the name conflicts reported and the amount of RAM
+ * quota left for the last child would depend on the thread scheduling.
+ * Each child enters its turn before it determines its name and resources,
+ * and leaves its turn once its resources are assigned. The default
+ * implementation imposes no order.
+ */
+struct Init::Startup_turn
+{
+	virtual ~Startup_turn() { }
+
+	virtual void enter() { }
+	virtual void leave() { }
+
+	struct Enter { Enter(Startup_turn &turn) { turn.enter(); } };
+	struct Leave { Leave(Startup_turn &turn) { turn.leave(); } };
+};
+
+
 class Init::Child : Genode::Child_policy
 {
 	public:
@@ -364,12 +483,39 @@ class Init::Child : Genode::Child_policy
 
 		Genode::List_element<Child> _list_element;
 
-		Genode::Xml_node _start_node;
+		Xml_node_copy const _start_node_copy;
+		Xml_node_copy const _default_route_node_copy;
+
+		Genode::Xml_node _start_node         = _start_node_copy.xml();
+		Genode::Xml_node _default_route_node = _default_route_node_copy.xml();
+
+		Genode::Xml_node _route_node() const
+		{
+			return _start_node.has_sub_node("route") ? _start_node.sub_node("route")
+			                                         : _default_route_node;
+		}
+
+		/*
+		 * Routing rules, compiled once to avoid parsing the XML route on
+		 * each session request
+		 */
+		Route_table _route_table { _route_node(), *Genode::env()->heap() };
 
-		Genode::Xml_node _default_route_node;
+		/*
+		 * Set when the child is to be removed on a configuration update
+		 */
+		bool _abandoned = false;
+
+		/*
+		 * Set once the child got started, a child kept across a
+		 * configuration update must not be activated again
+		 */
+		bool _started = false;
 
 		Name_registry &_name_registry;
 
+		Startup_turn::Enter _turn_entered;
+
 		/**
 		 * Unique child name and file name of ELF binary
 		 */
@@ -411,6 +557,20 @@ class Init::Child : Genode::Child_policy
 			}
 		} _name;
 
+		/*
+		 * Startup checkpoints taken on behalf of the child are tagged with
+		 * the child object such that a trace consumer can tell the startups
+		 * of different children apart.
+		 */
+		void _checkpoint(char const *name, char const *detail) const {
+			Genode::Trace::Checkpoint(name, detail, this); }
+
+		struct Create_checkpoint
+		{
+			Create_checkpoint(Child const &child, char const *name) {
+				child._checkpoint("create", name); }
+		} _create_checkpoint { *this, _name.unique };
+
 		struct Read_quota
 		{
 			Read_quota(Genode::Xml_node start_node,
@@ -499,6 +659,8 @@ class Init::Child : Genode::Child_policy
 			}
 		} _resources;
 
+		Startup_turn::Leave _turn_left;
+
 		Genode::Child::Initial_thread _initial_thread { _resources.cpu, _resources.pd,
 		                                                _name.unique };
 		/*
@@ -550,15 +712,18 @@ class Init::Child : Genode::Child_policy
 		      Genode::Service_registry      &parent_services,
 		      Genode::Service_registry      &child_services,
 		      Genode::Cap_session           &cap_session,
-		      Genode::Dataspace_capability   ldso_ds)
+		      Genode::Dataspace_capability   ldso_ds,
+		      Startup_turn                  &turn)
 		:
 			_list_element(this),
-			_start_node(start_node),
-			_default_route_node(default_route_node),
+			_start_node_copy(start_node),
+			_default_route_node_copy(default_route_node),
 			_name_registry(name_registry),
+			_turn_entered(turn),
 			_name(start_node, name_registry),
 			_resources(start_node, _name.unique, prio_levels,
 			           affinity_space),
+			_turn_left(turn),
 			_entrypoint(&cap_session, ENTRYPOINT_STACK_SIZE, _name.unique, false,
 			            _resources.affinity.location()),
 			_binary_rom(_name.file),
@@ -581,6 +746,8 @@ class Init::Child : Genode::Child_policy
 		{
 			using namespace Genode;
 
+			_checkpoint("loaded", _name.unique);
+
 			if (_resources.ram_quota == 0)
 				PWRN("no valid RAM resource for child \"%s\"", _name.unique);
 
@@ -590,46 +757,105 @@ class Init::Child : Genode::Child_policy
 				Genode::printf("  ELF binary: %s\n", _name.file);
 				Genode::printf("  priority:   %ld\n", _resources.priority);
 			}
+		}
+
+		virtual ~Child()
+		{
+			using namespace Genode;
 
 			/*
-			 * Determine services provided by the child
+			 * Release our entrypoint from session requests that wait for
+			 * the announcement of a service by another child. Otherwise,
+			 * the entrypoint could not be destructed.
 			 */
+			_child_services.for_each([&] (Service &s) {
+				Routed_service *rs = dynamic_cast<Routed_service *>(&s);
+				if (rs) rs->cancel_applicants(name()); });
+
+			Service *s;
+			while ((s = _child_services.find_by_server(&_server))) {
+				_child_services.remove(s);
+
+				/* let clients waiting for the service fail */
+				Routed_service *rs = dynamic_cast<Routed_service *>(s);
+				if (rs) rs->cancel_applicants();
+			}
+		}
+
+		/**
+		 * Return true if the child has the specified name
+		 */
+		bool has_name(const char *n) const { return !Genode::strcmp(name(), n); }
+
+		Genode::Server *server() { return &_server; }
+
+		/**
+		 * Return true if the child was created from the given start node
+		 */
+		bool has_start_node(Genode::Xml_node start_node) const {
+			return _start_node_copy.equals(start_node); }
+
+		/**
+		 * Return true if the routing of the child is defined by init's
+		 * default route
+		 */
+		bool uses_default_route() const {
+			return !_start_node.has_sub_node("route"); }
+
+		/**
+		 * Return true if the child has a session provided by 'server'
+		 */
+		bool uses(Child &server) {
+			return _child.has_session_to(&server._server); }
+
+		/**
+		 * Mark child to be removed on the current configuration update
+		 */
+		void abandon() { _abandoned = true; }
+
+		bool abandoned() const { return _abandoned; }
+
+		/**
+		 * Register the services declared in the '<provides>' node
+		 *
+		 * The service registry is not synchronized. Hence, the services are
+		 * not registered by the constructor, which may be executed by
+		 * concurrent startup threads, but by init's main thread.
+		 */
+		void register_services()
+		{
+			using namespace Genode;
+
 			try {
-				Xml_node service_node = start_node.sub_node("provides").sub_node("service");
+				Xml_node service_node = _start_node.sub_node("provides").sub_node("service");
 
 				for (; ; service_node = service_node.next("service")) {
 
-					char name[Genode::Service::MAX_NAME_LEN];
+					char name[Service::MAX_NAME_LEN];
 					service_node.attribute("name").value(name, sizeof(name));
 
 					if (config_verbose)
-						Genode::printf("  provides service %s\n", name);
+						printf("  provides service %s\n", name);
 
-					child_services.insert(new (_child.heap())
+					_child_services.insert(new (_child.heap())
 						Routed_service(name, &_server));
 
 				}
 			} catch (Xml_node::Nonexistent_sub_node) { }
 		}
 
-		virtual ~Child() {
-			Genode::Service *s;
-			while ((s = _child_services.find_by_server(&_server))) {
-				_child_services.remove(s);
-			}
-		}
-
 		/**
-		 * Return true if the child has the specified name
+		 * Start execution of child unless it is running already
 		 */
-		bool has_name(const char *n) const { return !Genode::strcmp(name(), n); }
-
-		Genode::Server *server() { return &_server; }
+		void start()
+		{
+			if (_started)
+				return;
 
-		/**
-		 * Start execution of child
-		 */
-		void start() { _entrypoint.activate(); }
+			_started = true;
+			_checkpoint("start", _name.unique);
+			_entrypoint.activate();
+		}
 
 
 		/****************************
@@ -643,6 +869,8 @@ class Init::Child : Genode::Child_policy
 		{
 			Genode::Service *service = 0;
 
+			_checkpoint("session", service_name);
+
 			/* check for config file request */
 			if ((service = _config_policy.resolve_session_request(service_name, args)))
 				return service;
@@ -651,80 +879,75 @@ class Init::Child : Genode::Child_policy
 			if ((service = _binary_policy.resolve_session_request(service_name, args)))
 				return service;
 
-			try {
-				Genode::Xml_node route_node = _default_route_node;
-				try {
-					route_node = _start_node.sub_node("route"); }
-				catch (...) { }
-				Genode::Xml_node service_node = route_node.sub_node();
+			Genode::Session_label const label(skip_label_prefix(
+				name(), Genode::label_from_args(args).string()));
+
+			bool resolved = false;
 
-				for (; ; service_node = service_node.next()) {
+			auto resolve = [&] (Route_table::Rule const &rule)
+			{
+				using Target = Route_table::Target;
 
-					bool service_wildcard = service_node.has_type("any-service");
+				/* a service node without targets terminates the lookup */
+				if (!rule.num_targets)
+					return true;
 
-					if (!service_node_matches(service_node, args, name(), service_name))
-						continue;
+				for (unsigned i = 0; i < rule.num_targets; i++) {
 
-					if (!service_node_args_condition_satisfied(service_node, args, name()))
-						continue;
+					Target const &target = rule.targets[i];
 
-					Genode::Xml_node target = service_node.sub_node();
-					for (; ; target = target.next()) {
+					if (target.type == Target::PARENT) {
+						service = _parent_services.find(service_name);
+						if (service)
+							return resolved = true;
 
-						if (target.has_type("parent")) {
-							service = _parent_services.find(service_name);
-							if (service)
-								return service;
+						if (!rule.any_service) {
+							PWRN("%s: service lookup for \"%s\" at parent failed", name(), service_name);
+							return resolved = true;
+						}
+					}
 
-							if (!service_wildcard) {
-								PWRN("%s: service lookup for \"%s\" at parent failed", name(), service_name);
-								return 0;
-							}
+					if (target.type == Target::CHILD) {
+						Genode::Server *server = _name_registry.lookup_server(target.server.string());
+						if (!server) {
+							PWRN("%s: invalid route to non-existing server \"%s\"", name(), target.server.string());
+							return resolved = true;
 						}
 
-						if (target.has_type("child")) {
-							char server_name[Name::MAX_NAME_LEN];
-							server_name[0] = 0;
-							target.attribute("name").value(server_name, sizeof(server_name));
-
-							Genode::Server *server = _name_registry.lookup_server(server_name);
-							if (!server) {
-								PWRN("%s: invalid route to non-existing server \"%s\"", name(), server_name);
-								return 0;
-							}
-
-							service = _child_services.find(service_name, server);
-							if (service)
-								return service;
-
-							if (!service_wildcard) {
-								PWRN("%s: lookup to child service \"%s\" failed", name(), service_name);
-								return 0;
-							}
+						service = _child_services.find(service_name, server);
+						if (service)
+							return resolved = true;
+
+						if (!rule.any_service) {
+							PWRN("%s: lookup to child service \"%s\" failed", name(), service_name);
+							return resolved = true;
 						}
+					}
 
-						if (target.has_type("any-child")) {
-							if (_child_services.is_ambiguous(service_name)) {
-								PERR("%s: ambiguous routes to service \"%s\"", name(), service_name);
-								return 0;
-							}
-							service = _child_services.find(service_name);
-							if (service)
-								return service;
-
-							if (!service_wildcard) {
-								PWRN("%s: lookup for service \"%s\" failed", name(), service_name);
-								return 0;
-							}
+					if (target.type == Target::ANY_CHILD) {
+						if (_child_services.is_ambiguous(service_name)) {
+							PERR("%s: ambiguous routes to service \"%s\"", name(), service_name);
+							return resolved = true;
 						}
+						service = _child_services.find(service_name);
+						if (service)
+							return resolved = true;
 
-						if (target.last())
-							break;
+						if (!rule.any_service) {
+							PWRN("%s: lookup for service \"%s\" failed", name(), service_name);
+							return resolved = true;
+						}
 					}
 				}
-			} catch (...) {
+				return false;
+			};
+
+			_route_table.for_each_matching_rule(service_name, label.string(),
+			                                    args, resolve);
+
+			if (!resolved)
 				PWRN("%s: no route to service \"%s\"", name(), service_name);
-			}
+
 			return service;
 		}
 
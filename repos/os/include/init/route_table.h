@@ -0,0 +1,360 @@
+/*
+ * \brief  Precompiled session routes of a child of the init process
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__INIT__ROUTE_TABLE_H_
+#define _INCLUDE__INIT__ROUTE_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/service.h>
+#include <base/session_label.h>
+#include <util/arg_string.h>
+#include <util/xml_node.h>
+
+namespace Init { class Route_table; }
+
+
+/**
+ * Route of a child compiled into a representation suited for fast lookup
+ *
+ * The '<route>' declaration of a start node, or init's '<default-route>',
+ * is translated once when the child is created. Each service node becomes
+ * a 'Rule' that holds the service name, the label and argument conditions,
+ * and the routing targets. The rules are indexed by service name. For each
+ * service name that appears in the route, the index holds the list of
+ * applicable rules, which comprises the rules for the service and all
+ * '<any-service>' rules in the order of their declaration.
+ */
+class Init::Route_table
+{
+	public:
+
+		enum { MAX_SERVER_NAME_LEN = 64, MAX_ARG_LEN = 64 };
+
+		typedef Genode::String<Genode::Service::MAX_NAME_LEN> Service_name;
+		typedef Genode::String<MAX_SERVER_NAME_LEN>           Server_name;
+		typedef Genode::String<MAX_ARG_LEN>                   Arg_value;
+		typedef Genode::String<Genode::Session_label::capacity()> Label;
+
+		struct Target
+		{
+			enum Type { INVALID, PARENT, CHILD, ANY_CHILD };
+
+			Type        type = INVALID;
+			Server_name server;
+		};
+
+		/**
+		 * Compiled service node of a route
+		 */
+		struct Rule
+		{
+			bool         any_service = false;
+			Service_name service;
+
+			bool  label_present  = false;
+			bool  prefix_present = false;
+			bool  suffix_present = false;
+			Label label, prefix, suffix;
+
+			bool      if_arg = false;
+			Arg_value if_arg_key, if_arg_value;
+
+			Target  *targets     = nullptr;
+			unsigned num_targets = 0;
+
+			/**
+			 * Return true if the rule's label conditions accept 'label'
+			 *
+			 * This check corresponds to 'Xml_node_label_score::conflict'.
+			 */
+			bool label_matches(char const *label) const
+			{
+				using Genode::strcmp;
+				using Genode::strlen;
+
+				if (label_present && strcmp(label, this->label.string()))
+					return false;
+
+				if (prefix_present) {
+					Genode::size_t const len = prefix.length() - 1;
+					if (!len || strcmp(label, prefix.string(), len))
+						return false;
+				}
+
+				if (suffix_present) {
+					Genode::size_t const label_len  = strlen(label);
+					Genode::size_t const suffix_len = suffix.length() - 1;
+
+					if (!suffix_len || label_len < suffix_len
+					 || strcmp(label + label_len - suffix_len, suffix.string()))
+						return false;
+				}
+				return true;
+			}
+
+			/**
+			 * Return true if the session arguments satisfy the '<if-arg>'
+			 * condition of the rule
+			 *
+			 * \param label  session label with the child-name prefix
+			 *               stripped
+			 *
+			 * This check corresponds to
+			 * 'service_node_args_condition_satisfied'. As the route is
+			 * specific to the child, a condition for the "label" argument
+			 * refers to the label without the child-name prefix.
+			 */
+			bool args_match(char const *args, char const *label) const
+			{
+				if (!if_arg)
+					return true;
+
+				if (!Genode::strcmp("label", if_arg_key.string()))
+					return !Genode::strcmp(if_arg_value.string(), label);
+
+				char arg_value[MAX_ARG_LEN];
+				Genode::Arg_string::find_arg(args, if_arg_key.string())
+					.string(arg_value, sizeof(arg_value), "");
+
+				return !Genode::strcmp(if_arg_value.string(), arg_value);
+			}
+		};
+
+	private:
+
+		/**
+		 * Index entry listing the rules that apply to one service name
+		 */
+		struct Service_entry
+		{
+			Service_name   name;
+			unsigned      *rules     = nullptr;  /* indices into '_rules' */
+			unsigned       num_rules = 0;
+			Service_entry *next      = nullptr;  /* next entry of bucket  */
+		};
+
+		enum { NUM_BUCKETS = 16 };
+
+		Genode::Allocator &_alloc;
+
+		Rule    *_rules     = nullptr;
+		unsigned _num_rules = 0;
+
+		/* rules applicable to services not mentioned explicitly */
+		Service_entry _any_service;
+
+		Service_entry *_buckets[NUM_BUCKETS];
+
+		static unsigned _bucket(char const *name)
+		{
+			unsigned long hash = 5381;
+			for (; *name; name++)
+				hash = hash*33 + *name;
+
+			return hash % NUM_BUCKETS;
+		}
+
+		/*
+		 * The array elements are trivially destructible. Hence, the
+		 * compiler does not prepend an array cookie and the array can be
+		 * freed by its plain size.
+		 */
+		template <typename T>
+		T *_alloc_array(unsigned num) {
+			return num ? new (&_alloc) T[num] : nullptr; }
+
+		template <typename T>
+		void _free_array(T *array, unsigned num)
+		{
+			static_assert(__has_trivial_destructor(T),
+			              "array elements must be trivially destructible");
+			if (array)
+				_alloc.free(array, num*sizeof(T));
+		}
+
+		Service_entry *_lookup(char const *name) const
+		{
+			for (Service_entry *e = _buckets[_bucket(name)]; e; e = e->next)
+				if (!Genode::strcmp(e->name.string(), name))
+					return e;
+
+			return nullptr;
+		}
+
+		static void _compile_target(Genode::Xml_node node, Target &target)
+		{
+			if (node.has_type("parent"))
+				target.type = Target::PARENT;
+
+			if (node.has_type("any-child"))
+				target.type = Target::ANY_CHILD;
+
+			if (node.has_type("child")) {
+				target.type   = Target::CHILD;
+				target.server = node.attribute_value("name", Server_name());
+			}
+		}
+
+		void _compile_rule(Genode::Xml_node node, Rule &rule)
+		{
+			rule.any_service = node.has_type("any-service");
+			rule.service     = node.attribute_value("name", Service_name());
+
+			rule.label_present  = node.has_attribute("label");
+			rule.prefix_present = node.has_attribute("label_prefix");
+			rule.suffix_present = node.has_attribute("label_suffix");
+			rule.label  = node.attribute_value("label",        Label());
+			rule.prefix = node.attribute_value("label_prefix", Label());
+			rule.suffix = node.attribute_value("label_suffix", Label());
+
+			try {
+				Genode::Xml_node if_arg = node.sub_node("if-arg");
+				rule.if_arg       = true;
+				rule.if_arg_key   = if_arg.attribute_value("key",   Arg_value());
+				rule.if_arg_value = if_arg.attribute_value("value", Arg_value());
+			} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
+			node.for_each_sub_node([&] (Genode::Xml_node) { rule.num_targets++; });
+
+			rule.targets = _alloc_array<Target>(rule.num_targets);
+
+			unsigned i = 0;
+			node.for_each_sub_node([&] (Genode::Xml_node target) {
+				_compile_target(target, rule.targets[i++]); });
+		}
+
+		/**
+		 * Collect the rules that apply to the service of 'entry'
+		 */
+		void _index(Service_entry &entry, bool any_service_only)
+		{
+			auto applies = [&] (Rule const &rule) {
+				return rule.any_service
+				    || (!any_service_only && rule.service == entry.name); };
+
+			for (unsigned i = 0; i < _num_rules; i++)
+				if (applies(_rules[i]))
+					entry.num_rules++;
+
+			entry.rules = _alloc_array<unsigned>(entry.num_rules);
+
+			for (unsigned i = 0, j = 0; i < _num_rules; i++)
+				if (applies(_rules[i]))
+					entry.rules[j++] = i;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param route  '<route>' or '<default-route>' node
+		 * \param alloc  allocator for the compiled route
+		 */
+		Route_table(Genode::Xml_node route, Genode::Allocator &alloc)
+		:
+			_alloc(alloc)
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				_buckets[i] = nullptr;
+
+			route.for_each_sub_node([&] (Genode::Xml_node) { _num_rules++; });
+
+			_rules = _alloc_array<Rule>(_num_rules);
+
+			unsigned i = 0;
+			route.for_each_sub_node([&] (Genode::Xml_node node) {
+				_compile_rule(node, _rules[i++]); });
+
+			/* create one index entry per distinct service name */
+			for (unsigned i = 0; i < _num_rules; i++) {
+
+				Rule const &rule = _rules[i];
+
+				if (rule.any_service || _lookup(rule.service.string()))
+					continue;
+
+				Service_entry *entry = new (&_alloc) Service_entry;
+				entry->name = rule.service;
+				_index(*entry, false);
+
+				unsigned const bucket = _bucket(entry->name.string());
+				entry->next       = _buckets[bucket];
+				_buckets[bucket]  = entry;
+			}
+
+			_index(_any_service, true);
+		}
+
+		~Route_table()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+				while (Service_entry *entry = _buckets[i]) {
+					_buckets[i] = entry->next;
+					_free_array(entry->rules, entry->num_rules);
+					Genode::destroy(&_alloc, entry);
+				}
+			}
+
+			_free_array(_any_service.rules, _any_service.num_rules);
+
+			for (unsigned i = 0; i < _num_rules; i++)
+				_free_array(_rules[i].targets, _rules[i].num_targets);
+
+			_free_array(_rules, _num_rules);
+		}
+
+		/**
+		 * Apply functor to each rule that matches the session request
+		 *
+		 * \param service_name  name of the requested service
+		 * \param label         session label with the child-name prefix
+		 *                      stripped
+		 * \param args          session arguments as filtered by the
+		 *                      child policy
+		 *
+		 * The rules are visited in the order of their declaration. The
+		 * functor takes a 'Rule const &' as argument and returns true to
+		 * stop the iteration.
+		 *
+		 * \return  true if the iteration was stopped by the functor
+		 */
+		template <typename FUNC>
+		bool for_each_matching_rule(char const *service_name, char const *label,
+		                            char const *args, FUNC const &fn) const
+		{
+			Service_entry const *entry = _lookup(service_name);
+			if (!entry)
+				entry = &_any_service;
+
+			for (unsigned i = 0; i < entry->num_rules; i++) {
+
+				Rule const &rule = _rules[entry->rules[i]];
+
+				if (!rule.label_matches(label))
+					continue;
+
+				if (!rule.args_match(args, label))
+					continue;
+
+				if (fn(rule))
+					return true;
+			}
+			return false;
+		}
+
+};
+
+
+#endif /* _INCLUDE__INIT__ROUTE_TABLE_H_ */
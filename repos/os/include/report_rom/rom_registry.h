@@ -38,6 +38,16 @@ struct Rom::Registry_for_reader
 	                                Module::Name const &rom_label) = 0;
 
 	virtual void release(Reader &reader, Readable_module &module) = 0;
+
+	/**
+	 * Return minimum interval between two update notifications of a
+	 * reader in milliseconds
+	 *
+	 * Updates occurring within the interval are coalesced into one
+	 * notification. A value of 0 disables the rate limiting.
+	 */
+	virtual unsigned long min_interval_ms(Module::Name const &rom_label) {
+		return 0; }
 };
 
 
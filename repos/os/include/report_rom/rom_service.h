@@ -20,6 +20,8 @@
 #include <rom_session/rom_session.h>
 #include <root/component.h>
 #include <report_rom/rom_registry.h>
+#include <report_rom/update_scheduler.h>
+#include <base/log.h>
 
 namespace Rom {
 	class Session_component;
@@ -31,7 +33,7 @@ namespace Rom {
 
 
 class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
-                               public Reader
+                               public Reader, public Notification_stats
 {
 	private:
 
@@ -61,26 +63,139 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Genode::Signal_context_capability _sigh;
 
-		void _notify_client()
+		void _submit_signal()
 		{
 			if (_sigh.valid())
 				Genode::Signal_transmitter(_sigh).submit();
 		}
 
+		/*
+		 * Rate limiting of update notifications
+		 *
+		 * A notification that occurs within the minimum interval after the
+		 * previous one is deferred until the end of the interval. Further
+		 * notifications until then are coalesced with the deferred one.
+		 * Because the client obtains the content not before it handles the
+		 * signal, it always gets the most recent content.
+		 */
+
+		Update_scheduler *const _scheduler;
+
+		unsigned long const _min_interval_ms;
+
+		struct Deferred_notification : Genode::Alarm
+		{
+			Session_component &session;
+
+			Deferred_notification(Session_component &session)
+			: session(session) { }
+
+			bool on_alarm(unsigned) override
+			{
+				session._deliver_deferred_notification();
+				return false;
+			}
+		} _deferred_notification { *this };
+
+		bool          _deferred          = false;
+		unsigned long _last_delivered_ms = 0;
+		unsigned long _num_delivered     = 0;
+		unsigned long _num_coalesced     = 0;
+
+		void _deliver(unsigned long now_ms)
+		{
+			_last_delivered_ms = now_ms;
+			_num_delivered++;
+			_submit_signal();
+			_scheduler->stats_changed();
+		}
+
+		void _deliver_deferred_notification()
+		{
+			_deferred = false;
+			_deliver(_scheduler->now_ms());
+		}
+
+		void _notify_client()
+		{
+			if (!_min_interval_ms) {
+				_submit_signal();
+				return;
+			}
+
+			if (_deferred) {
+				_num_coalesced++;
+				return;
+			}
+
+			unsigned long const now_ms = _scheduler->now_ms();
+
+			if (_num_delivered && now_ms - _last_delivered_ms < _min_interval_ms) {
+				_deferred = true;
+				_scheduler->schedule(_deferred_notification,
+				                     _last_delivered_ms + _min_interval_ms);
+				return;
+			}
+
+			_deliver(now_ms);
+		}
+
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param scheduler  scheduler used for rate limiting update
+		 *                   notifications, or nullptr to deliver each
+		 *                   notification immediately
+		 */
 		Session_component(Registry_for_reader &registry,
-		                  Genode::Session_label const &label)
+		                  Genode::Session_label const &label,
+		                  Update_scheduler *scheduler = nullptr)
 		:
-			_registry(registry), _label(label), _module(_init_module(label))
-		{ }
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_scheduler(scheduler),
+			_min_interval_ms(scheduler ? registry.min_interval_ms(label.string()) : 0)
+		{
+			if (_min_interval_ms)
+				_scheduler->add(*this);
+		}
 
 		~Session_component()
 		{
+			if (_deferred)
+				_scheduler->discard(_deferred_notification);
+
+			if (_min_interval_ms)
+				_scheduler->remove(*this);
+
+			if (_min_interval_ms && _scheduler->verbose())
+				Genode::log("ROM session '", _label.string(), "': ",
+				            _num_delivered, " notifications delivered, ",
+				            _num_coalesced, " coalesced");
+
 			_registry.release(*this, _module);
 		}
 
-		Genode::Session_label label() const { return _label; }
+		/**
+		 * Notification_stats interface
+		 */
+		Genode::Session_label label() const override { return _label; }
+
+		/**
+		 * Notification_stats interface
+		 */
+		unsigned long min_interval_ms() const override { return _min_interval_ms; }
+
+		/**
+		 * Notification_stats interface
+		 */
+		unsigned long num_delivered() const override { return _num_delivered; }
+
+		/**
+		 * Notification_stats interface
+		 */
+		unsigned long num_coalesced() const override { return _num_coalesced; }
 
 		Genode::Rom_dataspace_capability dataspace() override
 		{
@@ -130,7 +245,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 			 * Otherwise, a server-side ROM update between session creation and
 			 * signal-handler registration would go unnoticed.
 			 */
-			_notify_client();
+			_submit_signal();
 		}
 
 		/**
@@ -162,6 +277,8 @@ class Rom::Root : public Genode::Root_component<Session_component>
 
 		Registry_for_reader &_registry;
 
+		Update_scheduler *const _scheduler;
+
 	protected:
 
 		Session_component *_create_session(const char *args) override
@@ -169,17 +286,24 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_registry, label_from_args(args));
+				Session_component(_registry, label_from_args(args), _scheduler);
 		}
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param scheduler  scheduler for rate-limited sessions, or nullptr
+		 *                   if rate limiting is not supported
+		 */
 		Root(Genode::Env          &env,
 		     Genode::Allocator    &md_alloc,
-		     Registry_for_reader  &registry)
+		     Registry_for_reader  &registry,
+		     Update_scheduler     *scheduler = nullptr)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_registry(registry)
+			_registry(registry), _scheduler(scheduler)
 		{ }
 };
 
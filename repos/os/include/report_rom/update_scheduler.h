@@ -0,0 +1,182 @@
+/*
+ * \brief  Scheduler for deferred ROM-update notifications
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__REPORT_ROM__UPDATE_SCHEDULER_H_
+#define _INCLUDE__REPORT_ROM__UPDATE_SCHEDULER_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/signal.h>
+#include <base/log.h>
+#include <os/alarm.h>
+#include <os/reporter.h>
+#include <os/session_policy.h>
+#include <timer_session/connection.h>
+#include <util/volatile_object.h>
+
+namespace Rom {
+	class Notification_stats;
+	class Update_scheduler;
+}
+
+
+/**
+ * Statistics of the update notifications of a rate-limited ROM session
+ */
+struct Rom::Notification_stats : Genode::List<Notification_stats>::Element
+{
+	virtual Genode::Session_label label() const = 0;
+
+	virtual unsigned long min_interval_ms() const = 0;
+
+	/**
+	 * Return number of delivered update notifications
+	 */
+	virtual unsigned long num_delivered() const = 0;
+
+	/**
+	 * Return number of update notifications coalesced with a deferred one
+	 */
+	virtual unsigned long num_coalesced() const = 0;
+};
+
+
+/**
+ * Time source and alarm queue for rate-limited ROM sessions
+ *
+ * The timer session is opened not before the first rate-limited session
+ * asks for the time. So the ROM service does not depend on a timer
+ * service unless rate limiting is configured.
+ *
+ * If enabled, the notification statistics of all rate-limited sessions are
+ * reported as "notifications" report whenever a session delivers a
+ * notification, is opened, or is closed.
+ */
+class Rom::Update_scheduler
+{
+	private:
+
+		Genode::Env &_env;
+
+		Genode::Lazy_volatile_object<Timer::Connection> _timer;
+
+		Genode::Alarm_scheduler _alarms;
+
+		Genode::Signal_handler<Update_scheduler> _timeout_handler {
+			_env.ep(), *this, &Update_scheduler::_handle_timeout };
+
+		bool const &_verbose;
+
+		Genode::List<Notification_stats> _sessions;
+
+		Genode::Reporter _reporter { "notifications" };
+
+		void _report()
+		{
+			if (!_reporter.enabled())
+				return;
+
+			try {
+				Genode::Reporter::Xml_generator xml(_reporter, [&] () {
+					for (Notification_stats const *s = _sessions.first(); s; s = s->next()) {
+						xml.node("session", [&] () {
+							xml.attribute("label",           s->label().string());
+							xml.attribute("min_interval_ms", s->min_interval_ms());
+							xml.attribute("delivered",       s->num_delivered());
+							xml.attribute("coalesced",       s->num_coalesced());
+						});
+					}
+				});
+			} catch (Genode::Xml_generator::Buffer_exceeded) {
+				Genode::warning("notification statistics exceed report buffer"); }
+		}
+
+		Timer::Connection &_timer_connection()
+		{
+			if (!_timer.constructed()) {
+				_timer.construct(_env);
+				_timer->sigh(_timeout_handler);
+			}
+			return *_timer;
+		}
+
+		void _trigger_next_timeout()
+		{
+			Genode::Alarm::Time deadline = 0;
+			if (!_alarms.next_deadline(&deadline))
+				return;
+
+			/* an alarm becomes pending once the deadline has passed */
+			long const remaining_ms = (long)(deadline - now_ms()) + 1;
+
+			_timer_connection().trigger_once(Genode::max(remaining_ms, 1L)*1000);
+		}
+
+		void _handle_timeout()
+		{
+			_alarms.handle(now_ms());
+			_trigger_next_timeout();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param verbose  log statistics of rate-limited sessions
+		 * \param report   report statistics of rate-limited sessions
+		 */
+		Update_scheduler(Genode::Env &env, bool const &verbose, bool report = false)
+		: _env(env), _verbose(verbose)
+		{
+			_reporter.enabled(report);
+			_report();
+		}
+
+		unsigned long now_ms() { return _timer_connection().elapsed_ms(); }
+
+		/**
+		 * Schedule alarm at the absolute point in time 'deadline_ms'
+		 */
+		void schedule(Genode::Alarm &alarm, unsigned long deadline_ms)
+		{
+			_alarms.schedule_absolute(&alarm, deadline_ms);
+			_trigger_next_timeout();
+		}
+
+		void discard(Genode::Alarm &alarm) { _alarms.discard(&alarm); }
+
+		bool verbose() const { return _verbose; }
+
+		/**
+		 * Register rate-limited session for the notification statistics
+		 */
+		void add(Notification_stats &session)
+		{
+			_sessions.insert(&session);
+			_report();
+		}
+
+		void remove(Notification_stats &session)
+		{
+			_sessions.remove(&session);
+			_report();
+		}
+
+		/**
+		 * Update the report after the statistics of a session changed
+		 */
+		void stats_changed() { _report(); }
+};
+
+#endif /* _INCLUDE__REPORT_ROM__UPDATE_SCHEDULER_H_ */
@@ -38,13 +38,45 @@ struct Trace_subject_registry
 			 */
 			unsigned long long recent_execution_time = 0;
 
+			/**
+			 * Trace-buffer events produced and lost during the last period
+			 */
+			Genode::Trace::Buffer_stats recent_buffer_stats;
+
+			/**
+			 * Wait time and context switches during the last period
+			 */
+			Genode::Trace::Scheduling_stats recent_scheduling_stats;
+
 			Entry(Genode::Trace::Subject_id id) : id(id) { }
 
+			/**
+			 * Return increase of a counter since the last period
+			 *
+			 * A counter that decreased has been reset, e.g., because the
+			 * trace buffer was re-initialized or the subject got replaced.
+			 * The increase is unknown then and reported as zero.
+			 */
+			template <typename T>
+			static T _delta(T now, T last) { return now > last ? now - last : 0; }
+
 			void update(Genode::Trace::Subject_info const &new_info)
 			{
 				unsigned long long const last_execution_time = info.execution_time().value;
+				Genode::Trace::Buffer_stats const last_buffer_stats = info.buffer_stats();
+				Genode::Trace::Scheduling_stats const last_scheduling_stats = info.scheduling_stats();
 				info = new_info;
-				recent_execution_time = info.execution_time().value - last_execution_time;
+				recent_execution_time = _delta(info.execution_time().value, last_execution_time);
+				recent_buffer_stats = Genode::Trace::Buffer_stats(
+					_delta(info.buffer_stats().produced, last_buffer_stats.produced),
+					_delta(info.buffer_stats().lost,     last_buffer_stats.lost));
+
+				Genode::Trace::Scheduling_stats const stats = info.scheduling_stats();
+				recent_scheduling_stats = Genode::Trace::Scheduling_stats(
+					_delta(stats.wait_time,            last_scheduling_stats.wait_time),
+					_delta(stats.voluntary_switches,   last_scheduling_stats.voluntary_switches),
+					_delta(stats.involuntary_switches, last_scheduling_stats.involuntary_switches),
+					stats.last_cpu);
 			}
 		};
 
@@ -113,8 +145,9 @@ struct Trace_subject_registry
 			_sort_by_recent_execution_time();
 		}
 
-		void report(Genode::Xml_generator &xml,
-		            bool report_affinity, bool report_activity)
+		void report(Genode::Xml_generator &xml, bool report_affinity,
+		            bool report_activity, bool report_buffer,
+		            bool report_scheduling)
 		{
 			for (Entry const *e = _entries.first(); e; e = e->next()) {
 				xml.node("subject", [&] () {
@@ -137,6 +170,31 @@ struct Trace_subject_registry
 							xml.attribute("xpos", e->info.affinity().xpos());
 							xml.attribute("ypos", e->info.affinity().ypos());
 						});
+
+					if (report_scheduling)
+						xml.node("scheduling", [&] () {
+							Genode::Trace::Scheduling_stats const &total  = e->info.scheduling_stats();
+							Genode::Trace::Scheduling_stats const &recent = e->recent_scheduling_stats;
+							xml.attribute("last_cpu", total.last_cpu);
+							xml.attribute("wait_time", total.wait_time);
+							xml.attribute("recent_wait_time", recent.wait_time);
+							xml.attribute("voluntary_switches", total.voluntary_switches);
+							xml.attribute("recent_voluntary_switches", recent.voluntary_switches);
+							xml.attribute("involuntary_switches", total.involuntary_switches);
+							xml.attribute("recent_involuntary_switches", recent.involuntary_switches);
+						});
+
+					/* event statistics are present for traced subjects only */
+					bool const traced = state == Subject_info::TRACED
+					                 || state == Subject_info::FOREIGN;
+					if (report_buffer && traced)
+						xml.node("buffer", [&] () {
+							Genode::Trace::Buffer_stats const stats = e->info.buffer_stats();
+							xml.attribute("produced", stats.produced);
+							xml.attribute("lost", stats.lost);
+							xml.attribute("recent_produced", e->recent_buffer_stats.produced);
+							xml.attribute("recent_lost", e->recent_buffer_stats.lost);
+						});
 				});
 			}
 		}
@@ -157,6 +215,8 @@ struct Server::Main
 
 	bool report_affinity = false;
 	bool report_activity = false;
+	bool report_buffer   = false;
+	bool report_scheduling = false;
 
 	bool config_report_attribute_enabled(char const *attr) const
 	{
@@ -203,9 +263,12 @@ void Server::Main::handle_config(unsigned)
 
 	report_affinity = config_report_attribute_enabled("affinity");
 	report_activity = config_report_attribute_enabled("activity");
+	report_buffer   = config_report_attribute_enabled("buffer");
+	report_scheduling = config_report_attribute_enabled("scheduling");
 
-	PINF("period_ms=%ld, report_activity=%d, report_affinity=%d",
-	     period_ms, report_activity, report_affinity);
+	PINF("period_ms=%ld, report_activity=%d, report_affinity=%d, report_buffer=%d, "
+	     "report_scheduling=%d", period_ms, report_activity, report_affinity,
+	     report_buffer, report_scheduling);
 
 	timer.trigger_periodic(1000*period_ms);
 }
@@ -220,7 +283,8 @@ void Server::Main::handle_period(unsigned)
 	reporter.clear();
 	Genode::Reporter::Xml_generator xml(reporter, [&] ()
 	{
-		trace_subject_registry.report(xml, report_affinity, report_activity);
+		trace_subject_registry.report(xml, report_affinity, report_activity,
+		                              report_buffer, report_scheduling);
 	});
 }
 
@@ -39,14 +39,18 @@ struct Expanding_region_map_client : Genode::Region_map_client
 	                          Genode::size_t size, Genode::off_t offset,
 	                          bool use_local_addr,
 	                          Local_addr local_addr,
-	                          bool executable) override
+	                          bool executable,
+	                          bool copy_on_write,
+	                          bool populate) override
 	{
 		return Genode::retry<Genode::Region_map::Out_of_metadata>(
 			[&] () {
 				return Region_map_client::attach(ds, size, offset,
 				                                 use_local_addr,
 				                                 local_addr,
-				                                 executable); },
+				                                 executable,
+				                                 copy_on_write,
+				                                 populate); },
 			[&] () {
 				enum { UPGRADE_QUOTA = 4096 };
 
@@ -13,7 +13,11 @@
 
 #include <init/child.h>
 #include <base/sleep.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
 #include <os/config.h>
+#include <util/volatile_object.h>
+#include <util/xml_index.h>
 
 
 namespace Init { bool config_verbose = false; }
@@ -88,6 +92,101 @@ inline void determine_parent_services(Genode::Service_registry *services)
 }
 
 
+/**
+ * Return sub node of config, or an empty node if not present
+ */
+inline Genode::Xml_node config_sub_node(char const *type)
+{
+	try { return Genode::config()->xml_node().sub_node(type); }
+	catch (...) { return Genode::Xml_node("<empty/>"); }
+}
+
+
+/*******************
+ ** Global config **
+ *******************/
+
+namespace Init { struct Global_config; }
+
+
+/**
+ * Parts of the configuration that concern all children
+ *
+ * On a config update, init compares the new configuration against the
+ * global parts of the previous one. If they differ, the whole scenario is
+ * restarted. Otherwise, only the children affected by the update are.
+ */
+struct Init::Global_config
+{
+	long const              prio_levels    = read_prio_levels();
+	Genode::Affinity::Space affinity_space = read_affinity_space();
+
+	Xml_node_copy const parent_provides { config_sub_node("parent-provides") };
+	Xml_node_copy const default_route   { config_sub_node("default-route") };
+
+	/*
+	 * The alias declarations are kept as one buffer containing all
+	 * '<alias>' nodes one after another
+	 */
+	Genode::size_t const aliases_size = _aliases(nullptr);
+	char         * const aliases =
+		aliases_size ? (char *)Genode::env()->heap()->alloc(aliases_size) : nullptr;
+
+	/**
+	 * Concatenate alias nodes into buffer 'dst' if not 0
+	 *
+	 * \return size of concatenated alias nodes
+	 */
+	static Genode::size_t _aliases(char *dst)
+	{
+		Genode::size_t size = 0;
+		Genode::config()->xml_node().for_each_sub_node("alias",
+			[&] (Genode::Xml_node alias) {
+				if (dst)
+					Genode::memcpy(dst + size, alias.addr(), alias.size());
+				size += alias.size(); });
+
+		return size;
+	}
+
+	Global_config() { _aliases(aliases); }
+
+	~Global_config()
+	{
+		if (aliases)
+			Genode::env()->heap()->free(aliases, aliases_size);
+	}
+
+	/**
+	 * Return true if the current config has the same global parts
+	 *
+	 * The default route is not considered because a change of the
+	 * default route affects only the children that use it.
+	 */
+	bool unchanged() const
+	{
+		Genode::Affinity::Space const space = read_affinity_space();
+
+		if (prio_levels != read_prio_levels()
+		 || affinity_space.width()  != space.width()
+		 || affinity_space.height() != space.height()
+		 || !parent_provides.equals(config_sub_node("parent-provides"))
+		 || aliases_size != _aliases(nullptr))
+			return false;
+
+		if (!aliases_size)
+			return true;
+
+		char *buf = (char *)Genode::env()->heap()->alloc(aliases_size);
+		_aliases(buf);
+		bool const equal = Genode::memcmp(buf, aliases, aliases_size) == 0;
+		Genode::env()->heap()->free(buf, aliases_size);
+
+		return equal;
+	}
+};
+
+
 /********************
  ** Child registry **
  ********************/
@@ -206,7 +305,31 @@ class Init::Child_registry : public Name_registry, Child_list
 		}
 
 		/**
-		 * Start execution of all children
+		 * Return true if a child with the specified name exists
+		 */
+		bool has_child(char const *name) const
+		{
+			Genode::List_element<Child> const *curr = first();
+			for (; curr; curr = curr->next())
+				if (curr->object()->has_name(name))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Apply functor to each child
+		 */
+		template <typename FUNC>
+		void for_each_child(FUNC const &fn)
+		{
+			Genode::List_element<Child> *curr = first();
+			for (; curr; curr = curr->next())
+				fn(*curr->object());
+		}
+
+		/**
+		 * Start execution of all children that are not running yet
 		 */
 		void start()
 		{
@@ -223,6 +346,19 @@ class Init::Child_registry : public Name_registry, Child_list
 			return first() ? first()->object() : 0;
 		}
 
+		/**
+		 * Return any abandoned child, or 0 if no such child exists
+		 */
+		Child *any_abandoned()
+		{
+			Genode::List_element<Child> *curr = first();
+			for (; curr; curr = curr->next())
+				if (curr->object()->abandoned())
+					return curr->object();
+
+			return 0;
+		}
+
 		/**
 		 * Return any of the registered aliases, or 0 if no alias exists
 		 */
@@ -281,6 +417,364 @@ class Init::Child_registry : public Name_registry, Child_list
 };
 
 
+/**
+ * Destruct child and revoke the sessions it provided to other children
+ */
+static void destroy_child(Init::Child_registry &children, Init::Child *child)
+{
+	using namespace Genode;
+
+	children.remove(child);
+	Genode::Server const *server = child->server();
+	destroy(env()->heap(), child);
+
+	/*
+	 * The killed child may have provided services to other children.
+	 * Since the server is dead by now, we cannot close its sessions
+	 * in the cooperative way. Instead, we need to instruct each
+	 * other child to forget about session associated with the dead
+	 * server. Note that the 'child' pointer points a a no-more
+	 * existing object. It is only used to identify the corresponding
+	 * session. It must never by de-referenced!
+	 */
+	children.revoke_server(server);
+}
+
+
+/**
+ * Mark the children affected by a config update as abandoned
+ *
+ * A child is affected if its start node vanished or changed, or if it
+ * depends on a changed default route. The clients of an affected child
+ * are affected too because their sessions to the child become invalid.
+ */
+static void abandon_outdated_children(Init::Child_registry &children,
+                                      bool default_route_changed)
+{
+	using namespace Genode;
+
+	/*
+	 * The start nodes are visited once per child. Index the config to
+	 * avoid scanning the whole text each time.
+	 */
+	Lazy_volatile_object<Xml_index> index;
+	try { index.construct(*env()->heap(), config()->xml_node()); }
+	catch (Xml_node::Invalid_syntax) { }
+
+	Xml_node config_node = index.constructed() ? index->xml()
+	                                           : config()->xml_node();
+
+	children.for_each_child([&] (Init::Child &child) {
+
+		bool start_node_unchanged = false;
+		config_node.for_each_sub_node("start", [&] (Xml_node start_node) {
+			if (child.has_start_node(start_node))
+				start_node_unchanged = true; });
+
+		if (start_node_unchanged
+		 && !(default_route_changed && child.uses_default_route()))
+			return;
+
+		if (Init::config_verbose)
+			printf("child \"%s\" is affected by config update\n", child.name());
+
+		child.abandon();
+	});
+
+	for (bool progress = true; progress; ) {
+
+		progress = false;
+
+		children.for_each_child([&] (Init::Child &client) {
+
+			if (client.abandoned())
+				return;
+
+			children.for_each_child([&] (Init::Child &server) {
+
+				if (client.abandoned() || !server.abandoned() || !client.uses(server))
+					return;
+
+				if (Init::config_verbose)
+					printf("child \"%s\" is affected as client of \"%s\"\n",
+					       client.name(), server.name());
+
+				client.abandon();
+				progress = true;
+			});
+		});
+	}
+}
+
+
+/*******************
+ ** Child startup **
+ *******************/
+
+namespace Init { class Child_startup; }
+
+
+/**
+ * Construction of the children of one config by a pool of threads
+ *
+ * Loading the ELF binary and populating the address space of a child are
+ * independent from other children. So the start nodes are handed out to a
+ * few threads that construct the children concurrently. Each child takes
+ * its 'Startup_turn' while it is named and supplied with resources, which
+ * keeps the outcome of these steps independent from the thread scheduling.
+ *
+ * The constructed children are registered and started not before all of
+ * them exist, in the order of their start nodes. Hence, session requests
+ * and service announcements are processed in the same state as with the
+ * sequential construction.
+ */
+class Init::Child_startup
+{
+	public:
+
+		enum { MAX_THREADS = 8, DEFAULT_THREADS = 4,
+		       STACK_SIZE  = 8*1024*sizeof(long) };
+
+		typedef Genode::String<Genode::Service::MAX_NAME_LEN> Name;
+
+	private:
+
+		struct Job : Startup_turn
+		{
+			Genode::Xml_node const start_node;
+			Name             const name;
+
+			Job *successor = nullptr;
+
+			/* unblocked as soon as the predecessor has left its turn */
+			Genode::Semaphore turn;
+
+			bool entered = false, left = false;
+
+			Init::Child *child = nullptr;
+
+			/* the name of the child collides with a registered name */
+			bool name_not_unique = false;
+
+			Job(Genode::Xml_node start_node, Name const &name, bool first)
+			: start_node(start_node), name(name), turn(first ? 1 : 0) { }
+
+			void enter() override
+			{
+				if (entered) return;
+				turn.down();
+				entered = true;
+			}
+
+			void leave() override
+			{
+				if (left) return;
+				left = true;
+				if (successor)
+					successor->turn.up();
+			}
+		};
+
+		struct Worker : Genode::Thread
+		{
+			Child_startup &startup;
+
+			Worker(Child_startup &startup, Genode::Affinity::Location location)
+			:
+				Thread(Weight::DEFAULT_WEIGHT, "startup", STACK_SIZE,
+				       Type::NORMAL, location),
+				startup(startup)
+			{ }
+
+			void entry() override
+			{
+				while (Job *job = startup._next_job())
+					startup._construct(*job);
+			}
+		};
+
+		Genode::Xml_node              _default_route_node;
+		Name_registry                &_name_registry;
+		Global_config const          &_global_config;
+		Genode::Service_registry     &_parent_services;
+		Genode::Service_registry     &_child_services;
+		Genode::Cap_session          &_cap;
+		Genode::Dataspace_capability  _ldso_ds;
+
+		/* jobs in the order of the start nodes */
+		Job *_first = nullptr;
+		Job *_last  = nullptr;
+
+		Genode::Lock _lock;
+		Job         *_unassigned = nullptr;
+
+		Job *_next_job()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Job *job = _unassigned;
+			if (job)
+				_unassigned = job->successor;
+
+			return job;
+		}
+
+		void _construct(Job &job)
+		{
+			using namespace Genode;
+
+			try {
+				job.child = new (env()->heap())
+					Init::Child(job.start_node, _default_route_node,
+					            _name_registry, _global_config.prio_levels,
+					            _global_config.affinity_space,
+					            _parent_services, _child_services, _cap,
+					            _ldso_ds, job);
+			}
+			catch (Init::Child::Child_name_is_not_unique) {
+				/* reported by the 'Init::Child' constructor */
+				job.name_not_unique = true;
+			}
+			catch (Xml_node::Nonexistent_attribute) {
+				/* missing name, reported by the 'Init::Child' constructor */
+			}
+			catch (Rom_connection::Rom_connection_failed) {
+				/*
+				 * The binary does not exist. An error message is printed
+				 * by the Rom_connection constructor.
+				 */
+			}
+			catch (Genode::Child::Process_startup_failed) {
+				PERR("failed to create child \"%s\"", job.name.string()); }
+
+			/* let the successor proceed if the construction failed early */
+			job.enter();
+			job.leave();
+		}
+
+	public:
+
+		Child_startup(Genode::Xml_node              default_route_node,
+		              Name_registry                &name_registry,
+		              Global_config const          &global_config,
+		              Genode::Service_registry     &parent_services,
+		              Genode::Service_registry     &child_services,
+		              Genode::Cap_session          &cap,
+		              Genode::Dataspace_capability  ldso_ds)
+		:
+			_default_route_node(default_route_node),
+			_name_registry(name_registry), _global_config(global_config),
+			_parent_services(parent_services), _child_services(child_services),
+			_cap(cap), _ldso_ds(ldso_ds)
+		{ }
+
+		~Child_startup()
+		{
+			while (Job *job = _first) {
+				_first = job->successor;
+				destroy(Genode::env()->heap(), job);
+			}
+		}
+
+		/**
+		 * Schedule the construction of a child for the given start node
+		 */
+		void add(Genode::Xml_node start_node, Name const &name)
+		{
+			Job *job = new (Genode::env()->heap()) Job(start_node, name, !_first);
+
+			if (_last)
+				_last->successor = job;
+			else
+				_first = job;
+
+			_last = job;
+		}
+
+		/**
+		 * Return true if a child with the given name is scheduled
+		 */
+		bool scheduled(Name const &name) const
+		{
+			for (Job const *job = _first; job; job = job->successor)
+				if (job->name == name)
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Construct all scheduled children using up to 'num_threads' threads
+		 *
+		 * \param fn  functor called with each successfully constructed
+		 *            child as argument, in the order of the start nodes
+		 *
+		 * \throw Init::Child::Child_name_is_not_unique
+		 *
+		 * As with the sequential construction, the startup stops at a child
+		 * with a conflicting name. The children of the preceding start nodes
+		 * are handed to 'fn' before the exception is thrown. The children of
+		 * the subsequent start nodes are destroyed without being handed to
+		 * 'fn'.
+		 */
+		template <typename FUNC>
+		void construct(unsigned num_threads, FUNC const &fn)
+		{
+			using namespace Genode;
+
+			_unassigned = _first;
+
+			unsigned num_jobs = 0;
+			for (Job *job = _first; job; job = job->successor)
+				num_jobs++;
+
+			num_threads = min(min(num_threads, num_jobs), (unsigned)MAX_THREADS);
+
+			if (num_threads > 1) {
+
+				Affinity::Space space = env()->cpu_session()->affinity_space();
+
+				Worker *workers[MAX_THREADS];
+				for (unsigned i = 0; i < num_threads; i++) {
+					workers[i] = new (env()->heap())
+						Worker(*this, space.location_of_index(i % space.total()));
+					workers[i]->start();
+				}
+
+				for (unsigned i = 0; i < num_threads; i++) {
+					workers[i]->join();
+					destroy(env()->heap(), workers[i]);
+				}
+
+			} else {
+
+				while (Job *job = _next_job())
+					_construct(*job);
+			}
+
+			bool name_conflict = false;
+			for (Job *job = _first; job; job = job->successor) {
+
+				name_conflict |= job->name_not_unique;
+
+				if (!job->child)
+					continue;
+
+				if (name_conflict) {
+					destroy(env()->heap(), job->child);
+					job->child = nullptr;
+					continue;
+				}
+
+				fn(*job->child);
+			}
+
+			if (name_conflict)
+				throw Init::Child::Child_name_is_not_unique();
+		}
+};
+
+
 int main(int, char **)
 {
 	using namespace Init;
@@ -308,20 +802,24 @@ int main(int, char **)
 	/* prevent init to block for resource upgrades (never satisfied by core) */
 	env()->parent()->resource_avail_sigh(sig_rec.manage(&sig_ctx_res_avail));
 
+	/* global parts of the config the current children were created from */
+	Lazy_volatile_object<Global_config> global_config;
+
 	for (;;) {
 
 		config_verbose =
 			config()->xml_node().attribute_value("verbose", false);
 
-		try { determine_parent_services(&parent_services); }
-		catch (...) { }
+		/* parent services are retained unless the whole scenario restarts */
+		if (!global_config.constructed()) {
+			try { determine_parent_services(&parent_services); }
+			catch (...) { }
+		}
+
+		global_config.construct();
 
 		/* determine default route for resolving service requests */
-		Xml_node default_route_node("<empty/>");
-		try {
-			default_route_node =
-			config()->xml_node().sub_node("default-route"); }
-		catch (...) { }
+		Xml_node default_route_node = config_sub_node("default-route");
 
 		/* create aliases */
 		config()->xml_node().for_each_sub_node("alias", [&] (Xml_node alias_node) {
@@ -336,28 +834,48 @@ int main(int, char **)
 
 		});
 
-		/* create children */
+		/* create children that do not exist yet */
 		try {
+			Child_startup startup(default_route_node, children, *global_config,
+			                      parent_services, child_services, cap, ldso_ds);
+
+			bool name_conflict = false;
 			config()->xml_node().for_each_sub_node("start", [&] (Xml_node start_node) {
 
-				try {
-					children.insert(new (env()->heap())
-					                Init::Child(start_node, default_route_node,
-					                            children, read_prio_levels(),
-					                            read_affinity_space(),
-					                            parent_services, child_services, cap,
-					                            ldso_ds));
-				}
-				catch (Rom_connection::Rom_connection_failed) {
-					/*
-					 * The binary does not exist. An error message is printed
-					 * by the Rom_connection constructor.
-					 */
+				if (name_conflict)
+					return;
+
+				char name[Genode::Service::MAX_NAME_LEN];
+				name[0] = 0;
+				try { start_node.attribute("name").value(name, sizeof(name)); }
+				catch (...) { }
+
+				/* skip children kept from the previous config */
+				if (name[0] && children.has_child(name))
+					return;
+
+				/*
+				 * The construction checks the name against the registered
+				 * children only. Conflicts among the new children must be
+				 * detected beforehand because those children get registered
+				 * after all of them are constructed.
+				 */
+				if (name[0] && startup.scheduled(name)) {
+					PERR("Child name \"%s\" is not unique", name);
+					name_conflict = true;
+					return;
 				}
+
+				startup.add(start_node, name);
 			});
 
-			/* start children */
-			children.start();
+			unsigned const num_threads =
+				config()->xml_node().attribute_value("startup_threads",
+				                                     (unsigned)Child_startup::DEFAULT_THREADS);
+
+			startup.construct(num_threads, [&] (Init::Child &child) {
+				child.register_services();
+				children.insert(&child); });
 		}
 		catch (Xml_node::Nonexistent_sub_node) {
 			PERR("No children to start"); }
@@ -366,11 +884,20 @@ int main(int, char **)
 		catch (Init::Child::Child_name_is_not_unique) { }
 		catch (Init::Child_registry::Alias_name_is_not_unique) { }
 
+		/*
+		 * Start the new children, including those registered before a name
+		 * conflict stopped the startup. The kept children are running
+		 * already.
+		 */
+		children.start();
+
 		/*
 		 * Respond to config changes at runtime
 		 *
-		 * If the config gets updated to a new version, we kill the current
-		 * scenario and start again with the new config.
+		 * If the config gets updated to a new version, we restart the
+		 * children affected by the change. If the global parts of the config
+		 * changed, we kill the current scenario and start again with the new
+		 * config.
 		 */
 
 		/* wait for config change */
@@ -382,39 +909,41 @@ int main(int, char **)
 			PWRN("unexpected signal received - drop it");
 		}
 
-		/* kill all currently running children */
-		while (children.any()) {
-			Init::Child *child = children.any();
-			children.remove(child);
-			Genode::Server const *server = child->server();
-			destroy(env()->heap(), child);
+		/* reload config */
+		try { config()->reload(); } catch (...) { }
 
-			/*
-			 * The killed child may have provided services to other children.
-			 * Since the server is dead by now, we cannot close its sessions
-			 * in the cooperative way. Instead, we need to instruct each
-			 * other child to forget about session associated with the dead
-			 * server. Note that the 'child' pointer points a a no-more
-			 * existing object. It is only used to identify the corresponding
-			 * session. It must never by de-referenced!
-			 */
-			children.revoke_server(server);
+		if (global_config->unchanged()) {
+
+			bool const default_route_changed =
+				!global_config->default_route.equals(config_sub_node("default-route"));
+
+			abandon_outdated_children(children, default_route_changed);
+
+			while (Init::Child *child = children.any_abandoned())
+				destroy_child(children, child);
+
+		} else {
+
+			if (config_verbose)
+				printf("global config changed, restarting all children\n");
+
+			/* kill all currently running children */
+			while (Init::Child *child = children.any())
+				destroy_child(children, child);
+
+			/* reset knowledge about parent services */
+			parent_services.remove_all();
+
+			global_config.destruct();
 		}
 
-		/* remove all known aliases */
+		/* remove all known aliases, they are re-created from the new config */
 		while (children.any_alias()) {
 			Init::Alias *alias = children.any_alias();
 			children.remove_alias(alias);
 			destroy(env()->heap(), alias);
 		}
-
-		/* reset knowledge about parent services */
-		parent_services.remove_all();
-
-		/* reload config */
-		try { config()->reload(); } catch (...) { }
 	}
 
 	return 0;
 }
-
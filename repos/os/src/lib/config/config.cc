@@ -12,6 +12,7 @@
  */
 
 #include <os/config.h>
+#include <base/trace/events.h>
 
 using namespace Genode;
 
@@ -77,7 +78,9 @@ Config::Config()
 	_config_rom("config"),
 	_config_ds(_config_rom.dataspace()),
 	_config_xml(_config_xml_node(_config_ds))
-{ }
+{
+	Trace::Checkpoint("config");
+}
 
 
 Config *Genode::config()
@@ -0,0 +1,102 @@
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+enum { MAX_EVENT_SIZE = 64 };
+
+/*
+ * The policy is executed in a freestanding environment. Hence, we cannot
+ * use 'snprintf' for formatting the events.
+ */
+
+static size_t append(char *dst, size_t len, char const *s)
+{
+	size_t const n = strlen(s);
+
+	memcpy(dst + len, (void *)s, n);
+	return len + n;
+}
+
+
+static size_t append_number(char *dst, size_t len, unsigned long value,
+                            unsigned base)
+{
+	char digits[2*sizeof(value)*4];
+	size_t n = 0;
+
+	do {
+		unsigned const digit = value % base;
+		digits[n++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+		value /= base;
+	} while (value && n < sizeof(digits));
+
+	while (n)
+		dst[len++] = digits[--n];
+
+	return len;
+}
+
+
+size_t max_event_size()
+{
+	return MAX_EVENT_SIZE;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t signal_submit(char *dst, unsigned const)
+{
+	return 0;
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned)
+{
+	return 0;
+}
+
+/*
+ * Each event has the form "lock 0x<address> spins <n> <blocked|acquired>",
+ * which allows the trace consumer to accumulate the contention per lock.
+ */
+size_t lock_contention(char *dst, void const *lock, unsigned spins, bool blocked)
+{
+	size_t len = 0;
+
+	len = append(dst, len, "lock 0x");
+	len = append_number(dst, len, (unsigned long)lock, 16);
+	len = append(dst, len, " spins ");
+	len = append_number(dst, len, spins, 10);
+	len = append(dst, len, blocked ? " blocked" : " acquired");
+
+	return len;
+}
+
+size_t checkpoint(char *dst, char const *, char const *, unsigned long)
+{
+	return 0;
+}
+
+uint64_t timestamp()
+{
+	return Trace::timestamp();
+}
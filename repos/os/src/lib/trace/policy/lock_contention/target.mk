@@ -0,0 +1,7 @@
+REQUIRES = bugfix_for_riscv_toolchain
+
+TARGET = lock_contention_policy
+
+TARGET_POLICY = lock_contention
+
+include $(PRG_DIR)/../policy.inc
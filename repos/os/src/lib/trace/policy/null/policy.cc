@@ -37,3 +37,17 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 	return 0;
 }
 
+size_t lock_contention(char *dst, void const *, unsigned, bool)
+{
+	return 0;
+}
+
+size_t checkpoint(char *dst, char const *, char const *, unsigned long)
+{
+	return 0;
+}
+
+uint64_t timestamp()
+{
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include <util/string.h>
 #include <trace/policy.h>
+#include <trace/timestamp.h>
 
 using namespace Genode;
 
@@ -51,3 +52,18 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+size_t lock_contention(char *dst, void const *, unsigned, bool)
+{
+	return 0;
+}
+
+size_t checkpoint(char *dst, char const *, char const *, unsigned long)
+{
+	return 0;
+}
+
+uint64_t timestamp()
+{
+	return Trace::timestamp();
+}
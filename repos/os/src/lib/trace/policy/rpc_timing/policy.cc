@@ -0,0 +1,74 @@
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+/*
+ * The policy records the RPC events of client and server. The payload of
+ * each event is the name of the RPC function. The timestamp, the thread,
+ * and the invoked object are recorded in the event header. Because RPCs are
+ * synchronous, each 'rpc_call' is followed by the 'rpc_returned' event of
+ * the same thread, and each 'rpc_dispatch' by the matching 'rpc_reply'.
+ */
+
+enum { MAX_EVENT_SIZE = 64 };
+
+static size_t rpc_name_event(char *dst, char const *rpc_name)
+{
+	size_t const len = min(strlen(rpc_name), (size_t)MAX_EVENT_SIZE);
+
+	memcpy(dst, (void *)rpc_name, len);
+	return len;
+}
+
+
+size_t max_event_size()
+{
+	return MAX_EVENT_SIZE;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return rpc_name_event(dst, rpc_name);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return rpc_name_event(dst, rpc_name);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return rpc_name_event(dst, rpc_name);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return rpc_name_event(dst, rpc_name);
+}
+
+size_t signal_submit(char *dst, unsigned const)
+{
+	return 0;
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned)
+{
+	return 0;
+}
+
+size_t lock_contention(char *dst, void const *, unsigned, bool)
+{
+	return 0;
+}
+
+size_t checkpoint(char *dst, char const *, char const *, unsigned long)
+{
+	return 0;
+}
+
+uint64_t timestamp()
+{
+	return Trace::timestamp();
+}
@@ -0,0 +1,7 @@
+REQUIRES = bugfix_for_riscv_toolchain
+
+TARGET = rpc_timing_policy
+
+TARGET_POLICY = rpc_timing
+
+include $(PRG_DIR)/../policy.inc
@@ -0,0 +1,75 @@
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+/*
+ * The policy records the submission and reception of signals. The payload
+ * of each event is the number of signals as 32-bit value. The timestamp,
+ * the thread, and the signal context are recorded in the event header.
+ * Both the sender and the receiver denote the context by the local name of
+ * the context capability. Where capability names are unique system-wide,
+ * 'trace_decode -latency' pairs the events to obtain the delivery latency.
+ */
+
+enum { MAX_EVENT_SIZE = sizeof(uint32_t) };
+
+static size_t num_event(char *dst, unsigned num)
+{
+	uint32_t const value = num;
+
+	memcpy(dst, &value, sizeof(value));
+	return sizeof(value);
+}
+
+
+size_t max_event_size()
+{
+	return MAX_EVENT_SIZE;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	return num_event(dst, num);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	return num_event(dst, num);
+}
+
+size_t lock_contention(char *dst, void const *, unsigned, bool)
+{
+	return 0;
+}
+
+size_t checkpoint(char *dst, char const *, char const *, unsigned long)
+{
+	return 0;
+}
+
+uint64_t timestamp()
+{
+	return Trace::timestamp();
+}
@@ -0,0 +1,7 @@
+REQUIRES = bugfix_for_riscv_toolchain
+
+TARGET = signal_timing_policy
+
+TARGET_POLICY = signal_timing
+
+include $(PRG_DIR)/../policy.inc
@@ -0,0 +1,104 @@
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+enum { MAX_EVENT_SIZE = 64 };
+
+/*
+ * The policy records checkpoints only. This way, the trace buffers of the
+ * observed components are not flooded by RPC events during their startup.
+ */
+
+static size_t append(char *dst, size_t len, char const *s)
+{
+	size_t const n = min(strlen(s), (size_t)MAX_EVENT_SIZE - len);
+
+	memcpy(dst + len, (void *)s, n);
+	return len + n;
+}
+
+
+static size_t append_hex(char *dst, size_t len, unsigned long value)
+{
+	char digits[2*sizeof(value)];
+	size_t n = 0;
+
+	do {
+		unsigned const digit = value % 16;
+		digits[n++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+		value /= 16;
+	} while (value && n < sizeof(digits));
+
+	while (n)
+		dst[len++] = digits[--n];
+
+	return len;
+}
+
+
+size_t max_event_size()
+{
+	return MAX_EVENT_SIZE;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t signal_submit(char *dst, unsigned const)
+{
+	return 0;
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned)
+{
+	return 0;
+}
+
+size_t lock_contention(char *dst, void const *, unsigned, bool)
+{
+	return 0;
+}
+
+/*
+ * Each event has the form "0x<object> <name>" or "0x<object> <name> <detail>",
+ * which allows the trace consumer to tell apart the checkpoints taken for
+ * different objects, e.g., children of the same parent.
+ */
+size_t checkpoint(char *dst, char const *name, char const *detail,
+                  unsigned long object)
+{
+	size_t len = append(dst, 0, "0x");
+	len = append_hex(dst, len, object);
+	len = append(dst, len, " ");
+	len = append(dst, len, name);
+
+	if (*detail) {
+		len = append(dst, len, " ");
+		len = append(dst, len, detail);
+	}
+	return len;
+}
+
+uint64_t timestamp()
+{
+	return Trace::timestamp();
+}
@@ -0,0 +1,7 @@
+REQUIRES = bugfix_for_riscv_toolchain
+
+TARGET = startup_policy
+
+TARGET_POLICY = startup
+
+include $(PRG_DIR)/../policy.inc
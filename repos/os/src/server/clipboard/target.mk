@@ -1,4 +1,4 @@
 TARGET   = clipboard
 SRC_CC   = main.cc
-LIBS     = base
+LIBS     = base alarm
 INC_DIR += $(PRG_DIR)
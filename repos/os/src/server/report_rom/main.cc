@@ -38,8 +38,18 @@ struct Report_rom::Main
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	bool _report_enabled(char const *name)
+	{
+		try {
+			return config_rom.xml().sub_node("report").attribute_value(name, false); }
+		catch (Genode::Xml_node::Nonexistent_sub_node) { return false; }
+	}
+
+	Rom::Update_scheduler update_scheduler { env, verbose,
+	                                         _report_enabled("notifications") };
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
-	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
+	Rom   ::Root    rom_root { env, sliced_heap, rom_registry, &update_scheduler };
 
 	Main(Genode::Env &env) : env(env)
 	{
@@ -179,6 +179,17 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		{
 			return _release(reader, static_cast<Module &>(module));
 		}
+
+		unsigned long min_interval_ms(Module::Name const &rom_label) override
+		{
+			_config_rom.update();
+			try {
+				Genode::Session_policy policy(rom_label, _config_rom.xml());
+				return policy.attribute_value("min_interval_ms", 0UL);
+			} catch (Genode::Session_policy::No_policy_defined) { }
+
+			return 0;
+		}
 };
 
 #endif /* _ROM_REGISTRY_H_ */
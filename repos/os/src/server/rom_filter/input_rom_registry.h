@@ -16,6 +16,8 @@
 
 /* Genode includes */
 #include <util/xml_node.h>
+#include <util/xml_index.h>
+#include <util/volatile_object.h>
 #include <os/attached_rom_dataspace.h>
 #include <os/config.h>
 #include <os/attached_ram_dataspace.h>
@@ -66,22 +68,38 @@ class Rom_filter::Input_rom_registry
 
 				Server::Entrypoint &_ep;
 
+				Genode::Allocator &_alloc;
+
 				Input_rom_name _name;
 
 				Input_rom_changed_fn &_input_rom_changed_fn;
 
 				Genode::Attached_rom_dataspace _rom_ds { _name.string() };
 
+				/*
+				 * The input values are queried from the ROM content each
+				 * time one of the inputs changes. Hence, the content is
+				 * indexed to spare the repeated scanning of the XML text.
+				 * The index and the nodes obtained from it refer to the ROM
+				 * dataspace, which may become detached by 'update'.
+				 */
+				Genode::Lazy_volatile_object<Genode::Xml_index> _index;
+
 				Xml_node _top_level { "<empty/>" };
 
 				void _handle_rom_changed(unsigned)
 				{
+					_top_level = Xml_node("<empty/>");
+					_index.destruct();
+
 					_rom_ds.update();
 					if (!_rom_ds.valid())
 						return;
 
 					try {
-						_top_level = Xml_node(_rom_ds.local_addr<char>());
+						_index.construct(_alloc, Xml_node(_rom_ds.local_addr<char>(),
+						                                  _rom_ds.size()));
+						_top_level = _index->xml();
 					} catch (...) {
 						_top_level = Xml_node("<empty/>");
 					}
@@ -156,9 +174,10 @@ class Rom_filter::Input_rom_registry
 				 * Constructor
 				 */
 				Entry(Input_rom_name const &name, Server::Entrypoint &ep,
+				      Genode::Allocator &alloc,
 				      Input_rom_changed_fn &input_rom_changed_fn)
 				:
-					_ep(ep), _name(name),
+					_ep(ep), _alloc(alloc), _name(name),
 					_input_rom_changed_fn(input_rom_changed_fn)
 				{
 					_rom_ds.sigh(_rom_changed_dispatcher);
@@ -342,7 +361,7 @@ class Rom_filter::Input_rom_registry
 					return;
 
 				Entry *entry =
-					new (_alloc) Entry(name, _ep, _input_rom_changed_fn);
+					new (_alloc) Entry(name, _ep, _alloc, _input_rom_changed_fn);
 
 				_input_roms.insert(entry);
 			};
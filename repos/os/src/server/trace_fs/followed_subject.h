@@ -17,6 +17,7 @@
 #include <base/allocator.h>
 #include <base/lock.h>
 #include <base/trace/types.h>
+#include <dataspace/client.h>
 
 #include <directory.h>
 #include <trace_files.h>
@@ -46,32 +47,94 @@ namespace Trace_fs {
 
 				private:
 
-					Genode::Trace::Buffer       *buffer;
-					Genode::Trace::Buffer::Entry current_entry;
+					Genode::Trace::Buffer        *buffer;
+					size_t                  const buffer_size;
+					Genode::Trace::Buffer::Cursor cursor;
+					Genode::Trace::Buffer::Entry  current_entry;
+
+					/*
+					 * Number of bytes that may still be consumed during the
+					 * current poll, which prevents a busy writer from
+					 * keeping the reader in the loop forever
+					 */
+					size_t budget;
 
 
 				public:
 
-				Trace_buffer_manager(Genode::Dataspace_capability ds_cap)
+				Trace_buffer_manager(Genode::Dataspace_capability ds_cap,
+				                     Genode::Trace::Buffer::Mode mode)
 				:
 					buffer(Genode::env()->rm_session()->attach(ds_cap)),
-					current_entry(buffer->first())
-				{ }
+					buffer_size(Genode::Dataspace_client(ds_cap).size()),
+					current_entry(buffer->peek(cursor)),
+					budget(0)
+				{
+					buffer->mode(mode);
+				}
 
+				~Trace_buffer_manager()
+				{
+					Genode::env()->rm_session()->detach(buffer);
+				}
+
+				/**
+				 * Process entry at the read position and advance
+				 *
+				 * \return length of the processed entry, or 0 if the entry
+				 *         was overwritten while being processed
+				 */
 				size_t dump_entry(Process_entry &process)
 				{
 					size_t len = process(current_entry);
 
-					current_entry = buffer->next(current_entry);
+					if (!buffer->advance(cursor, current_entry))
+						len = 0;
+
+					_next();
 					return len;
 				}
 
+				/**
+				 * Return entry at the current read position
+				 */
+				Genode::Trace::Buffer::Entry const &entry() const
+				{
+					return current_entry;
+				}
+
+				void skip_entry()
+				{
+					buffer->advance(cursor, current_entry);
+					_next();
+				}
+
 				bool last_entry() const
 				{
-					return current_entry.last();
+					return current_entry.last() || budget == 0;
 				}
 
-				void rewind() { current_entry = buffer->first(); }
+				/**
+				 * Pick up the entries produced since the last poll
+				 */
+				void poll()
+				{
+					budget        = buffer_size;
+					current_entry = buffer->peek(cursor);
+				}
+
+				unsigned long produced() const { return buffer->produced(); }
+				unsigned long read()     const { return cursor.read(); }
+				unsigned long lost()     const { return buffer->lost(); }
+
+			private:
+
+				void _next()
+				{
+					budget -= Genode::min(budget, current_entry.length() + 1);
+
+					current_entry = buffer->peek(cursor);
+				}
 			};
 
 
@@ -96,9 +159,20 @@ namespace Trace_fs {
 			File_system::Enable_file      enable_file;
 			File_system::Events_file      events_file;
 			File_system::Policy_file      policy_file;
+			File_system::Stats_file       stats_file;
+
+			Genode::Session_label      const label;
+			Genode::Trace::Thread_name const thread_name;
+
+			/**
+			 * True once the subject was announced to the trace exporters
+			 */
+			bool exported = false;
 
 			Followed_subject(Genode::Allocator &md_alloc, char const *name,
-			              Genode::Trace::Subject_id &id, int handle)
+			                 Genode::Trace::Subject_id &id, int handle,
+			                 Genode::Session_label const &label,
+			                 Genode::Trace::Thread_name const &thread_name)
 			:
 				Directory(name),
 				_md_alloc(md_alloc),
@@ -111,7 +185,9 @@ namespace Trace_fs {
 				cleanup_file(_id),
 				enable_file(_id),
 				events_file(_id, _md_alloc),
-				policy_file(_id, _md_alloc)
+				policy_file(_id, _md_alloc),
+				stats_file(),
+				label(label), thread_name(thread_name)
 			{
 				adopt_unsynchronized(&active_file);
 				adopt_unsynchronized(&cleanup_file);
@@ -119,6 +195,7 @@ namespace Trace_fs {
 				adopt_unsynchronized(&events_file);
 				adopt_unsynchronized(&buffer_size_file);
 				adopt_unsynchronized(&policy_file);
+				adopt_unsynchronized(&stats_file);
 			}
 
 			~Followed_subject()
@@ -129,6 +206,7 @@ namespace Trace_fs {
 				discard_unsynchronized(&events_file);
 				discard_unsynchronized(&buffer_size_file);
 				discard_unsynchronized(&policy_file);
+				discard_unsynchronized(&stats_file);
 			}
 
 			bool marked_for_cleanup() const { return cleanup_file.cleanup(); }
@@ -136,12 +214,13 @@ namespace Trace_fs {
 
 			Trace_buffer_manager* trace_buffer_manager() { return _buffer_manager; }
 
-			void manage_trace_buffer(Genode::Dataspace_capability ds_cap)
+			void manage_trace_buffer(Genode::Dataspace_capability ds_cap,
+			                         Genode::Trace::Buffer::Mode mode)
 			{
 				if (_buffer_manager != 0)
 					throw Trace_buffer_manager::Already_managed();
 
-				_buffer_manager = new (&_md_alloc) Trace_buffer_manager(ds_cap);
+				_buffer_manager = new (&_md_alloc) Trace_buffer_manager(ds_cap, mode);
 			}
 
 			void unmanage_trace_buffer()
@@ -226,12 +305,17 @@ namespace Trace_fs {
 			 *
 			 * \param name name of subject
 			 * \param id subject id of tracre subject
+			 * \param label session label of the traced component
+			 * \param thread_name name of the traced thread
 			 */
-			Followed_subject *alloc(char const *name, Genode::Trace::Subject_id &id)
+			Followed_subject *alloc(char const *name, Genode::Trace::Subject_id &id,
+			                        Genode::Session_label const &label,
+			                        Genode::Trace::Thread_name const &thread_name)
 			{
 				int handle = _find_free_handle();
 
-				_subjects[handle] = new (&_md_alloc) Followed_subject(_md_alloc, name, id, handle);
+				_subjects[handle] = new (&_md_alloc)
+					Followed_subject(_md_alloc, name, id, handle, label, thread_name);
 
 				return _subjects[handle];
 			}
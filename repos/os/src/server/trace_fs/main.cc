@@ -22,8 +22,10 @@
 #include <root/component.h>
 #include <timer_session/connection.h>
 #include <trace_session/connection.h>
+#include <base/trace/event_header.h>
 #include <util/list.h>
 #include <util/string.h>
+#include <util/volatile_object.h>
 #include <util/xml_node.h>
 #include <file_system/util.h>
 
@@ -31,6 +33,7 @@
 #include <buffer.h>
 #include <directory.h>
 #include <followed_subject.h>
+#include <trace_export.h>
 #include <trace_files.h>
 
 
@@ -76,6 +79,9 @@ class Trace_file_system
 
 		typedef Trace_fs::Followed_subject_registry Followed_subject_registry;
 		typedef Trace_fs::Followed_subject Followed_subject;
+		typedef Trace_fs::Export_config    Export_config;
+		typedef Trace_fs::Chrome_exporter  Chrome_exporter;
+		typedef Trace_fs::Ctf_exporter     Ctf_exporter;
 
 		typedef File_system::Directory Directory;
 		typedef File_system::Node      Node;
@@ -191,10 +197,12 @@ class Trace_file_system
 				char   _buf[CAPACITY];
 				size_t _length;
 
+				unsigned const _subject;
 
 			public:
 
-				Process_entry() : _length(0) { _buf[0] = 0; }
+				Process_entry(unsigned subject)
+				: _length(0), _subject(subject) { _buf[0] = 0; }
 
 				/**
 				 * Return capacity of the internal buffer
@@ -213,19 +221,35 @@ class Trace_file_system
 				/**
 				 * Functor for processing a Trace:Buffer::Entry
 				 *
+				 * The event is stored with its header, which is supplemented
+				 * with the subject ID. Events that exceed the capacity of
+				 * the internal buffer are skipped.
+				 *
 				 * \param entry reference of Trace::Buffer::Entry
 				 *
 				 * \return length of processed Trace::Buffer::Entry
 				 */
 				Genode::size_t operator()(Genode::Trace::Buffer::Entry &entry)
 				{
-					Genode::size_t len = Genode::min(entry.length() + 1, CAPACITY);
-					Genode::memcpy(_buf, entry.data(), len);
-					_buf[len - 1] = '\n';
+					using Genode::Trace::Event_header;
+
+					_length = 0;
+
+					if (entry.last() || entry.length() < sizeof(Event_header)
+					 || entry.length() > CAPACITY)
+						return 0;
+
+					Event_header header = Event_header::read(entry.data());
+					header.subject = _subject;
+					header.write(_buf);
+
+					Genode::memcpy(_buf + sizeof(header),
+					               Event_header::payload(entry.data()),
+					               entry.length() - sizeof(header));
 
-					_length = len;
+					_length = entry.length();
 
-					return len;
+					return _length;
 				}
 		};
 
@@ -237,8 +261,13 @@ class Trace_file_system
 		size_t                     _buffer_size;
 		size_t                     _buffer_size_max;
 
+		Genode::Trace::Buffer::Mode _buffer_mode;
+
 		Followed_subject_registry  _followed_subject_registry;
 
+		Genode::Lazy_volatile_object<Chrome_exporter> _chrome_exporter;
+		Genode::Lazy_volatile_object<Ctf_exporter>    _ctf_exporter;
+
 
 		/**
 		 * Cast Node pointer to Directory pointer
@@ -250,36 +279,124 @@ class Trace_file_system
 			return dynamic_cast<Directory*>(node);
 		}
 
+		/**
+		 * Return true if an event is available at the read position of
+		 * the subject's trace buffer
+		 *
+		 * Entries that do not carry an event header are skipped.
+		 *
+		 * \param timestamp  timestamp of the available event
+		 */
+		static bool _next_event(Followed_subject *subject, Genode::uint64_t &timestamp)
+		{
+			using Genode::Trace::Event_header;
+
+			Followed_subject::Trace_buffer_manager *manager = subject->trace_buffer_manager();
+			if (!manager)
+				return false;
+
+			for (; !manager->last_entry(); manager->skip_entry()) {
+				Genode::Trace::Buffer::Entry const &entry = manager->entry();
+
+				if (entry.length() >= sizeof(Event_header)) {
+					timestamp = Event_header::read(entry.data()).timestamp;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Pass event to the enabled exporters
+		 */
+		void _export_event(Followed_subject *subject, char const *event, size_t len)
+		{
+			if (_chrome_exporter.constructed()) {
+				if (!subject->exported)
+					_chrome_exporter->announce(*subject);
+
+				_chrome_exporter->event(*subject, event, len);
+			}
+
+			if (_ctf_exporter.constructed())
+				_ctf_exporter->event(event, len);
+
+			subject->exported = true;
+		}
+
 		/**
 		  * Gather recent trace events
 		  *
-		  * \param subject pointer to subject
+		  * The events of all given subjects are merged by their timestamps
+		  * so that the exporters receive one time-ordered stream. Each event
+		  * is also appended to the 'events' file of its subject.
+		  *
+		  * \param subjects      array of subjects
+		  * \param num_subjects  number of subjects in the array
 		  */
-		void _gather_events(Followed_subject *subject)
+		void _gather_events(Followed_subject **subjects, size_t num_subjects)
 		{
-			Followed_subject::Trace_buffer_manager *manager = subject->trace_buffer_manager();
-			if (!manager)
-				return;
+			struct Cursor
+			{
+				Followed_subject *subject;
+				Genode::uint64_t  timestamp;
+				bool              valid;
+			} cursors[num_subjects];
 
-			PDBGV("update events for subject:'%s'", subject->name());
+			for (size_t i = 0; i < num_subjects; i++) {
+				if (subjects[i]->trace_buffer_manager())
+					subjects[i]->trace_buffer_manager()->poll();
 
-			Process_entry<512> process_entry;
+				cursors[i].subject = subjects[i];
+				cursors[i].valid   = _next_event(subjects[i], cursors[i].timestamp);
+			}
 
-			while (!manager->last_entry()) {
-				size_t len = manager->dump_entry(process_entry);
+			for (;;) {
 
-				if (len == 0)
-					continue;
+				/* select the oldest pending event */
+				Cursor *oldest = 0;
+				for (size_t i = 0; i < num_subjects; i++)
+					if (cursors[i].valid
+					 && (!oldest || cursors[i].timestamp < oldest->timestamp))
+						oldest = &cursors[i];
 
-				try { subject->events_file.append(process_entry.data(), len); }
-				catch (...) { PERR("could not write entry"); }
+				if (!oldest)
+					break;
+
+				Followed_subject *subject = oldest->subject;
+
+				PDBGV("update events for subject:'%s'", subject->name());
+
+				Process_entry<512> process_entry(subject->id().id);
+
+				size_t len = subject->trace_buffer_manager()->dump_entry(process_entry);
+
+				if (len > 0) {
+					try { subject->events_file.append(process_entry.data(), len); }
+					catch (...) { PERR("could not write entry"); }
+
+					_export_event(subject, process_entry.data(), len);
+				}
+
+				oldest->valid = _next_event(subject, oldest->timestamp);
 			}
 
-			if (manager->last_entry()) {
-				manager->rewind();
+			for (size_t i = 0; i < num_subjects; i++) {
+				Followed_subject::Trace_buffer_manager *manager =
+					subjects[i]->trace_buffer_manager();
+
+				if (manager)
+					subjects[i]->stats_file.update(manager->produced(),
+					                               manager->read(),
+					                               manager->lost());
 			}
 		}
 
+		void _gather_events(Followed_subject *subject)
+		{
+			_gather_events(&subject, 1);
+		}
+
 		/**
 		 * Disable tracing of a followed subject
 		 *
@@ -312,7 +429,8 @@ class Trace_file_system
 				_trace.trace(subject->id().id, subject->policy_id().id,
 				             subject->buffer_size_file.size());
 
-				try { subject->manage_trace_buffer(_trace.buffer(subject->id())); }
+				try { subject->manage_trace_buffer(_trace.buffer(subject->id()),
+				                                   _buffer_mode); }
 				catch (...) { PERR("trace buffer is already managed"); }
 
 				subject->active_file.set_active();
@@ -396,16 +514,46 @@ class Trace_file_system
 		/**
 		 * Constructor
 		 */
-		Trace_file_system(Genode::Allocator &alloc,
-		                  Trace             &trace,
-		                  Directory         &root_dir,
-		                  size_t             buffer_size,
-		                  size_t             buffer_size_max)
+		Trace_file_system(Genode::Allocator   &alloc,
+		                  Trace               &trace,
+		                  Directory           &root_dir,
+		                  size_t               buffer_size,
+		                  size_t               buffer_size_max,
+		                  Genode::Trace::Buffer::Mode buffer_mode,
+		                  Export_config const &export_config)
 		:
 			_alloc(alloc), _trace(trace), _root_dir(root_dir),
 			_buffer_size(buffer_size), _buffer_size_max(buffer_size_max),
+			_buffer_mode(buffer_mode),
 			_followed_subject_registry(_alloc)
-		{ }
+		{
+			if (export_config.chrome) {
+				_chrome_exporter.construct(_alloc, export_config);
+				_root_dir.adopt_unsynchronized(&_chrome_exporter->node());
+			}
+
+			if (export_config.ctf) {
+				_ctf_exporter.construct(_alloc, export_config);
+				_root_dir.adopt_unsynchronized(&_ctf_exporter->node());
+			}
+		}
+
+		~Trace_file_system()
+		{
+			if (_chrome_exporter.constructed()) {
+				if (_chrome_exporter->dropped())
+					PWRN("dropped %lu events of Chrome trace",
+					     _chrome_exporter->dropped());
+				_root_dir.discard_unsynchronized(&_chrome_exporter->node());
+			}
+
+			if (_ctf_exporter.constructed()) {
+				if (_ctf_exporter->dropped())
+					PWRN("dropped %lu events of CTF trace",
+					     _ctf_exporter->dropped());
+				_root_dir.discard_unsynchronized(&_ctf_exporter->node());
+			}
+		}
 
 		/**
 		 * Handle the change of the content of a node
@@ -517,6 +665,10 @@ class Trace_file_system
 
 			size_t num_subjects = _trace.subjects(subjects, subject_limit);
 
+			/* traced subjects, whose events are gathered at once */
+			Followed_subject *traced[subject_limit];
+			size_t            num_traced = 0;
+
 			/* traverse current trace subjects */
 			for (size_t i = 0; i < num_subjects; i++) {
 				Subject_info info = _trace.subject_info(subjects[i]);
@@ -546,7 +698,7 @@ class Trace_file_system
 					 * Update content of the corresponding events file
 					 */
 					if (state == Subject_info::State::TRACED) {
-						_gather_events(followed_subject);
+						traced[num_traced++] = followed_subject;
 						continue;
 					}
 
@@ -588,7 +740,9 @@ class Trace_file_system
 					subject_dir_name.replace('/', '_');
 
 					followed_subject = _followed_subject_registry.alloc(subject_dir_name.data(),
-					                                                    subjects[i]);
+					                                                    subjects[i],
+					                                                    info.session_label(),
+					                                                    info.thread_name());
 
 					/* set trace buffer size */
 					followed_subject->buffer_size_file.size_limit(_buffer_size_max);
@@ -605,6 +759,8 @@ class Trace_file_system
 					parent->adopt_unsynchronized(followed_subject);
 				}
 			}
+
+			_gather_events(traced, num_traced);
 		}
 };
 
@@ -762,7 +918,9 @@ class File_system::Session_component : public Session_rpc_object
 		                  size_t                  trace_meta_quota,
 		                  size_t                  trace_parent_levels,
 		                  size_t                  buffer_size,
-		                  size_t                  buffer_size_max)
+		                  size_t                  buffer_size_max,
+		                  Genode::Trace::Buffer::Mode buffer_mode,
+		                  Trace_fs::Export_config const &export_config)
 		:
 			Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
 			_ep(ep),
@@ -771,7 +929,7 @@ class File_system::Session_component : public Session_rpc_object
 			_subject_limit(subject_limit),
 			_poll_interval(poll_interval),
 			_trace(new (&_md_alloc) Genode::Trace::Connection(trace_quota, trace_meta_quota, trace_parent_levels)),
-			_trace_fs(new (&_md_alloc) Trace_file_system(_md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max)),
+			_trace_fs(new (&_md_alloc) Trace_file_system(_md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max, buffer_mode, export_config)),
 			_process_packet_dispatcher(_ep, *this, &Session_component::_process_packets),
 			_fs_update_dispatcher(_ep, *this, &Session_component::_fs_update)
 		{
@@ -947,6 +1105,11 @@ class File_system::Root : public Root_component<Session_component>
 			Genode::Number_of_bytes buffer_size_max  =   1 * (1 << 20); /*   1 MiB */
 			unsigned trace_parent_levels             = 0;
 
+			Genode::Trace::Buffer::Mode buffer_mode = Genode::Trace::Buffer::OVERWRITE;
+
+			Trace_fs::Export_config export_config;
+			Genode::Number_of_bytes export_buffer_size = export_config.buffer_size;
+
 			Session_label const label = label_from_args(args);
 			try {
 				Session_policy policy(label);
@@ -969,6 +1132,20 @@ class File_system::Root : public Root_component<Session_component>
 				} catch (...) { }
 				try { policy.attribute("buffer_size_max").value(&buffer_size_max);
 				} catch (...) { }
+				try {
+					if (policy.attribute("drop_newest").has_value("yes"))
+						buffer_mode = Genode::Trace::Buffer::DROP_NEWEST;
+				} catch (...) { }
+				try { export_config.chrome = policy.attribute("chrome_export").has_value("yes");
+				} catch (...) { }
+				try { export_config.ctf = policy.attribute("ctf_export").has_value("yes");
+				} catch (...) { }
+				try { policy.attribute("export_buffer_size").value(&export_buffer_size);
+				} catch (...) { }
+				try { policy.attribute("cycles_per_us").value(&export_config.cycles_per_us);
+				} catch (...) { }
+
+				export_config.buffer_size = export_buffer_size;
 
 				/*
 				 * Determine directory that is used as root directory of
@@ -1021,7 +1198,8 @@ class File_system::Root : public Root_component<Session_component>
 				Session_component(tx_buf_size, _ep, _root_dir, *md_alloc(),
 				                  subject_limit, interval, trace_quota,
 				                  trace_meta_quota, trace_parent_levels,
-				                  buffer_size, buffer_size_max);
+				                  buffer_size, buffer_size_max, buffer_mode,
+				                  export_config);
 		}
 
 	public:
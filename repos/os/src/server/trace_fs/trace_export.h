@@ -0,0 +1,404 @@
+/*
+ * \brief  Export of trace events in the formats of external tools
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _TRACE_EXPORT_H_
+#define _TRACE_EXPORT_H_
+
+/* Genode includes */
+#include <base/snprintf.h>
+#include <base/trace/event_header.h>
+
+/* local includes */
+#include <directory.h>
+#include <followed_subject.h>
+#include <trace_files.h>
+
+namespace Trace_fs {
+
+	struct Export_config;
+	class  Chrome_exporter;
+	class  Ctf_metadata_file;
+	class  Ctf_exporter;
+}
+
+
+/**
+ * Export settings of a trace_fs session
+ */
+struct Trace_fs::Export_config
+{
+	bool          chrome        = false;
+	bool          ctf           = false;
+	size_t        buffer_size   = 256*1024;
+
+	/* conversion factor from event timestamps to microseconds */
+	unsigned long cycles_per_us = 1;
+};
+
+
+/**
+ * Exporter producing the JSON trace-event format of Chrome and Perfetto
+ *
+ * The events are written as JSON array to the file 'trace.json'. Because
+ * the file is streamed, the array is never closed, which is tolerated by
+ * both viewers. Each component (session label) appears as process, each
+ * trace subject as thread. RPC calls and dispatches open a duration that
+ * is closed by the corresponding return and reply events. All other events
+ * are shown as instant events.
+ */
+class Trace_fs::Chrome_exporter
+{
+	private:
+
+		typedef Genode::Trace::Event_header Event_header;
+
+		enum { MAX_RECORD_LEN = 4096 };
+
+		File_system::Stream_file _file;
+
+		unsigned long const _cycles_per_us;
+
+		bool _first_record = true;
+
+		/**
+		 * Return process ID of the component with the given label
+		 */
+		static unsigned _pid(Followed_subject const &subject)
+		{
+			/* djb2 string hash */
+			unsigned hash = 5381;
+			for (char const *s = subject.label.string(); *s; s++)
+				hash = hash*33 + *s;
+
+			return hash & 0x7fffffff;
+		}
+
+		/**
+		 * Print string 'str' of at most 'len' characters as JSON string
+		 */
+		static void _print_string(Genode::String_console &out,
+		                          char const *str, size_t len)
+		{
+			out.printf("\"");
+			for (size_t i = 0; i < len && str[i]; i++) {
+				char const c = str[i];
+				if (c == '"' || c == '\\')
+					out.printf("\\%c", c);
+				else if ((unsigned char)c < 0x20)
+					out.printf("\\u%04x", (unsigned char)c);
+				else
+					out.printf("%c", c);
+			}
+			out.printf("\"");
+		}
+
+		static char const *_category(unsigned type)
+		{
+			switch (type) {
+			case Event_header::TEXT:            return "text";
+			case Event_header::RPC_CALL:
+			case Event_header::RPC_RETURNED:    return "rpc_client";
+			case Event_header::RPC_DISPATCH:
+			case Event_header::RPC_REPLY:       return "rpc_server";
+			case Event_header::SIGNAL_SUBMIT:   return "signal_submit";
+			case Event_header::SIGNAL_RECEIVED: return "signal_received";
+			case Event_header::LOCK_CONTENTION: return "lock_contention";
+			case Event_header::CHECKPOINT:      return "checkpoint";
+			}
+			return "unknown";
+		}
+
+		static char const *_phase(unsigned type)
+		{
+			switch (type) {
+			case Event_header::RPC_CALL:
+			case Event_header::RPC_DISPATCH: return "B";
+			case Event_header::RPC_RETURNED:
+			case Event_header::RPC_REPLY:    return "E";
+			}
+			return "i";
+		}
+
+		/**
+		 * Append record, separated from the previous one
+		 */
+		void _append(Genode::String_console &out, char const *record)
+		{
+			if (_file.append(record, out.len()))
+				_first_record = false;
+		}
+
+	public:
+
+		Chrome_exporter(Genode::Allocator &alloc, Export_config const &config)
+		:
+			_file(alloc, "trace.json", config.buffer_size),
+			_cycles_per_us(Genode::max(config.cycles_per_us, 1UL))
+		{
+			_file.append("[\n", 2);
+		}
+
+		File_system::Node &node() { return _file; }
+
+		/**
+		 * Emit names of the process and thread of a newly exported subject
+		 */
+		void announce(Followed_subject const &subject)
+		{
+			char record[MAX_RECORD_LEN];
+
+			char const *names[][2] = {
+				{ "process_name", subject.label.string()       },
+				{ "thread_name",  subject.thread_name.string() } };
+
+			for (unsigned i = 0; i < 2; i++) {
+				Genode::String_console out(record, sizeof(record));
+
+				out.printf("%s{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+				           "\"args\":{\"name\":", _first_record ? "" : ",\n",
+				           names[i][0], _pid(subject), subject.id().id);
+				_print_string(out, names[i][1], ~0UL);
+				out.printf("}}");
+
+				_append(out, record);
+			}
+		}
+
+		/**
+		 * Export event consisting of header and payload
+		 */
+		void event(Followed_subject const &subject, char const *event, size_t len)
+		{
+			Event_header const header  = Event_header::read(event);
+			char const * const payload = Event_header::payload(event);
+			size_t const payload_len   = len - sizeof(Event_header);
+
+			char record[MAX_RECORD_LEN];
+			Genode::String_console out(record, sizeof(record));
+
+			out.printf("%s{\"name\":", _first_record ? "" : ",\n");
+
+			bool const signal = header.type == Event_header::SIGNAL_SUBMIT
+			                 || header.type == Event_header::SIGNAL_RECEIVED;
+
+			if (signal && payload_len >= sizeof(Genode::uint32_t)) {
+				Genode::uint32_t num = 0;
+				Genode::memcpy(&num, payload, sizeof(num));
+				out.printf("\"num %u\"", num);
+			} else if (payload_len > 0 && payload[0]) {
+				_print_string(out, payload, payload_len);
+			} else {
+				_print_string(out, _category(header.type), ~0UL);
+			}
+
+			unsigned long long const us   = header.timestamp / _cycles_per_us;
+			unsigned long long const frac = (header.timestamp % _cycles_per_us)
+			                              * 1000 / _cycles_per_us;
+
+			out.printf(",\"cat\":\"%s\",\"ph\":\"%s\",", _category(header.type),
+			           _phase(header.type));
+			if (_phase(header.type)[0] == 'i')
+				out.printf("\"s\":\"t\",");
+
+			out.printf("\"ts\":%llu.%03llu,\"pid\":%u,\"tid\":%u,"
+			           "\"args\":{\"object\":\"0x%llx\",\"thread\":%u,\"cpu\":%u}}",
+			           us, frac, _pid(subject), subject.id().id,
+			           (unsigned long long)header.object, header.thread,
+			           header.cpu);
+
+			_append(out, record);
+		}
+
+		unsigned long dropped() const { return _file.dropped(); }
+};
+
+
+/**
+ * TSDL description of the CTF stream produced by the 'Ctf_exporter'
+ */
+class Trace_fs::Ctf_metadata_file : public File_system::Buffered_file
+{
+	public:
+
+		Ctf_metadata_file(Genode::Allocator &alloc, unsigned long cycles_per_us)
+		:
+			Buffered_file(alloc, "metadata")
+		{
+			static char const *types[] = {
+				"text", "rpc_call", "rpc_returned", "rpc_dispatch",
+				"rpc_reply", "signal_submit", "signal_received",
+				"lock_contention", "checkpoint" };
+
+			enum { MAX_LEN = 4096 };
+			char buf[MAX_LEN];
+			Genode::String_console out(buf, sizeof(buf));
+
+			/* all platforms supported by Genode are little endian */
+			out.printf(
+				"/* CTF 1.8 */\n"
+				"typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n"
+				"typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+				"typealias integer { size = 64; align = 8; signed = false; base = hex; } := uint64x_t;\n"
+				"\n"
+				"trace {\n"
+				"\tmajor = 1;\n"
+				"\tminor = 8;\n"
+				"\tbyte_order = le;\n"
+				"\tpacket.header := struct { uint32_t magic; uint32_t stream_id; };\n"
+				"};\n"
+				"\n"
+				"clock {\n"
+				"\tname = cycles;\n"
+				"\tfreq = %lu000000;\n"
+				"};\n"
+				"\n"
+				"typealias integer { size = 64; align = 8; signed = false;"
+				" map = clock.cycles.value; } := cycles_t;\n"
+				"\n"
+				"stream {\n"
+				"\tid = 0;\n"
+				"\tevent.header := struct { uint16_t id; cycles_t timestamp; };\n"
+				"\tevent.context := struct {\n"
+				"\t\tuint32_t subject; uint32_t thread; uint16_t cpu; uint64x_t object; };\n"
+				"};\n", Genode::max(cycles_per_us, 1UL));
+
+			for (unsigned i = 0; i < sizeof(types)/sizeof(types[0]); i++) {
+				bool const signal = (i == Genode::Trace::Event_header::SIGNAL_SUBMIT)
+				                 || (i == Genode::Trace::Event_header::SIGNAL_RECEIVED);
+
+				out.printf("\nevent {\n\tid = %u;\n\tname = \"%s\";\n\tstream_id = 0;\n"
+				           "\tfields := struct { %s; };\n};\n", i, types[i],
+				           signal ? "uint32_t num" : "string payload");
+			}
+
+			Buffered_file::write(buf, out.len(), 0);
+		}
+
+		/* the metadata is static */
+		size_t write(char const *src, size_t len,
+		             File_system::seek_off_t seek_offset) { return 0; }
+
+		void truncate(File_system::file_size_t size) { }
+};
+
+
+/**
+ * Exporter producing a Common Trace Format (CTF) trace
+ *
+ * The trace is provided as directory 'ctf' containing the 'metadata' file
+ * and a single 'stream' file, which can be copied to a host and opened
+ * with CTF tools such as babeltrace or Trace Compass. The stream consists
+ * of one packet without packet context, which grows as long as events are
+ * exported.
+ */
+class Trace_fs::Ctf_exporter
+{
+	private:
+
+		typedef Genode::Trace::Event_header Event_header;
+
+		enum { CTF_MAGIC = 0xc1fc1fc1, MAX_RECORD_LEN = 1024 };
+
+		File_system::Directory   _dir { "ctf" };
+		Ctf_metadata_file        _metadata;
+		File_system::Stream_file _stream;
+
+		/*
+		 * CTF requires the timestamps within a packet to be monotonic. Events
+		 * of subjects polled at different times may violate this order by a
+		 * small amount, so timestamps are clamped to the latest one exported.
+		 */
+		Genode::uint64_t _last_timestamp = 0;
+
+		template <typename T>
+		static size_t _put(char *dst, size_t offset, T const &value)
+		{
+			Genode::memcpy(dst + offset, &value, sizeof(value));
+			return offset + sizeof(value);
+		}
+
+	public:
+
+		Ctf_exporter(Genode::Allocator &alloc, Export_config const &config)
+		:
+			_metadata(alloc, config.cycles_per_us),
+			_stream(alloc, "stream", config.buffer_size)
+		{
+			_dir.adopt_unsynchronized(&_metadata);
+			_dir.adopt_unsynchronized(&_stream);
+
+			char header[2*sizeof(Genode::uint32_t)];
+			size_t len = _put(header, 0, (Genode::uint32_t)CTF_MAGIC);
+			len = _put(header, len, (Genode::uint32_t)0);
+
+			_stream.append(header, len);
+		}
+
+		~Ctf_exporter()
+		{
+			_dir.discard_unsynchronized(&_metadata);
+			_dir.discard_unsynchronized(&_stream);
+		}
+
+		File_system::Node &node() { return _dir; }
+
+		/**
+		 * Export event consisting of header and payload
+		 */
+		void event(char const *event, size_t len)
+		{
+			Event_header const header  = Event_header::read(event);
+			char const * const payload = Event_header::payload(event);
+			size_t const payload_len   = len - sizeof(Event_header);
+
+			/* events of unknown type lack a description in the metadata */
+			if (header.type > Event_header::CHECKPOINT)
+				return;
+
+			char record[MAX_RECORD_LEN];
+
+			_last_timestamp = Genode::max(_last_timestamp, header.timestamp);
+
+			size_t n = 0;
+			n = _put(record, n, (Genode::uint16_t)header.type);
+			n = _put(record, n, _last_timestamp);
+			n = _put(record, n, header.subject);
+			n = _put(record, n, header.thread);
+			n = _put(record, n, header.cpu);
+			n = _put(record, n, header.object);
+
+			if (header.type == Event_header::SIGNAL_SUBMIT
+			 || header.type == Event_header::SIGNAL_RECEIVED) {
+
+				Genode::uint32_t num = 0;
+				Genode::memcpy(&num, payload,
+				               Genode::min(payload_len, sizeof(num)));
+				n = _put(record, n, num);
+
+			} else {
+
+				/* payload as null-terminated string */
+				size_t const max_len = Genode::min(payload_len,
+				                                   (size_t)MAX_RECORD_LEN - n - 1);
+				for (size_t i = 0; i < max_len && payload[i]; i++)
+					record[n++] = payload[i];
+				record[n++] = 0;
+			}
+
+			_stream.append(record, n);
+		}
+
+		unsigned long dropped() const { return _stream.dropped(); }
+};
+
+#endif /* _TRACE_EXPORT_H_ */
@@ -225,6 +225,187 @@ namespace File_system {
 	};
 
 
+	/**
+	 * The Stats_file shows how many events of the traced thread were
+	 * produced, read, and lost
+	 */
+
+	class Stats_file : public File
+	{
+		private:
+
+			char   _content[96];
+			size_t _length;
+
+
+		public:
+
+			Stats_file() : File("stats") { update(0, 0, 0); }
+
+			void update(unsigned long produced, unsigned long read,
+			            unsigned long lost)
+			{
+				/* lost events in per mille of the produced ones */
+				unsigned long const lost_rate = produced ? lost*1000/produced : 0;
+
+				_length = Genode::snprintf(_content, sizeof(_content),
+				                           "produced %lu\nread %lu\nlost %lu (%lu.%lu%%)\n",
+				                           produced, read, lost,
+				                           lost_rate/10, lost_rate%10);
+			}
+
+
+			/********************
+			 ** Node interface **
+			 ********************/
+
+			size_t read(char *dst, size_t len, seek_off_t seek_offset)
+			{
+				if (seek_offset >= _length)
+					return 0;
+
+				len = min(len, (size_t)(_length - seek_offset));
+				memcpy(dst, _content + seek_offset, len);
+
+				return len;
+			}
+
+			size_t write(char const *src, size_t len, seek_off_t seek_offset) { return 0; }
+
+			Status status() const
+			{
+				Status s;
+
+				s.inode = inode();
+				s.size  = _length;
+				s.mode  = File_system::Status::MODE_FILE;
+
+				return s;
+			}
+
+
+			/********************
+			 ** File interface **
+			 ********************/
+
+			file_size_t length() const { return _length; }
+
+			void truncate(file_size_t size) { }
+	};
+
+
+	/**
+	 * Stream file
+	 *
+	 * In contrast to the 'Events_file', this file retains only the data
+	 * that was not consumed yet. The data is kept in a ring buffer of fixed
+	 * capacity and is released as soon as it was read. Hence, the file must
+	 * be read sequentially. Records that do not fit into the ring buffer
+	 * because the reader does not keep up are dropped as a whole.
+	 */
+	class Stream_file : public File
+	{
+		private:
+
+			Allocator    &_alloc;
+			size_t const  _capacity;
+			char         *_buf;
+
+			file_size_t   _length   = 0; /* number of bytes ever appended  */
+			file_size_t   _consumed = 0; /* offset up to which data was read */
+
+			unsigned long _dropped  = 0;
+
+			size_t _used() const { return _length - _consumed; }
+
+		public:
+
+			Stream_file(Allocator &alloc, char const *name, size_t capacity)
+			:
+				File(name), _alloc(alloc), _capacity(capacity),
+				_buf((char *)_alloc.alloc(_capacity))
+			{ }
+
+			~Stream_file() { _alloc.free(_buf, _capacity); }
+
+			/**
+			 * Append record to the stream
+			 *
+			 * \return true if the record was stored, false if it was
+			 *         dropped because the buffer lacks space
+			 */
+			bool append(char const *src, size_t len)
+			{
+				if (len > _capacity - _used()) {
+					_dropped++;
+					return false;
+				}
+
+				for (size_t i = 0; i < len; i++)
+					_buf[(_length + i) % _capacity] = src[i];
+
+				_length += len;
+
+				mark_as_updated();
+				return true;
+			}
+
+			/**
+			 * Return number of records dropped so far
+			 */
+			unsigned long dropped() const { return _dropped; }
+
+
+			/********************
+			 ** Node interface **
+			 ********************/
+
+			/**
+			 * Read data from the stream
+			 *
+			 * Data below the highest offset read so far is no longer
+			 * available.
+			 */
+			size_t read(char *dst, size_t len, seek_off_t seek_offset)
+			{
+				if (seek_offset < _consumed || seek_offset >= _length)
+					return 0;
+
+				len = min(len, (size_t)(_length - seek_offset));
+
+				for (size_t i = 0; i < len; i++)
+					dst[i] = _buf[(seek_offset + i) % _capacity];
+
+				_consumed = seek_offset + len;
+
+				return len;
+			}
+
+			/* the stream is written by the trace file system only */
+			size_t write(char const *src, size_t len, seek_off_t seek_offset) { return 0; }
+
+			Status status() const
+			{
+				Status s;
+
+				s.inode = inode();
+				s.size  = _length;
+				s.mode  = File_system::Status::MODE_FILE;
+
+				return s;
+			}
+
+
+			/********************
+			 ** File interface **
+			 ********************/
+
+			file_size_t length() const { return _length; }
+
+			void truncate(file_size_t size) { }
+	};
+
+
 	/**
 	 * This file contains the size of the trace buffer
 	 */
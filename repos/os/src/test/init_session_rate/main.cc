@@ -0,0 +1,54 @@
+/*
+ * \brief  Measure the rate of session requests routed by init
+ * \author Genode Labs
+ * \date   2016-06-06
+ *
+ * The test repeatedly opens and closes LOG sessions. Each session request
+ * passes the routing of the parent init instance, which is configured with
+ * a long list of route rules by the run script.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <log_session/connection.h>
+#include <timer_session/connection.h>
+
+
+int main(int argc, char **argv)
+{
+	using namespace Genode;
+
+	printf("--- test-init_session_rate started ---\n");
+
+	static Timer::Connection timer;
+
+	enum { ROUNDS = 5, DURATION_MS = 2000 };
+
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long       now_ms   = start_ms;
+		unsigned long       sessions = 0;
+
+		for (; now_ms - start_ms < DURATION_MS; now_ms = timer.elapsed_ms()) {
+
+			/* perform a batch of requests between two timer queries */
+			for (unsigned i = 0; i < 16; i++, sessions++)
+				Log_connection log;
+		}
+
+		printf("timing: %lu sessions in %lu ms -> %lu sessions/s\n",
+		       sessions, now_ms - start_ms,
+		       (sessions*1000)/(now_ms - start_ms));
+	}
+
+	printf("--- test-init_session_rate finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-init_session_rate
+SRC_CC = main.cc
+LIBS   = base
@@ -66,6 +66,25 @@ int main(int argc, char **argv)
 	brightness_rom.update();
 	printf("         -> %s\n", brightness_rom.local_addr<char>());
 
+	/*
+	 * Each ROM client has a private copy of the content. A client that
+	 * modifies its dataspace must not affect the content seen by another
+	 * client of the same ROM module.
+	 */
+	{
+		printf("ROM client: open second ROM session\n");
+		Attached_rom_dataspace second_rom("brightness");
+
+		printf("ROM client: modify content of the first ROM session\n");
+		strncpy(brightness_rom.local_addr<char>(), "<modified/>",
+		        brightness_rom.size());
+
+		second_rom.update();
+		printf("second ROM client: -> %s\n", second_rom.local_addr<char>());
+		ASSERT(strcmp(second_rom.local_addr<char>(), "<modified/>") != 0);
+		printf("ROM client: content of second ROM session unchanged - OK\n");
+	}
+
 	printf("Reporter: close report session\n");
 	brightness_reporter.enabled(false);
 
@@ -94,6 +113,46 @@ int main(int argc, char **argv)
 		printf("ROM client: catched Parent::Service_denied - OK\n");
 	}
 
+	/*
+	 * The policy of the "load" ROM module limits the rate of update
+	 * notifications to one per 500 ms. A burst of reports must result
+	 * in fewer notifications while the client still gets the last report.
+	 */
+	{
+		enum { NUM_REPORTS = 10 };
+
+		Signal_receiver load_rec;
+		Signal_context  load_ctx;
+
+		Reporter load_reporter("load");
+		load_reporter.enabled(true);
+
+		Attached_rom_dataspace load_rom("load");
+		load_rom.sigh(load_rec.manage(&load_ctx));
+
+		printf("Reporter: report load %u times in a row\n", (unsigned)NUM_REPORTS);
+		for (int i = 0; i < NUM_REPORTS; i++) {
+			Reporter::Xml_generator xml(load_reporter, [&] () {
+				xml.attribute("value", i); });
+		}
+
+		/* wait for the deferred notification */
+		timer.msleep(1000);
+
+		unsigned num_signals = 0;
+		while (load_rec.pending())
+			num_signals += load_rec.wait_for_signal().num();
+
+		load_rom.update();
+		printf("ROM client: -> %s\n", load_rom.local_addr<char>());
+
+		/* the initial signal, the first update, and the deferred update */
+		ASSERT(num_signals <= 3);
+		printf("ROM client: notifications rate limited - OK\n");
+
+		load_rec.dissolve(&load_ctx);
+	}
+
 	printf("--- test-report_rom finished ---\n");
 
 	sig_rec.dissolve(&sig_ctx);
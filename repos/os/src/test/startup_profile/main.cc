@@ -0,0 +1,503 @@
+/*
+ * \brief  Per-phase breakdown of the startup time of a component
+ * \author Genode Labs
+ * \date   2016-06-06
+ *
+ * The monitor traces the parent of the profiled component and all its
+ * children with the 'startup' trace policy, which records checkpoints only.
+ * Threads created later on, in particular those of the profiled component,
+ * are traced right from their start by installing a trace rule. Each
+ * checkpoint named 'start' (default "create") with the component's name as
+ * detail marks the begin of a new startup. The time between two subsequent
+ * checkpoints of a startup is accounted to the phase between them. Once the
+ * configured number of startups is observed, the monitor prints the
+ * distribution of the duration of each phase.
+ *
+ * The checkpoints taken by the parent on behalf of a child are tagged with
+ * an object that identifies the child. A startup comprises only the
+ * checkpoints tagged with the object of its start checkpoint. Checkpoints
+ * without object, which are taken by the components themselves, are
+ * attributed to the latest startup. Hence, other children of the parent
+ * must not be started while profiling.
+ *
+ * For profiling the programs executed by noux, 'parent' refers to noux,
+ * 'child' to the path of the executed binary, and 'start' to "execve".
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/trace/event_header.h>
+#include <trace_session/connection.h>
+#include <timer_session/connection.h>
+#include <rom_session/connection.h>
+#include <dataspace/client.h>
+#include <os/config.h>
+#include <trace/timestamp.h>
+#include <util/list.h>
+
+using namespace Genode;
+
+
+/**
+ * Return true if 'label' equals 'prefix' or denotes a child of 'prefix'
+ */
+static bool label_matches(char const *prefix, char const *label)
+{
+	size_t const len  = strlen(prefix);
+	char   const *rest = label + len;
+
+	return !strcmp(prefix, label, len) && (!*rest || !strcmp(rest, " -> ", 4));
+}
+
+
+/**
+ * Checkpoints observed by the monitor
+ */
+class Checkpoints
+{
+	public:
+
+		enum { MAX_CHECKPOINTS = 8192, MAX_NAME_LEN = 64 };
+
+		struct Checkpoint
+		{
+			uint64_t      timestamp;
+			unsigned long object;
+			char          name[MAX_NAME_LEN];
+		};
+
+	private:
+
+		Checkpoint _checkpoints[MAX_CHECKPOINTS];
+		unsigned   _num = 0;
+		unsigned   _num_starts = 0;
+		char       _start[MAX_NAME_LEN];
+
+	public:
+
+		Checkpoints(char const *start, char const *child)
+		{
+			snprintf(_start, sizeof(_start), "%s %s", start, child);
+		}
+
+		/**
+		 * Add checkpoint
+		 *
+		 * \param payload  event generated by the 'startup' policy in the
+		 *                 form "0x<object> <name>[ <detail>]"
+		 */
+		void add(uint64_t timestamp, char const *payload)
+		{
+			if (_num == MAX_CHECKPOINTS)
+				return;
+
+			unsigned long object = 0;
+			size_t const n = ascii_to(payload, object);
+			if (!n || payload[n] != ' ')
+				return;
+
+			Checkpoint &c = _checkpoints[_num++];
+			c.timestamp = timestamp;
+			c.object    = object;
+			strncpy(c.name, payload + n + 1, sizeof(c.name));
+
+			if (is_start(c))
+				_num_starts++;
+		}
+
+		bool is_start(Checkpoint const &c) const {
+			return !strcmp(c.name, _start); }
+
+		unsigned num_starts() const { return _num_starts; }
+
+		bool full() const { return _num == MAX_CHECKPOINTS; }
+
+		/**
+		 * Sort checkpoints by their timestamps
+		 *
+		 * The checkpoints are collected from several trace buffers, each of
+		 * which is ordered by itself.
+		 */
+		void sort()
+		{
+			for (unsigned i = 1; i < _num; i++) {
+				Checkpoint const c = _checkpoints[i];
+				unsigned j = i;
+				for (; j > 0 && _checkpoints[j - 1].timestamp > c.timestamp; j--)
+					_checkpoints[j] = _checkpoints[j - 1];
+				_checkpoints[j] = c;
+			}
+		}
+
+		/**
+		 * Call 'fn' for each checkpoint in the order of their timestamps
+		 */
+		template <typename FN>
+		void for_each(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _num; i++)
+				fn(_checkpoints[i]);
+		}
+};
+
+
+/**
+ * Trace buffer of one subject
+ */
+class Subject_monitor : public List<Subject_monitor>::Element
+{
+	private:
+
+		Trace::Subject_id const _id;
+		Trace::Buffer          *_buffer;
+		Trace::Buffer::Cursor   _cursor;
+
+	public:
+
+		Subject_monitor(Trace::Subject_id id, Dataspace_capability ds)
+		:
+			_id(id), _buffer(env()->rm_session()->attach(ds))
+		{ }
+
+		~Subject_monitor() { release(); }
+
+		Trace::Subject_id id() const { return _id; }
+
+		bool released() const { return !_buffer; }
+
+		/**
+		 * Detach buffer, e.g., once the subject vanished
+		 */
+		void release()
+		{
+			if (_buffer)
+				env()->rm_session()->detach(_buffer);
+
+			_buffer = nullptr;
+		}
+
+		unsigned long lost() const { return _cursor.lost(); }
+
+		void read(Checkpoints &checkpoints)
+		{
+			if (!_buffer)
+				return;
+
+			using Trace::Event_header;
+
+			for (Trace::Buffer::Entry entry = _buffer->peek(_cursor); !entry.last();
+			     entry = _buffer->peek(_cursor)) {
+
+				if (entry.length() < sizeof(Event_header)) {
+					_buffer->advance(_cursor, entry);
+					continue;
+				}
+
+				Event_header const header = Event_header::read(entry.data());
+
+				char   payload[Checkpoints::MAX_NAME_LEN];
+				size_t len = min((size_t)header.length, entry.length() - sizeof(header));
+				len = min(len, sizeof(payload) - 1);
+				memcpy(payload, Event_header::payload(entry.data()), len);
+				payload[len] = 0;
+
+				/* skip entries overwritten while being read */
+				if (_buffer->advance(_cursor, entry)
+				 && header.type == Event_header::CHECKPOINT)
+					checkpoints.add(header.timestamp, payload);
+			}
+		}
+};
+
+
+/**
+ * Durations of one phase over all observed startups
+ */
+struct Phase : List<Phase>::Element
+{
+	enum { MAX_SAMPLES = 256 };
+
+	char     name[2*Checkpoints::MAX_NAME_LEN + 4];
+	uint64_t samples[MAX_SAMPLES];
+	unsigned num = 0;
+
+	Phase(char const *phase_name) { strncpy(name, phase_name, sizeof(name)); }
+
+	void add(uint64_t duration)
+	{
+		if (num < MAX_SAMPLES)
+			samples[num++] = duration;
+	}
+
+	/**
+	 * Return nearest-rank percentile, 'samples' must be sorted
+	 */
+	uint64_t percentile(unsigned p) const
+	{
+		unsigned const rank = (p*num + 99)/100;
+		return samples[rank ? rank - 1 : 0];
+	}
+
+	void sort()
+	{
+		for (unsigned i = 1; i < num; i++) {
+			uint64_t const s = samples[i];
+			unsigned j = i;
+			for (; j > 0 && samples[j - 1] > s; j--)
+				samples[j] = samples[j - 1];
+			samples[j] = s;
+		}
+	}
+};
+
+
+class Phases
+{
+	private:
+
+		List<Phase> _phases;
+		Phase      *_last = nullptr;
+
+	public:
+
+		Phase &lookup(char const *name)
+		{
+			for (Phase *p = _phases.first(); p; p = p->next())
+				if (!strcmp(p->name, name))
+					return *p;
+
+			/* keep phases in the order of their first occurrence */
+			Phase *phase = new (env()->heap()) Phase(name);
+			_phases.insert(phase, _last);
+			_last = phase;
+			return *phase;
+		}
+
+		Phase &lookup(char const *from, char const *to)
+		{
+			char name[sizeof(Phase::name)];
+			snprintf(name, sizeof(name), "%s -> %s", from, to);
+			return lookup(name);
+		}
+
+		template <typename FN>
+		void for_each(FN const &fn)
+		{
+			for (Phase *p = _phases.first(); p; p = p->next())
+				fn(*p);
+		}
+};
+
+
+/**
+ * Account the checkpoints of each complete startup to the phases
+ *
+ * Within a startup, only the first occurrence of each checkpoint is
+ * considered. E.g., for the 'session' checkpoints, only the first request
+ * for each service marks a phase. Checkpoints tagged with an object other
+ * than the one of the start checkpoint belong to another child.
+ */
+static void analyze(Checkpoints const &checkpoints, unsigned runs, Phases &phases)
+{
+	enum { MAX_PER_RUN = 32 };
+	Checkpoints::Checkpoint const *run[MAX_PER_RUN];
+	unsigned num = 0, completed = 0;
+	unsigned long object = 0;
+
+	auto account_run = [&] ()
+	{
+		for (unsigned i = 1; i < num; i++)
+			phases.lookup(run[i - 1]->name, run[i]->name)
+			      .add(run[i]->timestamp - run[i - 1]->timestamp);
+
+		if (num > 1)
+			phases.lookup("total")
+			      .add(run[num - 1]->timestamp - run[0]->timestamp);
+		completed++;
+	};
+
+	checkpoints.for_each([&] (Checkpoints::Checkpoint const &c) {
+
+		if (checkpoints.is_start(c)) {
+			if (num && completed < runs)
+				account_run();
+			num    = 0;
+			object = c.object;
+		}
+
+		/* ignore checkpoints before the first startup */
+		if (!num && !checkpoints.is_start(c))
+			return;
+
+		if (c.object && c.object != object)
+			return;
+
+		for (unsigned i = 0; i < num; i++)
+			if (!strcmp(run[i]->name, c.name))
+				return;
+
+		if (num < MAX_PER_RUN)
+			run[num++] = &c;
+	});
+}
+
+
+/**
+ * Determine the cycle-counter frequency using the timer
+ */
+static unsigned long cycles_per_us(Timer::Connection &timer)
+{
+	enum { DURATION_MS = 200 };
+
+	unsigned long  const start_ms = timer.elapsed_ms();
+	Trace::Timestamp const start  = Trace::timestamp();
+
+	timer.msleep(DURATION_MS);
+
+	uint64_t      const cycles = Trace::timestamp() - start;
+	unsigned long const ms     = max(timer.elapsed_ms() - start_ms, 1UL);
+
+	return max((unsigned long)(cycles/(ms*1000)), 1UL);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- test-startup_profile started ---\n");
+
+	enum { MAX_LABEL_LEN = 128, MAX_SUBJECTS = 512, MAX_TRACED = 128,
+	       BUFFER_SIZE = 16*1024, POLL_MS = 10 };
+
+	Xml_node const config_node = Genode::config()->xml_node();
+
+	char parent[MAX_LABEL_LEN], child[MAX_LABEL_LEN], start[MAX_LABEL_LEN];
+	config_node.attribute("parent").value(parent, sizeof(parent));
+	config_node.attribute("child").value(child, sizeof(child));
+	strncpy(start, "create", sizeof(start));
+	try { config_node.attribute("start").value(start, sizeof(start)); }
+	catch (Xml_node::Nonexistent_attribute) { }
+
+	unsigned const runs = config_node.attribute_value("runs", 10U);
+
+	static Timer::Connection timer;
+
+	static Trace::Connection trace(1024*1024 + MAX_TRACED*BUFFER_SIZE,
+	                               MAX_SUBJECTS*sizeof(Trace::Subject_id), 0);
+
+	/* load policy module */
+	static Rom_connection policy_rom("startup");
+	Dataspace_capability const policy_rom_ds = policy_rom.dataspace();
+	size_t const policy_size = Dataspace_client(policy_rom_ds).size();
+
+	Trace::Policy_id const policy_id = trace.alloc_policy(policy_size);
+	{
+		Dataspace_capability const ds = trace.policy(policy_id);
+		void *dst = env()->rm_session()->attach(ds);
+		void *src = env()->rm_session()->attach(policy_rom_ds);
+		memcpy(dst, src, policy_size);
+		env()->rm_session()->detach(dst);
+		env()->rm_session()->detach(src);
+	}
+
+	/* trace threads created from now on, those of the child in particular */
+	trace.rule(Session_label(parent), Trace::Thread_name(), policy_id,
+	           BUFFER_SIZE);
+
+	static Checkpoints checkpoints(start, child);
+	List<Subject_monitor> monitors;
+
+	auto lookup = [&] (Trace::Subject_id id) -> Subject_monitor * {
+		for (Subject_monitor *m = monitors.first(); m; m = m->next())
+			if (m->id().id == id.id)
+				return m;
+		return nullptr;
+	};
+
+	while (checkpoints.num_starts() <= runs && !checkpoints.full()) {
+
+		static Trace::Subject_id subjects[MAX_SUBJECTS];
+		size_t const num_subjects = trace.subjects(subjects, MAX_SUBJECTS);
+
+		for (size_t i = 0; i < num_subjects; i++) {
+
+			Subject_monitor *monitor = lookup(subjects[i]);
+
+			if (monitor && monitor->released())
+				continue;
+
+			Trace::Subject_info const info = trace.subject_info(subjects[i]);
+
+			if (!monitor) {
+				if (!label_matches(parent, info.session_label().string()))
+					continue;
+
+				/* subjects traced by the rule, which may have vanished already */
+				bool const traced = info.policy_id().id == policy_id.id
+				                 && (info.state() == Trace::Subject_info::TRACED
+				                  || info.state() == Trace::Subject_info::DEAD);
+
+				if (!traced && info.state() != Trace::Subject_info::UNTRACED)
+					continue;
+
+				try {
+					/* subjects that existed before installing the rule */
+					if (!traced)
+						trace.trace(subjects[i].id, policy_id, BUFFER_SIZE);
+
+					monitor = new (env()->heap())
+						Subject_monitor(subjects[i], trace.buffer(subjects[i]));
+					monitors.insert(monitor);
+
+				} catch (...) {
+					PWRN("could not trace thread \"%s\" of \"%s\"",
+					     info.thread_name().string(),
+					     info.session_label().string());
+					continue;
+				}
+			}
+
+			monitor->read(checkpoints);
+
+			/* release the buffer of a vanished thread after reading it */
+			if (info.state() == Trace::Subject_info::DEAD) {
+				if (monitor->lost())
+					PWRN("lost %lu events of \"%s\"", monitor->lost(),
+					     info.session_label().string());
+				monitor->release();
+				trace.free(subjects[i]);
+			}
+		}
+
+		timer.msleep(POLL_MS);
+	}
+
+	unsigned long const cycles_us = cycles_per_us(timer);
+
+	checkpoints.sort();
+
+	static Phases phases;
+	analyze(checkpoints, runs, phases);
+
+	printf("startup phases of \"%s\" in microseconds (%u runs):\n", child, runs);
+
+	phases.for_each([&] (Phase &p) {
+		p.sort();
+
+		auto us = [&] (uint64_t cycles) { return (unsigned long)(cycles/cycles_us); };
+
+		printf("phase: %s n=%u min=%lu p50=%lu p90=%lu p99=%lu max=%lu\n",
+		       p.name, p.num, us(p.samples[0]), us(p.percentile(50)),
+		       us(p.percentile(90)), us(p.percentile(99)),
+		       us(p.samples[p.num - 1]));
+	});
+
+	printf("--- test-startup_profile finished ---\n");
+	return 0;
+}
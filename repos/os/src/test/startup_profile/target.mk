@@ -0,0 +1,3 @@
+TARGET = test-startup_profile
+SRC_CC = main.cc
+LIBS  += base config
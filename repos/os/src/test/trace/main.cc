@@ -13,6 +13,7 @@
  */
 
 /* Genode includes */
+#include <base/trace/event_header.h>
 #include <trace_session/connection.h>
 #include <timer_session/connection.h>
 #include <os/config.h>
@@ -67,12 +68,18 @@ class Trace_buffer_monitor
 
 		Trace::Subject_id     _id;
 		Trace::Buffer        *_buffer;
-		Trace::Buffer::Entry _curr_entry;
+		Trace::Buffer::Cursor _cursor;
 
 		const char *_terminate_entry(Trace::Buffer::Entry const &entry)
 		{
-			size_t len = min(entry.length() + 1, MAX_ENTRY_BUF);
-			memcpy(_buf, entry.data(), len);
+			if (entry.length() < sizeof(Trace::Event_header))
+				return nullptr;
+
+			Trace::Event_header const header =
+				Trace::Event_header::read(entry.data());
+
+			size_t len = min((size_t)header.length + 1, (size_t)MAX_ENTRY_BUF);
+			memcpy(_buf, Trace::Event_header::payload(entry.data()), len);
 			_buf[len-1] = '\0';
 
 			return _buf;
@@ -83,8 +90,7 @@ class Trace_buffer_monitor
 		Trace_buffer_monitor(Trace::Subject_id id, Dataspace_capability ds_cap)
 		:
 			_id(id),
-			_buffer(env()->rm_session()->attach(ds_cap)),
-			_curr_entry(_buffer->first())
+			_buffer(env()->rm_session()->attach(ds_cap))
 		{
 			PLOG("monitor subject:%d buffer:0x%lx", _id.id, (addr_t)_buffer);
 		}
@@ -102,18 +108,17 @@ class Trace_buffer_monitor
 			PLOG("overflows: %u", _buffer->wrapped());
 
 			PLOG("read all remaining events");
-			for (; !_curr_entry.last(); _curr_entry = _buffer->next(_curr_entry)) {
-				/* omit empty entries */
-				if (_curr_entry.length() == 0)
-					continue;
+			for (Trace::Buffer::Entry entry = _buffer->peek(_cursor); !entry.last();
+			     entry = _buffer->peek(_cursor)) {
+
+				const char *data = _terminate_entry(entry);
 
-				const char *data = _terminate_entry(_curr_entry);
-				if (data)
+				/* skip entries overwritten while being read */
+				if (_buffer->advance(_cursor, entry) && data)
 					PLOG("%s", data);
 			}
 
-			/* reset after we read all available entries */
-			_curr_entry = _buffer->first();
+			PLOG("lost events: %lu", _cursor.lost());
 		}
 };
 
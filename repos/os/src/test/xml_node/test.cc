@@ -5,7 +5,9 @@
  */
 
 #include <util/xml_node.h>
+#include <util/xml_index.h>
 #include <base/printf.h>
+#include <base/env.h>
 
 using namespace Genode;
 
@@ -275,6 +277,17 @@ static void print_xml_info(const char *xml_string)
 }
 
 
+static void print_indexed_xml_info(const char *xml_string)
+{
+	try {
+		Xml_index index(*env()->heap(), xml_string, strlen(xml_string));
+		print_xml_node_info(index.xml());
+	} catch (Xml_node::Invalid_syntax) {
+		printf("string has invalid XML syntax\n");
+	}
+}
+
+
 int main()
 {
 	printf("--- XML-token test ---\n");
@@ -312,6 +325,26 @@ int main()
 	printf("-- Test parsing XML with comments --\n");
 	print_xml_info(xml_test_comments);
 
+	printf("-- Test indexed XML structure --\n");
+	print_indexed_xml_info(xml_test_valid);
+	print_indexed_xml_info(xml_test_attributes);
+	print_indexed_xml_info(xml_test_text_between_nodes);
+	print_indexed_xml_info(xml_test_comments);
+	print_indexed_xml_info(xml_test_truncated);
+
+	printf("-- Test node access by key via index --\n");
+	{
+		Xml_index index(*env()->heap(), xml_test_valid, strlen(xml_test_valid));
+		Xml_node prg(index.xml().sub_node(1U));
+		print_key(prg, "filename");
+		print_key(prg, "quota");
+		print_key(prg, "info");
+
+		try { index.xml().sub_node(3U); }
+		catch (Xml_node::Nonexistent_sub_node) {
+			printf("sub node 3 is not defined\n"); }
+	}
+
 	printf("--- End of XML-parser test ---\n");
 	return 0;
 }
@@ -107,14 +107,17 @@ namespace L4lx {
 
 		Local_addr attach(Genode::Dataspace_capability ds, size_t size, off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable) override
+		                  bool executable, bool copy_on_write,
+		                  bool populate) override
 		{
 			return retry<Genode::Region_map::Out_of_metadata>(
 				[&] () {
 					return Genode::Region_map_client::attach(ds, size, offset,
 					                                         use_local_addr,
 					                                         local_addr,
-					                                         executable); },
+					                                         executable,
+					                                         copy_on_write,
+					                                         populate); },
 				[&] () {
 					Genode::env()->parent()->upgrade(Rm_connection::cap(), "ram_quota=8K");
 				});
@@ -86,6 +86,7 @@ namespace Noux {
 			SYSCALL_SYNC,
 			SYSCALL_KILL,
 			SYSCALL_GETDTABLESIZE,
+			SYSCALL_SPLICE,
 			SYSCALL_INVALID = -1
 		};
 
@@ -136,6 +137,7 @@ namespace Noux {
 			NOUX_DECL_SYSCALL_NAME(SYNC)
 			NOUX_DECL_SYSCALL_NAME(KILL)
 			NOUX_DECL_SYSCALL_NAME(GETDTABLESIZE)
+			NOUX_DECL_SYSCALL_NAME(SPLICE)
 			case SYSCALL_INVALID: return 0;
 			}
 			return 0;
@@ -51,6 +51,16 @@ namespace Noux {
 		enum { CHUNK_SIZE = 11*1024 };
 		typedef char Chunk[CHUNK_SIZE];
 
+		/*
+		 * Transfers larger than 'CHUNK_SIZE' may refer to the payload
+		 * buffer in the memory of the Noux process via the 'buf' argument
+		 * of the 'read' and 'write' syscalls. If the buffer is backed by a
+		 * RAM dataspace, the Noux server accesses it directly, which
+		 * replaces the copying of the payload through the chunk with a
+		 * single syscall. Otherwise, the server reports 'direct' as false
+		 * and the process falls back to the transfer via the chunk.
+		 */
+
 		enum { ARGS_MAX_LEN = 5*1024 };
 		typedef char Args[ARGS_MAX_LEN];
 
@@ -354,6 +364,9 @@ namespace Noux {
 
 		enum Kill_error      { KILL_ERR_SRCH };
 
+		enum Splice_error    { SPLICE_ERR_INVALID = Vfs::Directory_service::NUM_GENERAL_ERRORS,
+		                       SPLICE_ERR_INTERRUPT, SPLICE_ERR_IO };
+
 		union {
 			Vfs::Directory_service::General_error   general;
 			Vfs::Directory_service::Stat_result     stat;
@@ -384,13 +397,14 @@ namespace Noux {
 			Wait4_error    wait4;
 			Kill_error     kill;
 			Fork_error     fork;
+			Splice_error   splice;
 
 		} error;
 
 		union {
 
-			SYSIO_DECL(write,       { int fd; size_t count; Chunk chunk; },
-			                        { size_t count; });
+			SYSIO_DECL(write,       { int fd; size_t count; addr_t buf; Chunk chunk; },
+			                        { size_t count; bool direct; });
 
 			SYSIO_DECL(stat,        { Path path; }, { Stat st; });
 
@@ -414,8 +428,8 @@ namespace Noux {
 
 			SYSIO_DECL(dirent,      { int fd; }, { Dirent entry; });
 
-			SYSIO_DECL(read,        { int fd; size_t count; },
-			                        { Chunk chunk; size_t count; });
+			SYSIO_DECL(read,        { int fd; size_t count; addr_t buf; },
+			                        { Chunk chunk; size_t count; bool direct; });
 
 			SYSIO_DECL(readlink,    { Path path; size_t bufsiz; },
 			                        { Chunk chunk; size_t count; });
@@ -502,6 +516,9 @@ namespace Noux {
 			SYSIO_DECL(kill,        { int pid; Signal sig; }, { });
 
 			SYSIO_DECL(getdtablesize, { }, { int n; });
+
+			SYSIO_DECL(splice,      { int fd_in; int fd_out; size_t count; },
+			                        { size_t count; });
 		};
 	};
 };
@@ -59,7 +59,8 @@ Region_map::Local_addr
 Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
                              off_t offset, bool use_local_addr,
                              Region_map::Local_addr local_addr,
-                             bool executable)
+                             bool executable, bool copy_on_write,
+                             bool populate)
 {
 	if (verbose)
 		PDBG("size = %zd, offset = %x", size, (unsigned int)offset);
@@ -80,7 +81,8 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 
 	void *addr = _parent_region_map.attach(ds_cap, size, offset,
 	                                       use_local_addr, local_addr,
-	                                       executable);
+	                                       executable, copy_on_write,
+	                                       populate);
 
 	Lock::Guard lock_guard(_region_map_lock);
 	_region_map.insert(new (env()->heap()) Region(addr, (void*)((addr_t)addr + size - 1), ds_cap, offset));
@@ -99,7 +99,8 @@ namespace Gdb_monitor {
 			 **************************************/
 
 			Local_addr       attach        (Dataspace_capability, Genode::size_t,
-			                                Genode::off_t, bool, Local_addr, bool) override;
+			                                Genode::off_t, bool, Local_addr, bool,
+			                                bool, bool) override;
 			void             detach        (Local_addr) override;
 			void             fault_handler (Signal_context_capability) override;
 			State            state         () override;
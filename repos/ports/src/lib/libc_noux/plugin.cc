@@ -506,6 +506,43 @@ extern "C" int select(int nfds, fd_set *readfds, fd_set *writefds,
 }
 
 
+/**
+ * Move data between a pipe and another file descriptor
+ *
+ * The data is moved by Noux without passing a user buffer. The interface
+ * follows the one of Linux but neither offsets nor flags are supported.
+ */
+extern "C" ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+                          size_t len, unsigned int flags)
+{
+	if (off_in || off_out) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sysio()->splice_in.fd_in  = fd_in;
+	sysio()->splice_in.fd_out = fd_out;
+	sysio()->splice_in.count  = len;
+
+	if (!noux_syscall(Noux::Session::SYSCALL_SPLICE)) {
+		switch (sysio()->error.splice) {
+		case Noux::Sysio::SPLICE_ERR_INVALID:   errno = EINVAL; break;
+		case Noux::Sysio::SPLICE_ERR_INTERRUPT: errno = EINTR;  break;
+		case Noux::Sysio::SPLICE_ERR_IO:        errno = EIO;    break;
+		default:
+			if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
+				errno = EBADF;
+			else
+				errno = 0;
+			break;
+		}
+		return -1;
+	}
+
+	return sysio()->splice_out.count;
+}
+
+
 #include <setjmp.h>
 
 
@@ -1198,13 +1235,22 @@ namespace {
 		int const orig_count = count;
 
 		char *src = (char *)buf;
+
+		/* let Noux access large buffers directly if possible */
+		bool direct = count > Noux::Sysio::CHUNK_SIZE;
+
 		while (count > 0) {
 
-			Genode::size_t curr_count = Genode::min((::size_t)Noux::Sysio::CHUNK_SIZE, count);
+			Genode::size_t curr_count = direct
+			                          ? count
+			                          : Genode::min((::size_t)Noux::Sysio::CHUNK_SIZE, count);
 
 			sysio()->write_in.fd = noux_fd(fd->context);
 			sysio()->write_in.count = curr_count;
-			Genode::memcpy(sysio()->write_in.chunk, src, curr_count);
+			sysio()->write_in.buf = direct ? (Genode::addr_t)src : 0;
+
+			if (!direct)
+				Genode::memcpy(sysio()->write_in.chunk, src, curr_count);
 
 			if (!noux_syscall(Noux::Session::SYSCALL_WRITE)) {
 				switch (sysio()->error.write) {
@@ -1220,6 +1266,11 @@ namespace {
 						errno = 0;
 					break;
 				}
+			} else if (direct && !sysio()->write_out.direct) {
+
+				/* buffer not accessible by Noux, transfer it via the chunk */
+				direct = false;
+				continue;
 			}
 
 			count -= curr_count;
@@ -1235,13 +1286,18 @@ namespace {
 
 		Genode::size_t sum_read_count = 0;
 
+		/* let Noux access large buffers directly if possible */
+		bool direct = count > Noux::Sysio::CHUNK_SIZE;
+
 		while (count > 0) {
 
-			Genode::size_t curr_count =
-				Genode::min(count, sizeof(sysio()->read_out.chunk));
+			Genode::size_t curr_count = direct
+			                          ? count
+			                          : Genode::min(count, sizeof(sysio()->read_out.chunk));
 
 			sysio()->read_in.fd    = noux_fd(fd->context);
 			sysio()->read_in.count = curr_count;
+			sysio()->read_in.buf   = direct ? (Genode::addr_t)buf + sum_read_count : 0;
 
 			if (!noux_syscall(Noux::Session::SYSCALL_READ)) {
 
@@ -1261,9 +1317,16 @@ namespace {
 				return -1;
 			}
 
-			Genode::memcpy((char*)buf + sum_read_count,
-			               sysio()->read_out.chunk,
-			               sysio()->read_out.count);
+			if (!sysio()->read_out.direct) {
+
+				/* buffer not accessible by Noux, data went through the chunk */
+				direct     = false;
+				curr_count = Genode::min(curr_count, sizeof(sysio()->read_out.chunk));
+
+				Genode::memcpy((char*)buf + sum_read_count,
+				               sysio()->read_out.chunk,
+				               sysio()->read_out.count);
+			}
 
 			sum_read_count += sysio()->read_out.count;
 
@@ -326,6 +326,40 @@ namespace Noux {
 				io->unregister_wake_up_notifier(&notifier);
 			}
 
+			/**
+			 * Call 'fn' with a local pointer to the memory of the process
+			 *
+			 * \param write  true if 'fn' modifies the memory
+			 *
+			 * \return false if the memory cannot be accessed directly
+			 */
+			template <typename FN>
+			bool _with_process_memory(addr_t addr, size_t len, bool write,
+			                          FN const &fn)
+			{
+				Dataspace_capability ds;
+				addr_t               offset = 0;
+
+				if (!len || !_pd.lookup_ram_range(addr, len, write, ds, offset))
+					return false;
+
+				addr_t const ds_offset   = offset & PAGE_MASK;
+				addr_t const page_offset = offset - ds_offset;
+				size_t const size = PAGE_MASK & (page_offset + len + PAGE_SIZE - 1);
+
+				char *local = 0;
+				try {
+					local = env()->rm_session()->attach(ds, size, ds_offset);
+				} catch (...) {
+					return false;
+				}
+
+				fn(local + page_offset);
+
+				env()->rm_session()->detach(local);
+				return true;
+			}
+
 			Vfs::Dir_file_system * const root_dir() { return _elf._root_dir; }
 
 			/**
@@ -393,7 +427,7 @@ namespace Noux {
 				_destruct_context_cap(sig_rec->manage(&_destruct_dispatcher)),
 				_cap_session(cap_session),
 				_entrypoint(cap_session, STACK_SIZE, "noux_process", false),
-				_pd(binary_name, resources_ep, _ds_registry),
+				_pd(binary_name, resources_ep, _ds_registry, *sig_rec),
 				_resources(binary_name, resources_ep, _ds_registry, _pd.core_pd_cap(), false),
 				_initial_thread(_resources.cpu, _pd.cap(), binary_name),
 				_args(ARGS_DS_SIZE, args),
@@ -477,6 +511,9 @@ namespace Noux {
 			Pd_session_capability  pd()  const { return _pd.cap(); }
 			Dataspace_registry &ds_registry()  { return _ds_registry; }
 
+			Ram_session_component &ram_session_component() { return _resources.ram; }
+			Pd_session_component  &pd_session_component()  { return _pd; }
+
 
 			/****************************
 			 ** Noux session interface **
@@ -586,6 +623,8 @@ namespace Noux {
 			{
 				Lock::Guard signal_lock_guard(signal_lock());
 
+				checkpoint("create", filename);
+
 				Child *child = new Child(filename,
 				                         _ldso_ds,
 					                     _parent_exit,
@@ -604,6 +643,8 @@ namespace Noux {
 					                     _destruct_queue,
 					                     verbose);
 
+				checkpoint("loaded", filename);
+
 				_assign_io_channels_to(child);
 
 				/* move the signal queue */
@@ -625,6 +666,7 @@ namespace Noux {
 				Genode::Signal_transmitter(_destruct_context_cap).submit();
 
 				/* start executing the new process */
+				checkpoint("start", filename);
 				child->start();
 
 				/* this child will be removed by the execve_finalization_dispatcher */
@@ -96,6 +96,8 @@ namespace Noux {
 			{
 				Service *service = 0;
 
+				_family_member.checkpoint("session", service_name);
+
 				/* check for local ROM file requests */
 				if ((service = _args_policy.resolve_session_request(service_name, args))
 				 || (service = _env_policy.resolve_session_request(service_name, args))
@@ -22,6 +22,7 @@ namespace Noux {
 
 	class Dataspace_registry;
 	class Dataspace_info;
+	class Ram_session_component;
 
 
 	struct Dataspace_user : List<Dataspace_user>::Element
@@ -82,8 +83,13 @@ namespace Noux {
 			}
 
 			/**
-			 * Create shadow copy of dataspace
+			 * Provide dataspace to a forked process
 			 *
+			 * RAM dataspaces are not copied but shared with the new
+			 * process until one of the processes writes to them (see
+			 * 'shared' and 'copy').
+			 *
+			 * \param ram          RAM session of the new process
 			 * \param ds_registry  registry for keeping track of
 			 *                     the new dataspace
 			 * \param ep           entrypoint used to serve the RPC
@@ -92,10 +98,38 @@ namespace Noux {
 			 *                     RM session)
 			 * \return             capability for the new dataspace
 			 */
-			virtual Dataspace_capability fork(Ram_session_capability ram,
+			virtual Dataspace_capability fork(Ram_session_component &ram,
 			                                  Dataspace_registry    &ds_registry,
 			                                  Rpc_entrypoint        &ep) = 0;
 
+			/**
+			 * Return true if the dataspace is shared with other processes
+			 *
+			 * Regions of shared dataspaces are attached copy-on-write.
+			 */
+			virtual bool shared() const { return false; }
+
+			/**
+			 * Create private copy of a part of the dataspace
+			 *
+			 * The copy is accounted to the process that owns the dataspace.
+			 *
+			 * \param offset  page-aligned offset within the dataspace
+			 * \param size    size of the copy in bytes
+			 * \return        capability of the copy, or an invalid
+			 *                capability if the copy could not be created
+			 */
+			virtual Dataspace_capability copy(addr_t offset, size_t size)
+			{
+				return Dataspace_capability();
+			}
+
+			/**
+			 * Return true if Noux may access the dataspace content on
+			 * behalf of the process
+			 */
+			virtual bool accessible() const { return false; }
+
 			/**
 			 * Write raw byte sequence into dataspace
 			 *
@@ -164,7 +198,7 @@ namespace Noux {
 			_ds_registry.apply(ds_cap(), lambda);
 		}
 
-		Dataspace_capability fork(Ram_session_capability,
+		Dataspace_capability fork(Ram_session_component &,
 		                          Dataspace_registry &,
 		                          Rpc_entrypoint &)
 		{
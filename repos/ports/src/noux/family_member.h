@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <util/list.h>
 #include <base/lock.h>
+#include <base/trace/events.h>
 
 /* Noux includes */
 #include <parent_exit.h>
@@ -56,6 +57,17 @@ namespace Noux {
 
 			int exit_status() const { return _exit_status; }
 
+			/**
+			 * Take startup checkpoint on behalf of the process
+			 *
+			 * The checkpoint is tagged with the PID, which is retained by
+			 * 'execve'. So the checkpoints taken by the process that calls
+			 * 'execve' refer to the same object as those taken for the
+			 * new program.
+			 */
+			void checkpoint(char const *name, char const *detail) const {
+				Trace::Checkpoint(name, detail, (void const *)(addr_t)_pid); }
+
 			/**
 			 * Called by the parent at creation time of the process
 			 */
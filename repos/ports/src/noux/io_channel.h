@@ -73,8 +73,60 @@ namespace Noux {
 
 			virtual Io_channel_backend* backend() { return 0; }
 
-			virtual bool     write(Sysio *sysio, size_t &offset) { return false; }
-			virtual bool      read(Sysio *sysio)                 { return false; }
+			/**
+			 * Write data to channel
+			 *
+			 * The payload is located either in the chunk of 'sysio' or
+			 * directly in the memory of the Noux process.
+			 *
+			 * \param src     payload
+			 * \param count   size of payload in bytes
+			 * \param offset  number of bytes written so far, updated by
+			 *                the channel
+			 */
+			virtual bool write(Sysio *sysio, char const *src, size_t count,
+			                   size_t &offset) { return false; }
+
+			/**
+			 * Read data from channel
+			 *
+			 * The number of bytes read is returned via
+			 * 'sysio->read_out.count'.
+			 *
+			 * \param dst    destination buffer, either the chunk of 'sysio'
+			 *               or the memory of the Noux process
+			 * \param count  maximum number of bytes to read
+			 */
+			virtual bool read(Sysio *sysio, char *dst, size_t count) { return false; }
+
+			/**
+			 * Return true if the channel supports the splice operations
+			 */
+			virtual bool spliceable() const { return false; }
+
+			/**
+			 * Move data from channel 'src' into this channel
+			 *
+			 * The data is transferred without an intermediate copy. The
+			 * 'src' channel is not spliceable.
+			 *
+			 * \param count      maximum number of bytes to transfer
+			 * \param out_count  number of bytes transferred
+			 */
+			virtual bool splice_from(Sysio *sysio, Shared_pointer<Io_channel> src,
+			                         size_t count, size_t &out_count) { return false; }
+
+			/**
+			 * Move data from this channel into channel 'dst'
+			 *
+			 * The 'dst' channel is not spliceable.
+			 *
+			 * \param count      maximum number of bytes to transfer
+			 * \param out_count  number of bytes transferred
+			 */
+			virtual bool splice_to(Sysio *sysio, Shared_pointer<Io_channel> dst,
+			                       size_t count, size_t &out_count) { return false; }
+
 			virtual bool     fstat(Sysio *sysio)                 { return false; }
 			virtual bool ftruncate(Sysio *sysio)                 { return false; }
 			virtual bool     fcntl(Sysio *sysio)                 { return false; }
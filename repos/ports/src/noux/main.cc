@@ -46,6 +46,10 @@
 static const bool verbose_quota  = false;
 static bool trace_syscalls = false;
 static bool verbose = false;
+static Genode::size_t pipe_capacity = Noux::Pipe::MAX_CAPACITY;
+
+/* memory available for the buffers of all pipes */
+static Noux::Pipe_budget pipe_budget(16*1024*1024);
 
 namespace Noux {
 
@@ -165,46 +169,82 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_WRITE:
 			{
+				int    const fd       = _sysio->write_in.fd;
 				size_t const count_in = _sysio->write_in.count;
+				addr_t const buf      = _sysio->write_in.buf;
 
-				for (size_t offset = 0; offset != count_in; ) {
+				auto write_payload = [&] (char const *src, size_t count)
+				{
+					for (size_t offset = 0; offset != count; ) {
 
-					Shared_pointer<Io_channel> io = _lookup_channel(_sysio->write_in.fd);
+						Shared_pointer<Io_channel> io = _lookup_channel(fd);
 
-					if (!io->nonblocking())
-						_block_for_io_channel(io, false, true, false);
+						if (!io->nonblocking())
+							_block_for_io_channel(io, false, true, false);
 
-					if (io->check_unblock(false, true, false)) {
-						/*
-						 * 'io->write' is expected to update
-						 * '_sysio->write_out.count' and 'offset'
-						 */
-						result = io->write(_sysio, offset);
-						if (result == false)
+						if (io->check_unblock(false, true, false)) {
+							/*
+							 * 'io->write' is expected to update
+							 * '_sysio->write_out.count' and 'offset'
+							 */
+							result = io->write(_sysio, src, count, offset);
+							if (result == false)
+								break;
+						} else {
+							if (result == false) {
+								/* nothing was written yet */
+								_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INTERRUPT;
+							}
 							break;
-					} else {
-						if (result == false) {
-							/* nothing was written yet */
-							_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INTERRUPT;
 						}
-						break;
 					}
+				};
+
+				if (!buf) {
+					write_payload(_sysio->write_in.chunk,
+					              min(count_in, sizeof(_sysio->write_in.chunk)));
+					break;
 				}
+
+				/* transfer payload directly from the memory of the process */
+				bool const direct =
+					_with_process_memory(buf, count_in, false, [&] (char *src) {
+						write_payload(src, count_in); });
+
+				if (!direct) {
+					_sysio->write_out.count = 0;
+					result = true;
+				}
+				_sysio->write_out.direct = direct;
 				break;
 			}
 
 		case SYSCALL_READ:
 			{
-				Shared_pointer<Io_channel> io = _lookup_channel(_sysio->read_in.fd);
+				int    const fd    = _sysio->read_in.fd;
+				size_t const count = _sysio->read_in.count;
+				addr_t const buf   = _sysio->read_in.buf;
+
+				Shared_pointer<Io_channel> io = _lookup_channel(fd);
 
 				if (!io->nonblocking())
 					_block_for_io_channel(io, true, false, false);
 
-				if (io->check_unblock(true, false, false))
-					result = io->read(_sysio);
-				else
+				if (!io->check_unblock(true, false, false)) {
 					_sysio->error.read = Vfs::File_io_service::READ_ERR_INTERRUPT;
+					break;
+				}
+
+				/* transfer payload directly into the memory of the process */
+				bool const direct = buf &&
+					_with_process_memory(buf, count, true, [&] (char *dst) {
+						result = io->read(_sysio, dst, count); });
+
+				if (!direct)
+					result = io->read(_sysio, _sysio->read_out.chunk,
+					                  min(count, sizeof(_sysio->read_out.chunk)));
 
+				_sysio->read_out.direct = direct;
 				break;
 			}
 
@@ -345,6 +385,8 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_EXECVE:
 			{
+				checkpoint("execve", _sysio->execve_in.filename);
+
 				/*
 				 * We have to check the dataspace twice because the binary
 				 * could be a script that uses an interpreter which maybe
@@ -626,7 +668,8 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 				_assign_io_channels_to(child);
 
 				/* copy our address space into the new child */
-				_pd.replay(child->ram(), child->pd(),
+				_pd.replay(child->ram_session_component(),
+				           child->pd_session_component(),
 				           child->ds_registry(), _resources.ep);
 
 				/* start executing the main thread of the new process */
@@ -675,7 +718,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_PIPE:
 			{
-				Shared_pointer<Pipe> pipe(new Pipe, Genode::env()->heap());
+				Shared_pointer<Pipe> pipe(new Pipe(pipe_budget, pipe_capacity), Genode::env()->heap());
 
 				Shared_pointer<Io_channel> pipe_sink(new Pipe_sink_io_channel(pipe, *_sig_rec),
 				                                     Genode::env()->heap());
@@ -689,6 +732,44 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 				break;
 			}
 
+		case SYSCALL_SPLICE:
+			{
+				Shared_pointer<Io_channel> in  = _lookup_channel(_sysio->splice_in.fd_in);
+				Shared_pointer<Io_channel> out = _lookup_channel(_sysio->splice_in.fd_out);
+
+				size_t const count = _sysio->splice_in.count;
+
+				/* one of both channels must be a pipe */
+				if (in->spliceable() == out->spliceable()) {
+					_sysio->error.splice = Sysio::SPLICE_ERR_INVALID;
+					break;
+				}
+
+				if (!in->nonblocking())
+					_block_for_io_channel(in, true, false, false);
+
+				if (!out->nonblocking())
+					_block_for_io_channel(out, false, true, false);
+
+				if (!in->check_unblock(true, false, false)
+				 || !out->check_unblock(false, true, false)) {
+					_sysio->error.splice = Sysio::SPLICE_ERR_INTERRUPT;
+					break;
+				}
+
+				size_t out_count = 0;
+				result = out->spliceable()
+				       ? out->splice_from(_sysio, in, count, out_count)
+				       : in->splice_to(_sysio, out, count, out_count);
+
+				if (result)
+					_sysio->splice_out.count = out_count;
+				else
+					_sysio->error.splice = Sysio::SPLICE_ERR_IO;
+
+				break;
+			}
+
 		case SYSCALL_DUP2:
 			{
 				int fd = add_io_channel(io_channel_by_fd(_sysio->dup2_in.fd),
@@ -1147,6 +1228,12 @@ int main(int argc, char **argv)
 	/* obtain global configuration */
 	trace_syscalls = config()->xml_node().attribute_value("trace_syscalls", trace_syscalls);
 	verbose        = config()->xml_node().attribute_value("verbose", verbose);
+	pipe_capacity  = config()->xml_node().attribute_value("pipe_capacity",
+	                                                      Number_of_bytes(pipe_capacity));
+
+	if (config()->xml_node().has_attribute("pipe_quota"))
+		pipe_budget.limit(config()->xml_node().attribute_value("pipe_quota",
+		                                                       Number_of_bytes(0)));
 
 	/* register additional file systems to the VFS */
 	Vfs::Global_file_system_factory &fs_factory = Vfs::global_file_system_factory();
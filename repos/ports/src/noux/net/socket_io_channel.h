@@ -69,14 +69,13 @@ namespace Noux {
 			 * Io_channel interface implementation (only needed methods)
 			 */
 
-			bool write(Sysio *sysio, size_t &count)
+			bool write(Sysio *sysio, char const *src, size_t count, size_t &offset)
 			{
-				ssize_t result = ::write(_socket, sysio->write_in.chunk,
-				                         sysio->write_in.count);
+				ssize_t result = ::write(_socket, src + offset, count - offset);
 
 				if (result > -1) {
-					sysio->write_out.count = result;
-					count = result;
+					offset += result;
+					sysio->write_out.count = offset;
 
 					return true;
 				}
@@ -94,11 +93,9 @@ namespace Noux {
 				return false;
 			}
 
-			bool read(Sysio *sysio)
+			bool read(Sysio *sysio, char *dst, size_t count)
 			{
-				size_t const max_count = Genode::min(sysio->read_in.count, sizeof(sysio->read_out.chunk));
-
-				ssize_t result = ::read(_socket, sysio->read_out.chunk, max_count);
+				ssize_t result = ::read(_socket, dst, count);
 
 				if (result > -1) {
 					sysio->read_out.count = result;
@@ -490,14 +487,14 @@ namespace Noux {
 
 			Io_channel_backend *backend() { return _backend; }
 
-			bool write(Sysio *sysio, size_t &count)
+			bool write(Sysio *sysio, char const *src, size_t count, size_t &offset)
 			{
-				return _backend->write(sysio, count);
+				return _backend->write(sysio, src, count, offset);
 			}
 
-			bool read(Sysio *sysio)
+			bool read(Sysio *sysio, char *dst, size_t count)
 			{
-				return _backend->read(sysio);
+				return _backend->read(sysio, dst, count);
 			}
 
 			bool fcntl(Sysio* sysio)
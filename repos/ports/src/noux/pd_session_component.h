@@ -43,12 +43,13 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 		 * Constructor
 		 */
 		Pd_session_component(char const *binary_name,
-		                     Rpc_entrypoint &ep, Dataspace_registry &ds_registry)
+		                     Rpc_entrypoint &ep, Dataspace_registry &ds_registry,
+		                     Signal_receiver &sig_rec)
 		:
 			_ep(ep), _pd(binary_name),
-			_address_space(_ep, ds_registry, _pd, _pd.address_space()),
-			_stack_area   (_ep, ds_registry, _pd, _pd.stack_area()),
-			_linker_area  (_ep, ds_registry, _pd, _pd.linker_area())
+			_address_space(_ep, ds_registry, sig_rec, _pd, _pd.address_space()),
+			_stack_area   (_ep, ds_registry, sig_rec, _pd, _pd.stack_area()),
+			_linker_area  (_ep, ds_registry, sig_rec, _pd, _pd.linker_area())
 		{
 			_ep.manage(this);
 		}
@@ -70,17 +71,21 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 			return _address_space.lookup_region_map(addr);
 		}
 
-		void replay(Ram_session_capability dst_ram,
-		            Capability<Pd_session> dst_pd_cap,
+		bool lookup_ram_range(addr_t addr, size_t len, bool write,
+		                      Dataspace_capability &ds, addr_t &offset)
+		{
+			return _address_space.lookup_ram_range(addr, len, write, ds, offset);
+		}
+
+		void replay(Ram_session_component &dst_ram,
+		            Pd_session_component  &dst_pd,
 		            Dataspace_registry    &ds_registry,
 		            Rpc_entrypoint        &ep)
 		{
-			Pd_session_client dst_pd(dst_pd_cap);
-
 			/* replay region map into new protection domain */
-			_stack_area   .replay(dst_ram, dst_pd.stack_area(),    ds_registry, ep);
-			_linker_area  .replay(dst_ram, dst_pd.linker_area(),   ds_registry, ep);
-			_address_space.replay(dst_ram, dst_pd.address_space(), ds_registry, ep);
+			_stack_area   .replay(dst_ram, dst_pd._stack_area,    ds_registry, ep);
+			_linker_area  .replay(dst_ram, dst_pd._linker_area,   ds_registry, ep);
+			_address_space.replay(dst_ram, dst_pd._address_space, ds_registry, ep);
 
 			Region_map_client dst_address_space(dst_pd.address_space());
 
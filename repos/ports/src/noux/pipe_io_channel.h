@@ -19,17 +19,99 @@
 
 namespace Noux {
 
+	/**
+	 * Limit of the memory used by the buffers of all pipes
+	 *
+	 * The pipe buffers are allocated from the heap of Noux, not from the
+	 * RAM quota of the Noux processes. The budget bounds the amount of
+	 * memory the processes can occupy this way.
+	 */
+	class Pipe_budget
+	{
+		private:
+
+			Lock   _lock;
+			size_t _limit;
+			size_t _used = 0;
+
+		public:
+
+			Pipe_budget(size_t limit) : _limit(limit) { }
+
+			void limit(size_t limit)
+			{
+				Lock::Guard guard(_lock);
+				_limit = limit;
+			}
+
+			/**
+			 * Account 'size' bytes if they fit into the budget
+			 *
+			 * \return true on success
+			 */
+			bool withdraw(size_t size)
+			{
+				Lock::Guard guard(_lock);
+
+				if (_used + size > _limit)
+					return false;
+
+				_used += size;
+				return true;
+			}
+
+			/**
+			 * Account 'size' bytes regardless of the limit
+			 */
+			void charge(size_t size)
+			{
+				Lock::Guard guard(_lock);
+				_used += size;
+			}
+
+			void deposit(size_t size)
+			{
+				Lock::Guard guard(_lock);
+				_used -= min(size, _used);
+			}
+	};
+
+
 	class Pipe : public Reference_counter
 	{
+		public:
+
+			/**
+			 * Bounds of the configurable pipe capacity
+			 */
+			enum { MIN_CAPACITY = 64*1024, MAX_CAPACITY = 1024*1024 };
+
 		private:
 
 			Lock mutable _lock;
 
-			enum { BUFFER_SIZE = 4096 };
-			char _buffer[BUFFER_SIZE];
+			Pipe_budget &_budget;
 
-			unsigned _read_offset;
-			unsigned _write_offset;
+			/*
+			 * Lowered to the current capacity once the buffer cannot grow
+			 * any further
+			 */
+			size_t _max_capacity;
+
+			/*
+			 * The buffer starts with 'MIN_CAPACITY' and grows on demand up
+			 * to '_max_capacity'.
+			 */
+			size_t _capacity;
+			char  *_buffer;
+
+			/*
+			 * The buffer holds '_count' bytes starting at '_read_offset'.
+			 * In contrast to tracking a write offset, this way the whole
+			 * buffer is usable.
+			 */
+			size_t _read_offset = 0;
+			size_t _count       = 0;
 
 			Signal_context_capability _read_ready_sigh;
 			Signal_context_capability _write_ready_sigh;
@@ -39,21 +121,25 @@ namespace Noux {
 			/**
 			 * Return space available in the buffer for writing, in bytes
 			 */
-			size_t _avail_buffer_space() const
-			{
-				if (_read_offset < _write_offset)
-					return (BUFFER_SIZE - _write_offset) + _read_offset - 1;
-
-				if (_read_offset > _write_offset)
-					return _read_offset - _write_offset - 1;
+			size_t _avail_buffer_space() const { return _capacity - _count; }
 
-				/* _read_offset == _write_offset */
-				return BUFFER_SIZE - 1;
+			size_t _write_offset() const
+			{
+				return (_read_offset + _count) % _capacity;
 			}
 
+			/**
+			 * Return true if a writer can proceed
+			 *
+			 * Once the buffer reached its maximum capacity, a blocked writer
+			 * does not proceed before a quarter of the buffer is free. This
+			 * way, the writer is woken up once per batch of data instead of
+			 * once per read operation.
+			 */
 			bool _any_space_avail_for_writing() const
 			{
-				return _avail_buffer_space() > 0;;
+				return (_capacity < _max_capacity)
+				    || (_avail_buffer_space() >= _capacity/4);
 			}
 
 			void _wake_up_reader()
@@ -68,14 +154,130 @@ namespace Noux {
 					Signal_transmitter(_write_ready_sigh).submit();
 			}
 
+			/**
+			 * Grow buffer until 'space' bytes are free or the maximum
+			 * capacity is reached
+			 *
+			 * If the buffer cannot grow because the pipe budget is exhausted
+			 * or the allocation fails, the current capacity becomes the
+			 * maximum. Hence, a writer blocks until the reader frees space
+			 * instead of repeatedly retrying.
+			 */
+			void _grow(size_t space)
+			{
+				size_t capacity = _capacity;
+				while ((capacity - _count < space) && (capacity < _max_capacity))
+					capacity = min(2*capacity, _max_capacity);
+
+				if (capacity == _capacity)
+					return;
+
+				size_t const increase = capacity - _capacity;
+
+				if (!_budget.withdraw(increase)) {
+					_max_capacity = _capacity;
+					return;
+				}
+
+				char *buffer = 0;
+				if (!env()->heap()->alloc(capacity, &buffer)) {
+					_budget.deposit(increase);
+					_max_capacity = _capacity;
+					return;
+				}
+
+				/* linearize the buffer content */
+				size_t const upper_len = min(_count, _capacity - _read_offset);
+				memcpy(buffer, _buffer + _read_offset, upper_len);
+				memcpy(buffer + upper_len, _buffer, _count - upper_len);
+
+				env()->heap()->free(_buffer, _capacity);
+
+				_buffer      = buffer;
+				_capacity    = capacity;
+				_read_offset = 0;
+			}
+
+			/**
+			 * Let 'fn' fill the contiguous free space at the write offset
+			 *
+			 * \return number of bytes stored by 'fn'
+			 */
+			template <typename FN>
+			size_t _produce(size_t len, FN const &fn)
+			{
+				size_t const write_offset = _write_offset();
+				size_t const space =
+					min(len, min(_avail_buffer_space(), _capacity - write_offset));
+
+				if (!space)
+					return 0;
+
+				size_t const n = min(space, (size_t)fn(_buffer + write_offset, space));
+
+				/* wake up reader who may block for incoming data */
+				if (!_count && n)
+					_wake_up_reader();
+
+				_count += n;
+				return n;
+			}
+
+			/**
+			 * Let 'fn' consume the contiguous data at the read offset
+			 *
+			 * \return number of bytes consumed by 'fn'
+			 */
+			template <typename FN>
+			size_t _consume(size_t len, FN const &fn)
+			{
+				size_t const avail = min(len, min(_count, _capacity - _read_offset));
+
+				if (!avail)
+					return 0;
+
+				size_t const n = min(avail, (size_t)fn(_buffer + _read_offset, avail));
+
+				bool const writer_was_blocked = !_any_space_avail_for_writing();
+
+				_count      -= n;
+				_read_offset = _count ? (_read_offset + n) % _capacity : 0;
+
+				if (writer_was_blocked && _any_space_avail_for_writing())
+					_wake_up_writer();
+
+				return n;
+			}
+
 		public:
 
-			Pipe()
-			: _read_offset(0), _write_offset(0), _writer_is_gone(false) { }
+			/**
+			 * Constructor
+			 *
+			 * \param budget        budget for the buffers of all pipes, the
+			 *                      initial buffer is accounted regardless
+			 *                      of the limit
+			 * \param max_capacity  maximum size of the pipe buffer, clipped
+			 *                      to the range of 'MIN_CAPACITY' to
+			 *                      'MAX_CAPACITY'
+			 */
+			Pipe(Pipe_budget &budget, size_t max_capacity = MAX_CAPACITY)
+			:
+				_budget(budget),
+				_max_capacity(max((size_t)MIN_CAPACITY,
+				                  min(max_capacity, (size_t)MAX_CAPACITY))),
+				_capacity(MIN_CAPACITY),
+				_buffer((char *)env()->heap()->alloc(_capacity)),
+				_writer_is_gone(false)
+			{
+				_budget.charge(_capacity);
+			}
 
 			~Pipe()
 			{
 				Lock::Guard guard(_lock);
+				env()->heap()->free(_buffer, _capacity);
+				_budget.deposit(_capacity);
 			}
 
 			void writer_close()
@@ -109,91 +311,117 @@ namespace Noux {
 			{
 				Lock::Guard guard(_lock);
 
-				return _read_offset != _write_offset;
+				return _count > 0;
 			}
 
 			size_t read(char *dst, size_t dst_len)
 			{
 				Lock::Guard guard(_lock);
 
-				if (_read_offset < _write_offset) {
+				size_t total = 0;
+				while (total < dst_len) {
 
-					size_t len = min(dst_len, _write_offset - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], len);
+					size_t const n = _consume(dst_len - total,
+					                          [&] (char const *src, size_t avail) {
+						memcpy(dst + total, src, avail);
+						return avail; });
 
-					_read_offset += len;
-					_wake_up_writer();
+					if (!n)
+						break;
 
-					return len;
+					total += n;
 				}
+				return total;
+			}
+
+			/**
+			 * Write to pipe buffer
+			 *
+			 * \return number of written bytes (may be less than 'len')
+			 */
+			size_t write(char const *src, size_t len)
+			{
+				Lock::Guard guard(_lock);
 
-				if (_read_offset > _write_offset) {
+				if (_avail_buffer_space() < len)
+					_grow(len);
 
-					size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], upper_len);
+				size_t total = 0;
+				while (total < len) {
 
-					size_t const lower_len = min(dst_len - upper_len, _write_offset);
-					if (lower_len) {
-						memcpy(dst + upper_len, &_buffer[0], lower_len);
-						_read_offset = lower_len;
-					} else {
-						_read_offset += upper_len;
-					}
-					_wake_up_writer();
+					size_t const n = _produce(len - total,
+					                          [&] (char *dst, size_t space) {
+						memcpy(dst, src + total, space);
+						return space; });
 
-					return upper_len + lower_len;
-				}
+					if (!n)
+						break;
 
-				/* _read_offset == _write_offset */
-				return 0;
+					total += n;
+				}
+				return total;
 			}
 
 			/**
-			 * Write to pipe buffer
+			 * Let 'fn' store up to 'len' bytes directly into the pipe buffer
 			 *
-			 * \return number of written bytes (may be less than 'len')
+			 * The functor is called with a contiguous free part of the buffer
+			 * and its size and returns the number of bytes it stored. A
+			 * return value smaller than the size ends the operation.
+			 *
+			 * \return number of bytes stored
 			 */
-			size_t write(char *src, size_t len)
+			template <typename FN>
+			size_t produce(size_t len, FN const &fn)
 			{
 				Lock::Guard guard(_lock);
 
-				/* trim write request to the available buffer space */
-				size_t const trimmed_len = min(len, _avail_buffer_space());
+				if (_avail_buffer_space() < len)
+					_grow(len);
 
-				/*
-				 * Remember pipe state prior writing to see whether a reader
-				 * must be unblocked after writing.
-				 */
-				bool const pipe_was_empty = (_read_offset == _write_offset);
+				size_t total = 0;
+				while (total < len) {
 
-				/* write data up to the upper boundary of the pipe buffer */
-				size_t const upper_len = min(BUFFER_SIZE - _write_offset, trimmed_len);
-				memcpy(&_buffer[_write_offset], src, upper_len);
+					bool partial = false;
+					size_t const n = _produce(len - total,
+					                          [&] (char *dst, size_t space) {
+						size_t const n = fn(dst, space);
+						partial = (n < space);
+						return n; });
 
-				_write_offset += upper_len;
-
-				/*
-				 * Determine number of remaining bytes beyond the buffer boundary.
-				 * The buffer wraps. So this data will end up in the lower part
-				 * of the pipe buffer.
-				 */
-				size_t const lower_len = trimmed_len - upper_len;
+					total += n;
+					if (!n || partial)
+						break;
+				}
+				return total;
+			}
 
-				if (lower_len > 0) {
+			/**
+			 * Let 'fn' consume up to 'len' bytes directly from the pipe
+			 * buffer
+			 *
+			 * \return number of bytes consumed
+			 */
+			template <typename FN>
+			size_t consume(size_t len, FN const &fn)
+			{
+				Lock::Guard guard(_lock);
 
-					/* pipe buffer wrap-around, write remaining data to the lower part */
-					memcpy(&_buffer[0], src + upper_len, lower_len);
-					_write_offset = lower_len;
-				}
+				size_t total = 0;
+				while (total < len) {
 
-				/*
-				 * Wake up reader who may block for incoming data.
-				 */
-				if (pipe_was_empty || !_any_space_avail_for_writing())
-					_wake_up_reader();
+					bool partial = false;
+					size_t const n = _consume(len - total,
+					                          [&] (char const *src, size_t avail) {
+						size_t const n = fn(src, avail);
+						partial = (n < avail);
+						return n; });
 
-				/* return number of written bytes */
-				return trimmed_len;
+					total += n;
+					if (!n || partial)
+						break;
+				}
+				return total;
 			}
 
 			void register_write_ready_sigh(Signal_context_capability sigh)
@@ -237,24 +465,38 @@ namespace Noux {
 				return wr && _pipe->any_space_avail_for_writing();
 			}
 
-			bool write(Sysio *sysio, size_t &offset) override
+			bool write(Sysio *sysio, char const *src, size_t count,
+			           size_t &offset) override
 			{
 				/*
 				 * If the write operation is larger than the space available in
 				 * the pipe buffer, the write function is successively called
 				 * for different portions of original write request. The
 				 * current read pointer of the request is tracked via the
-				 * 'count' in/out argument. If completed, 'count' equals
-				 * 'write_in.count'.
+				 * 'offset' in/out argument. If completed, 'offset' equals
+				 * 'count'.
 				 */
 
 				/* dimension the pipe write operation to the not yet written data */
-				size_t curr_count = _pipe->write(sysio->write_in.chunk + offset,
-				                                 sysio->write_in.count - offset);
+				size_t curr_count = _pipe->write(src + offset, count - offset);
 				offset += curr_count;
 				return true;
 			}
 
+			bool spliceable() const override { return true; }
+
+			bool splice_from(Sysio *sysio, Shared_pointer<Io_channel> src,
+			                 size_t count, size_t &out_count) override
+			{
+				/* let the source channel read directly into the pipe buffer */
+				bool result = true;
+				out_count = _pipe->produce(count, [&] (char *dst, size_t space) {
+					result = src->read(sysio, dst, space);
+					return result ? sysio->read_out.count : 0; });
+
+				return result || out_count;
+			}
+
 			bool fcntl(Sysio *sysio) override
 			{
 				switch (sysio->fcntl_in.cmd) {
@@ -319,18 +561,28 @@ namespace Noux {
 				return (rd && _pipe->data_avail_for_reading());
 			}
 
-			bool read(Sysio *sysio) override
+			bool read(Sysio *sysio, char *dst, size_t count) override
 			{
-				size_t const max_count =
-					min(sysio->read_in.count,
-					    sizeof(sysio->read_out.chunk));
-
-				sysio->read_out.count =
-					_pipe->read(sysio->read_out.chunk, max_count);
+				sysio->read_out.count = _pipe->read(dst, count);
 
 				return true;
 			}
 
+			bool spliceable() const override { return true; }
+
+			bool splice_to(Sysio *sysio, Shared_pointer<Io_channel> dst,
+			               size_t count, size_t &out_count) override
+			{
+				/* let the destination channel write directly from the pipe buffer */
+				bool result = true;
+				out_count = _pipe->consume(count, [&] (char const *src, size_t avail) {
+					size_t offset = 0;
+					result = dst->write(sysio, src, avail, offset);
+					return result ? offset : 0; });
+
+				return result || out_count;
+			}
+
 			bool fcntl(Sysio *sysio) override
 			{
 				switch (sysio->fcntl_in.cmd) {
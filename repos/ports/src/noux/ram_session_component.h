@@ -10,7 +10,9 @@
  * Furthermore, the custom implementation is needed to get hold of the RAM
  * dataspaces allocated by each Noux process. When forking a process, the
  * acquired information (in the form of 'Ram_dataspace_info' objects) is used
- * to create a shadow copy of the forking address space.
+ * to share the RAM dataspaces of the forking process with the new process.
+ * The sharing is resolved lazily via copy-on-write (see
+ * 'Region_map_component').
  */
 
 /*
@@ -33,67 +35,99 @@
 
 namespace Noux {
 
-	struct Ram_dataspace_info : Dataspace_info,
-	                            List<Ram_dataspace_info>::Element
+	/**
+	 * RAM dataspace shared by Noux processes
+	 *
+	 * After a fork, the forking and the new process refer to the same
+	 * backing store. The dataspace is freed when the last process released
+	 * it.
+	 */
+	class Shared_ram_dataspace
 	{
-		Ram_dataspace_info(Ram_dataspace_capability ds_cap)
-		: Dataspace_info(ds_cap) { }
+		private:
+
+			Lock     _lock;
+			unsigned _users = 1;
 
-		Dataspace_capability fork(Ram_session_capability ram,
-		                          Dataspace_registry    &,
-		                          Rpc_entrypoint        &)
-		{
-			size_t const size = Dataspace_client(ds_cap()).size();
+		public:
 
-			Ram_dataspace_capability dst_ds;
+			Ram_dataspace_capability const cap;
 
-			try {
-				dst_ds = Ram_session_client(ram).alloc(size);
-			} catch (...) {
-				return Dataspace_capability();
+			Shared_ram_dataspace(Ram_dataspace_capability cap) : cap(cap) { }
+
+			void acquire()
+			{
+				Lock::Guard guard(_lock);
+				_users++;
 			}
 
-			void *src = 0;
-			try {
-				src = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			/**
+			 * Drop reference
+			 *
+			 * \return true if the dataspace has no users anymore
+			 */
+			bool release()
+			{
+				Lock::Guard guard(_lock);
+				return --_users == 0;
+			}
 
-			void *dst = 0;
-			try {
-				dst = env()->rm_session()->attach(dst_ds);
-			} catch (...) { }
+			bool shared()
+			{
+				Lock::Guard guard(_lock);
+				return _users > 1;
+			}
+	};
 
-			if (src && dst)
-				memcpy(dst, src, size);
 
-			if (src) env()->rm_session()->detach(src);
-			if (dst) env()->rm_session()->detach(dst);
+	class Ram_dataspace_info : public Dataspace_info,
+	                           public List<Ram_dataspace_info>::Element
+	{
+		private:
 
-			if (!src || !dst) {
-				Ram_session_client(ram).free(dst_ds);
-				return Dataspace_capability();
-			}
+			/*
+			 * RAM session of the process that owns the info, used for
+			 * allocating private copies
+			 */
+			Ram_session_component &_ram;
 
-			return dst_ds;
-		}
+			Shared_ram_dataspace &_backing;
 
-		void poke(addr_t dst_offset, void const *src, size_t len)
-		{
-			if ((dst_offset >= size()) || (dst_offset + len > size())) {
-			 	PERR("illegal attemt to write beyond dataspace boundary");
-			 	return;
-			}
+		public:
+
+			Ram_dataspace_info(Ram_session_component &ram,
+			                   Shared_ram_dataspace &backing)
+			: Dataspace_info(backing.cap), _ram(ram), _backing(backing) { }
+
+			Shared_ram_dataspace &backing() { return _backing; }
+
+			inline Dataspace_capability fork(Ram_session_component &ram,
+			                                 Dataspace_registry    &,
+			                                 Rpc_entrypoint        &) override;
 
-			char *dst = 0;
-			try {
-				dst = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			bool shared() const override { return _backing.shared(); }
+
+			bool accessible() const override { return true; }
+
+			inline Dataspace_capability copy(addr_t offset, size_t size) override;
+
+			void poke(addr_t dst_offset, void const *src, size_t len) override
+			{
+				if ((dst_offset >= size()) || (dst_offset + len > size())) {
+				 	PERR("illegal attemt to write beyond dataspace boundary");
+				 	return;
+				}
 
-			if (src && dst)
-				memcpy(dst + dst_offset, src, len);
+				char *dst = 0;
+				try {
+					dst = env()->rm_session()->attach(ds_cap());
+				} catch (...) { }
 
-			if (dst) env()->rm_session()->detach(dst);
-		}
+				if (src && dst)
+					memcpy(dst + dst_offset, src, len);
+
+				if (dst) env()->rm_session()->detach(dst);
+			}
 	};
 
 
@@ -112,6 +146,17 @@ namespace Noux {
 
 			Dataspace_registry &_registry;
 
+			void _insert(Shared_ram_dataspace &backing)
+			{
+				Ram_dataspace_info *ds_info = new (env()->heap())
+				                              Ram_dataspace_info(*this, backing);
+
+				_used_quota += ds_info->size();
+
+				_registry.insert(ds_info);
+				_list.insert(ds_info);
+			}
+
 		public:
 
 			/**
@@ -130,6 +175,24 @@ namespace Noux {
 					free(static_cap_cast<Ram_dataspace>(info->ds_cap()));
 			}
 
+			/**
+			 * Make RAM dataspace of a forking process available to the
+			 * process
+			 */
+			void share(Shared_ram_dataspace &backing)
+			{
+				/* a dataspace attached more than once is shared only once */
+				bool known = false;
+				_registry.apply(backing.cap, [&] (Dataspace_info *info) {
+					known = (info != nullptr); });
+
+				if (known)
+					return;
+
+				backing.acquire();
+				_insert(backing);
+			}
+
 
 			/***************************
 			 ** Ram_session interface **
@@ -140,20 +203,14 @@ namespace Noux {
 				Ram_dataspace_capability ds_cap =
 					env()->ram_session()->alloc(size, cached);
 
-				Ram_dataspace_info *ds_info = new (env()->heap())
-				                              Ram_dataspace_info(ds_cap);
-
-				_used_quota += ds_info->size();
-
-				_registry.insert(ds_info);
-				_list.insert(ds_info);
+				_insert(*new (env()->heap()) Shared_ram_dataspace(ds_cap));
 
 				return ds_cap;
 			}
 
 			void free(Ram_dataspace_capability ds_cap)
 			{
-				Ram_dataspace_info *ds_info;
+				Ram_dataspace_info *ds_info = nullptr;
 
 				auto lambda = [&] (Ram_dataspace_info *rdi) {
 					ds_info = rdi;
@@ -169,11 +226,20 @@ namespace Noux {
 
 					_list.remove(ds_info);
 					_used_quota -= ds_info->size();
-
-					env()->ram_session()->free(ds_cap);
 				};
 				_registry.apply(ds_cap, lambda);
+
+				if (!ds_info)
+					return;
+
+				Shared_ram_dataspace &backing = ds_info->backing();
 				destroy(env()->heap(), ds_info);
+
+				/* the dataspace may still be used by forked processes */
+				if (backing.release()) {
+					env()->ram_session()->free(backing.cap);
+					destroy(env()->heap(), &backing);
+				}
 			}
 
 			int ref_account(Ram_session_capability) { return 0; }
@@ -183,4 +249,53 @@ namespace Noux {
 	};
 }
 
+
+inline Genode::Dataspace_capability
+Noux::Ram_dataspace_info::fork(Ram_session_component &ram,
+                               Dataspace_registry    &,
+                               Rpc_entrypoint        &)
+{
+	ram.share(_backing);
+	return ds_cap();
+}
+
+
+inline Genode::Dataspace_capability
+Noux::Ram_dataspace_info::copy(addr_t offset, size_t size)
+{
+	if (offset + size > this->size())
+		return Dataspace_capability();
+
+	Ram_dataspace_capability dst_ds;
+
+	try {
+		dst_ds = _ram.alloc(size, Genode::CACHED);
+	} catch (...) {
+		return Dataspace_capability();
+	}
+
+	char *src = 0;
+	try {
+		src = env()->rm_session()->attach(ds_cap(), size, offset);
+	} catch (...) { }
+
+	char *dst = 0;
+	try {
+		dst = env()->rm_session()->attach(dst_ds);
+	} catch (...) { }
+
+	if (src && dst)
+		memcpy(dst, src, size);
+
+	if (src) env()->rm_session()->detach(src);
+	if (dst) env()->rm_session()->detach(dst);
+
+	if (!src || !dst) {
+		_ram.free(dst_ds);
+		return Dataspace_capability();
+	}
+
+	return dst_ds;
+}
+
 #endif /* _NOUX__RAM_SESSION_COMPONENT_H_ */
@@ -7,6 +7,11 @@
  * The custom region-map implementation is used for recording all regions
  * attached to the region map. Using the recorded information, the address-
  * space layout can then be replayed onto a new process created via fork.
+ *
+ * RAM dataspaces are not copied at fork time. Instead, they are attached
+ * copy-on-write to the forking and the new process. Core reflects write
+ * accesses to those regions as faults to the region map, which replaces the
+ * affected part of the region by a private copy.
  */
 
 /*
@@ -24,18 +29,25 @@
 #include <base/rpc_server.h>
 #include <util/retry.h>
 #include <pd_session/capability.h>
+#include <base/signal.h>
 
 namespace Noux { class Region_map_component; }
 
 
 class Noux::Region_map_component : public Rpc_object<Region_map>,
-                                   public Dataspace_info
+                                   public Dataspace_info,
+                                   public Signal_dispatcher_base
 {
 	private:
 
 		static constexpr bool verbose_attach = false;
 		static constexpr bool verbose_replay = false;
 
+		/**
+		 * Granularity of private copies created on write faults
+		 */
+		enum { COPY_CHUNK_SIZE_LOG2 = 16 };
+
 		Rpc_entrypoint &_ep;
 
 		/**
@@ -48,13 +60,14 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 			size_t                size;
 			off_t                 offset;
 			addr_t                local_addr;
+			bool                  copy_on_write;
 
 			Region(Region_map_component &rm,
 			       Dataspace_capability ds, size_t size,
-			       off_t offset, addr_t local_addr)
+			       off_t offset, addr_t local_addr, bool copy_on_write)
 			:
 				rm(rm), ds(ds), size(size), offset(offset),
-				local_addr(local_addr)
+				local_addr(local_addr), copy_on_write(copy_on_write)
 			{ }
 
 			/**
@@ -95,25 +108,208 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 
 		Dataspace_registry &_ds_registry;
 
+		/**
+		 * Receiver of the page-fault signals of '_rm'
+		 */
+		Signal_receiver &_sig_rec;
+
+		/**
+		 * Fault handler installed by the Noux process
+		 */
+		Signal_context_capability _fault_handler;
+
+		addr_t _core_attach(Dataspace_capability ds, size_t size, off_t offset,
+		                    bool use_local_addr, addr_t local_addr,
+		                    bool executable, bool copy_on_write,
+		                    bool populate = false)
+		{
+			for (;;) {
+				try {
+					return _rm.attach(ds, size, offset, use_local_addr,
+					                  local_addr, executable, copy_on_write,
+					                  populate);
+				} catch (Region_map::Out_of_metadata) {
+					Genode::env()->parent()->upgrade(_pd, "ram_quota=8096");
+				}
+			}
+		}
+
+		/**
+		 * Attach dataspace and create the corresponding region record
+		 *
+		 * The region is not yet inserted into '_regions'.
+		 */
+		Region *_attach(Dataspace_capability ds, size_t size, off_t offset,
+		                bool use_local_addr, addr_t local_addr,
+		                bool executable, bool copy_on_write,
+		                bool populate = false)
+		{
+			/*
+			 * Region map subtracts offset from size if size is 0
+			 */
+			if (size == 0) size = Dataspace_client(ds).size() - offset;
+
+			local_addr = _core_attach(ds, size, offset, use_local_addr,
+			                          local_addr, executable, copy_on_write,
+			                          populate);
+
+			Region * region = new (env()->heap())
+			                  Region(*this, ds, size, offset, local_addr,
+			                         copy_on_write);
+
+			/* register region as user of RAM dataspaces */
+			auto lambda = [&] (Dataspace_info *info)
+			{
+				if (info) {
+					info->register_user(*region);
+				} else {
+					if (verbose_attach) {
+						PWRN("Trying to attach unknown dataspace type ds=%ld", ds.local_name());
+						PWRN("  ds_info@%p at 0x%lx size=%zd offset=0x%lx",
+						     info, (long)local_addr,
+						     Dataspace_client(ds).size(), (long)offset);
+					}
+				}
+			};
+			_ds_registry.apply(ds, lambda);
+
+			return region;
+		}
+
+		/**
+		 * Remove region record and detach the region
+		 *
+		 * Must be called with '_region_lock' held.
+		 */
+		void _detach(Region &region)
+		{
+			addr_t const local_addr = region.local_addr;
+
+			_regions.remove(&region);
+
+			_ds_registry.apply(region.ds, [&] (Dataspace_info *info) {
+				if (info) info->unregister_user(region); });
+
+			destroy(env()->heap(), &region);
+
+			_rm.detach(local_addr);
+		}
+
+		/**
+		 * Turn region into a copy-on-write region
+		 *
+		 * Must be called with '_region_lock' held.
+		 */
+		void _make_copy_on_write(Region &region)
+		{
+			_rm.detach(region.local_addr);
+			_core_attach(region.ds, region.size, region.offset, true,
+			             region.local_addr, false, true);
+			region.copy_on_write = true;
+		}
+
+		/**
+		 * Make range of a copy-on-write region writeable
+		 *
+		 * If the dataspace is no longer shared with other processes, the
+		 * whole region is attached writeable. Otherwise, the chunks
+		 * covering the range are replaced by a private copy while the
+		 * remainder of the region stays copy-on-write.
+		 *
+		 * Must be called with '_region_lock' held.
+		 *
+		 * \return false if the range could not be made writeable
+		 */
+		bool _materialize(Region &region, addr_t addr, size_t len)
+		{
+			Dataspace_capability const ds     = region.ds;
+			addr_t               const start  = region.local_addr;
+			addr_t               const end    = start + region.size;
+			off_t                const offset = region.offset;
+
+			addr_t const chunk_mask = ~((1UL << COPY_CHUNK_SIZE_LOG2) - 1);
+
+			addr_t const copy_start = max(start, addr & chunk_mask);
+			addr_t const copy_end =
+				min(end, align_addr(addr + len, COPY_CHUNK_SIZE_LOG2));
+
+			bool                 known  = false;
+			bool                 shared = false;
+			Dataspace_capability copy;
+
+			_ds_registry.apply(ds, [&] (Dataspace_info *info) {
+				if (!info)
+					return;
+
+				known  = true;
+				shared = info->shared();
+				if (shared)
+					copy = info->copy(offset + (copy_start - start),
+					                  copy_end - copy_start);
+			});
+
+			if (!known || (shared && !copy.valid())) {
+				PERR("unable to resolve copy-on-write fault at 0x%lx", addr);
+				return false;
+			}
+
+			_detach(region);
+
+			if (!shared) {
+				_regions.insert(_attach(ds, end - start, offset, true, start,
+				                        false, false));
+				return true;
+			}
+
+			if (copy_start > start)
+				_regions.insert(_attach(ds, copy_start - start, offset, true,
+				                        start, false, true));
+
+			_regions.insert(_attach(copy, copy_end - copy_start, 0, true,
+			                        copy_start, false, false));
+
+			if (end > copy_end)
+				_regions.insert(_attach(ds, end - copy_end,
+				                        offset + (copy_end - start), true,
+				                        copy_end, false, true));
+			return true;
+		}
+
+		bool _resolve_write_fault(addr_t addr)
+		{
+			Lock::Guard guard(_region_lock);
+
+			Region *region = _lookup_region_by_addr(addr);
+			if (!region || !region->copy_on_write)
+				return false;
+
+			return _materialize(*region, addr, 1);
+		}
+
 	public:
 
 		/**
 		 * Constructor
 		 *
-		 * \param pd  protection domain the region map belongs to, used for
-		 *            quota upgrades
-		 * \param rm  region map at core
+		 * \param sig_rec  signal receiver used for handling the page
+		 *                 faults of copy-on-write regions
+		 * \param pd       protection domain the region map belongs to,
+		 *                 used for quota upgrades
+		 * \param rm       region map at core
 		 */
 		Region_map_component(Rpc_entrypoint &ep,
 		                     Dataspace_registry &ds_registry,
+		                     Signal_receiver &sig_rec,
 		                     Pd_session_capability pd,
 		                     Capability<Region_map> rm)
 		:
 			Dataspace_info(Region_map_client(rm).dataspace()),
-			_ep(ep), _rm(rm), _pd(pd), _ds_registry(ds_registry)
+			_ep(ep), _rm(rm), _pd(pd), _ds_registry(ds_registry),
+			_sig_rec(sig_rec)
 		{
 			_ep.manage(this);
 			_ds_registry.insert(this);
+			_rm.fault_handler(_sig_rec.manage(this));
 		}
 
 		/**
@@ -123,6 +319,7 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 		{
 			_ds_registry.remove(this);
 			_ep.dissolve(this);
+			_sig_rec.dissolve(this);
 
 			Region *curr;
 			while ((curr = _regions.first()))
@@ -147,18 +344,64 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 			return 0;
 		}
 
+		/**
+		 * Look up the RAM dataspace that backs a range of the address space
+		 *
+		 * Used for accessing syscall payload directly within the memory of
+		 * the Noux process. If 'write' is true, a copy-on-write region
+		 * covering the range is made writeable beforehand.
+		 *
+		 * \param ds      resulting dataspace
+		 * \param offset  resulting offset of 'addr' within 'ds'
+		 *
+		 * \return false if the range is not backed by a single RAM
+		 *         dataspace
+		 */
+		bool lookup_ram_range(addr_t addr, size_t len, bool write,
+		                      Dataspace_capability &ds, addr_t &offset)
+		{
+			Lock::Guard guard(_region_lock);
+
+			Region *region = _lookup_region_by_addr(addr);
+			if (!region || region != _lookup_region_by_addr(addr + len - 1))
+				return false;
+
+			if (write && region->copy_on_write) {
+				if (!_materialize(*region, addr, len))
+					return false;
+
+				region = _lookup_region_by_addr(addr);
+				if (region != _lookup_region_by_addr(addr + len - 1))
+					return false;
+			}
+
+			bool accessible = false;
+			_ds_registry.apply(region->ds, [&] (Dataspace_info *info) {
+				accessible = info && info->accessible(); });
+
+			if (!accessible)
+				return false;
+
+			ds     = region->ds;
+			offset = region->offset + (addr - region->local_addr);
+			return true;
+		}
+
 		/**
 		 * Replay attachments onto specified region map
 		 *
-		 * \param dst_ram      backing store used for allocating the
-		 *                     the copies of RAM dataspaces
+		 * RAM dataspaces are shared copy-on-write with the new process.
+		 * Hence, the regions of the forking process become copy-on-write,
+		 * too.
+		 *
+		 * \param dst_ram      RAM session of the new process
 		 * \param ds_registry  dataspace registry used for keeping track
 		 *                     of newly created dataspaces
 		 * \param ep           entrypoint used to serve the RPC interface
 		 *                     of forked managed dataspaces
 		 */
-		void replay(Ram_session_capability dst_ram,
-		            Capability<Region_map> dst_rm,
+		void replay(Ram_session_component &dst_ram,
+		            Region_map_component  &dst_rm,
 		            Dataspace_registry    &ds_registry,
 		            Rpc_entrypoint        &ep)
 		{
@@ -168,15 +411,12 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 				auto lambda = [&] (Dataspace_info *info)
 				{
 					Dataspace_capability ds;
+					bool copy_on_write = false;
 					if (info) {
 
 						ds = info->fork(dst_ram, ds_registry, ep);
 
-						/*
-						 * XXX We could detect dataspaces that are attached
-						 *     more than once. For now, we create a new fork
-						 *     for each attachment.
-						 */
+						copy_on_write = info->shared();
 
 					} else {
 
@@ -210,10 +450,16 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 						return;
 					}
 
-					Region_map_client(dst_rm).attach(ds, curr->size,
-					                                 curr->offset,
-					                                 true,
-					                                 curr->local_addr);
+					if (copy_on_write && !curr->copy_on_write)
+						_make_copy_on_write(*curr);
+
+					Region *region = dst_rm._attach(ds, curr->size,
+					                                curr->offset, true,
+					                                curr->local_addr, false,
+					                                copy_on_write);
+
+					Lock::Guard guard(dst_rm._region_lock);
+					dst_rm._regions.insert(region);
 				};
 				_ds_registry.apply(curr->ds, lambda);
 			};
@@ -228,41 +474,28 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 		                  size_t size = 0, off_t offset = 0,
 		                  bool use_local_addr = false,
 		                  Local_addr local_addr = (addr_t)0,
-		                  bool executable = false) override
+		                  bool executable = false,
+		                  bool copy_on_write = false,
+		                  bool populate = false) override
 		{
 			/*
-			 * Region map subtracts offset from size if size is 0
+			 * The private pages of a copy-on-write mapping could not be
+			 * replayed onto a forked process.
 			 */
-			if (size == 0) size = Dataspace_client(ds).size() - offset;
-
-			for (;;) {
-				try {
-					local_addr = _rm.attach(ds, size, offset, use_local_addr,
-					                        local_addr, executable);
-					break;
-				} catch (Region_map::Out_of_metadata) {
-					Genode::env()->parent()->upgrade(_pd, "ram_quota=8096");
-				}
-			}
+			if (copy_on_write)
+				throw Invalid_args();
 
-			Region * region = new (env()->heap())
-			                  Region(*this, ds, size, offset, local_addr);
+			/*
+			 * A dataspace shared with another process since a fork must not
+			 * be modified in place
+			 */
+			bool shared = false;
+			_ds_registry.apply(ds, [&] (Dataspace_info *info) {
+				shared = info && info->shared(); });
 
-			/* register region as user of RAM dataspaces */
-			auto lambda = [&] (Dataspace_info *info)
-			{
-				if (info) {
-					info->register_user(*region);
-				} else {
-					if (verbose_attach) {
-						PWRN("Trying to attach unknown dataspace type ds=%ld", ds.local_name());
-						PWRN("  ds_info@%p at 0x%lx size=%zd offset=0x%lx",
-						     info, (long)local_addr,
-						     Dataspace_client(ds).size(), (long)offset);
-					}
-				}
-			};
-			_ds_registry.apply(ds, lambda);
+			Region *region = _attach(ds, size, offset, use_local_addr,
+			                         local_addr, executable, shared,
+			                         populate);
 
 			/*
 			 * Record attachment for later replay (needed during fork)
@@ -270,7 +503,7 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 			Lock::Guard guard(_region_lock);
 			_regions.insert(region);
 
-			return local_addr;
+			return region->local_addr;
 		}
 
 		void detach(Local_addr local_addr) override
@@ -299,7 +532,8 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 
 		void fault_handler(Signal_context_capability handler) override
 		{
-			return _rm.fault_handler(handler);
+			/* the fault handler at core is used for copy-on-write */
+			_fault_handler = handler;
 		}
 
 		State state() override
@@ -324,7 +558,7 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 		 ** Dataspace_info interface **
 		 ******************************/
 
-		Dataspace_capability fork(Ram_session_capability ram,
+		Dataspace_capability fork(Ram_session_component &ram,
 		                          Dataspace_registry  &ds_registry,
 		                          Rpc_entrypoint      &ep) override
 		{
@@ -383,6 +617,17 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 					return;
 				}
 
+				if (region->copy_on_write) {
+					if (!_materialize(*region, dst_addr, len))
+						return;
+
+					region = _lookup_region_by_addr(dst_addr);
+					if (region != _lookup_region_by_addr(dst_addr + len - 1)) {
+						PERR("attempt to write beyond region boundary");
+						return;
+					}
+				}
+
 				if (region->offset) {
 					PERR("poke: writing to region with offset is not supported");
 					return;
@@ -400,6 +645,34 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 				info->poke(dst_addr - local_addr, src, len);
 			});
 		}
+
+
+		/**************************************
+		 ** Signal_dispatcher_base interface **
+		 **************************************/
+
+		/**
+		 * Handle page faults of the region map
+		 */
+		void dispatch(unsigned) override
+		{
+			for (;;) {
+				State const state = _rm.state();
+
+				if (state.type == State::READY)
+					return;
+
+				if (state.type == State::WRITE_FAULT
+				 && _resolve_write_fault(state.addr))
+					continue;
+
+				/* fault unrelated to copy-on-write, leave it to the process */
+				if (_fault_handler.valid())
+					Signal_transmitter(_fault_handler).submit();
+
+				return;
+			}
+		}
 };
 
 
@@ -26,7 +26,7 @@ namespace Noux {
 
 		~Rom_dataspace_info() { }
 
-		Dataspace_capability fork(Ram_session_capability,
+		Dataspace_capability fork(Ram_session_component &,
 		                          Dataspace_registry &ds_registry,
 		                          Rpc_entrypoint &)
 		{
@@ -62,12 +62,10 @@ namespace Noux {
 			catch (Genode::Signal_receiver::Context_not_associated) { }
 		}
 
-		bool write(Sysio *sysio, size_t &offset) override
+		bool write(Sysio *sysio, char const *src, size_t count,
+		           size_t &offset) override
 		{
-			size_t const count = min(sysio->write_in.count,
-			                         sizeof(sysio->write_in.chunk));
-
-			terminal.write(sysio->write_in.chunk, count);
+			terminal.write(src, count);
 
 			sysio->write_out.count = count;
 			offset = count;
@@ -75,7 +73,7 @@ namespace Noux {
 			return true;
 		}
 
-		bool read(Sysio *sysio) override
+		bool read(Sysio *sysio, char *dst, size_t max_count) override
 		{
 			if (type != STDIN) {
 				PERR("attempt to read from terminal output channel");
@@ -89,10 +87,6 @@ namespace Noux {
 				return true;
 			}
 
-			size_t const max_count =
-				min(sysio->read_in.count,
-				    sizeof(sysio->read_out.chunk));
-
 			for (sysio->read_out.count = 0;
 			     (sysio->read_out.count < max_count) && !read_buffer.empty();
 			     sysio->read_out.count++) {
@@ -118,7 +112,7 @@ namespace Noux {
 					return true;
 				}
 
-				sysio->read_out.chunk[sysio->read_out.count] = c;
+				dst[sysio->read_out.count] = c;
 			}
 
 			return true;
@@ -44,30 +44,29 @@ namespace Noux {
 			_fh->ds().close(_fh);
 		}
 
-		bool write(Sysio *sysio, size_t &offset) override
+		bool write(Sysio *sysio, char const *src, size_t count,
+		           size_t &offset) override
 		{
 			Vfs::file_size out_count = 0;
 
-			sysio->error.write = _fh->fs().write(_fh, sysio->write_in.chunk,
-		                                         sysio->write_in.count, out_count);
+			sysio->error.write = _fh->fs().write(_fh, src + offset,
+			                                     count - offset, out_count);
 			if (sysio->error.write != Vfs::File_io_service::WRITE_OK)
 				return false;
 
 			_fh->advance_seek(out_count);
 
-			sysio->write_out.count = out_count;
-			offset = out_count;
+			offset += out_count;
+			sysio->write_out.count = offset;
 
 			return true;
 		}
 
-		bool read(Sysio *sysio) override
+		bool read(Sysio *sysio, char *dst, size_t count) override
 		{
-			size_t count = min(sysio->read_in.count, sizeof(sysio->read_out.chunk));
-
 			Vfs::file_size out_count = 0;
 
-			sysio->error.read = _fh->fs().read(_fh, sysio->read_out.chunk, count, out_count);
+			sysio->error.read = _fh->fs().read(_fh, dst, count, out_count);
 
 			if (sysio->error.read != Vfs::File_io_service::READ_OK)
 				return false;
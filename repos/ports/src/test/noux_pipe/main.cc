@@ -0,0 +1,166 @@
+/*
+ * \brief  Test for growing pipe buffers and the splice operation of Noux
+ * \author Genode Labs
+ * \date   2016-06-06
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/types.h>
+
+extern "C" ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+                          size_t len, unsigned int flags);
+
+enum {
+	PIPE_SIZE   = 256*1024, /* exceeds the initial pipe capacity of 64 KiB */
+	SPLICE_SIZE = 48*1024,
+};
+
+static char src_buf[PIPE_SIZE];
+static char dst_buf[PIPE_SIZE];
+
+
+static void fill(char *buf, size_t size, unsigned seed)
+{
+	for (size_t i = 0; i < size; i++)
+		buf[i] = (char)((i*seed + i/251) & 0xff);
+}
+
+
+static bool read_all(int fd, char *buf, size_t size)
+{
+	for (size_t offset = 0; offset < size; ) {
+		ssize_t n = read(fd, buf + offset, size - offset);
+		if (n <= 0) {
+			printf("Error: read returned %zd, errno=%d\n", n, errno);
+			return false;
+		}
+		offset += n;
+	}
+	return true;
+}
+
+
+static bool splice_all(int fd_in, int fd_out, size_t size)
+{
+	for (size_t done = 0; done < size; ) {
+		ssize_t n = splice(fd_in, 0, fd_out, 0, size - done, 0);
+		if (n <= 0) {
+			printf("Error: splice returned %zd, errno=%d\n", n, errno);
+			return false;
+		}
+		done += n;
+	}
+	return true;
+}
+
+
+/**
+ * Write more than the initial pipe capacity without a concurrent reader
+ */
+static bool test_grow()
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		printf("Error: pipe failed, errno=%d\n", errno);
+		return false;
+	}
+
+	fill(src_buf, PIPE_SIZE, 7);
+
+	ssize_t n = write(fds[1], src_buf, PIPE_SIZE);
+	if (n != PIPE_SIZE) {
+		printf("Error: write returned %zd, expected %d\n", n, PIPE_SIZE);
+		return false;
+	}
+
+	memset(dst_buf, 0, PIPE_SIZE);
+	bool const ok = read_all(fds[0], dst_buf, PIPE_SIZE)
+	             && memcmp(src_buf, dst_buf, PIPE_SIZE) == 0;
+
+	close(fds[0]);
+	close(fds[1]);
+
+	printf("grow: %s\n", ok ? "ok" : "failed");
+	return ok;
+}
+
+
+/**
+ * Splice a file into a pipe and the pipe content into another file
+ */
+static bool test_splice()
+{
+	fill(src_buf, SPLICE_SIZE, 13);
+
+	int in = open("/tmp/splice_in", O_CREAT | O_RDWR, 0644);
+	if (in < 0 || write(in, src_buf, SPLICE_SIZE) != SPLICE_SIZE) {
+		printf("Error: could not create /tmp/splice_in, errno=%d\n", errno);
+		return false;
+	}
+	lseek(in, 0, SEEK_SET);
+
+	int fds[2];
+	if (pipe(fds) != 0) {
+		printf("Error: pipe failed, errno=%d\n", errno);
+		return false;
+	}
+
+	int out = open("/tmp/splice_out", O_CREAT | O_RDWR, 0644);
+	if (out < 0) {
+		printf("Error: could not create /tmp/splice_out, errno=%d\n", errno);
+		return false;
+	}
+
+	/* file to pipe, then pipe to file */
+	if (!splice_all(in, fds[1], SPLICE_SIZE)
+	 || !splice_all(fds[0], out, SPLICE_SIZE))
+		return false;
+
+	/* file to pipe, read back via the pipe */
+	lseek(in, 0, SEEK_SET);
+	memset(dst_buf, 0, SPLICE_SIZE);
+	bool ok = splice_all(in, fds[1], SPLICE_SIZE)
+	       && read_all(fds[0], dst_buf, SPLICE_SIZE)
+	       && memcmp(src_buf, dst_buf, SPLICE_SIZE) == 0;
+
+	/* verify content written by splicing from the pipe */
+	lseek(out, 0, SEEK_SET);
+	memset(dst_buf, 0, SPLICE_SIZE);
+	ok = ok && read_all(out, dst_buf, SPLICE_SIZE)
+	        && memcmp(src_buf, dst_buf, SPLICE_SIZE) == 0;
+
+	/* splicing between two files is not supported */
+	ok = ok && splice(in, 0, out, 0, 1, 0) == -1 && errno == EINVAL;
+
+	close(out);
+	close(fds[0]);
+	close(fds[1]);
+	close(in);
+
+	printf("splice: %s\n", ok ? "ok" : "failed");
+	return ok;
+}
+
+
+int main(int, char **)
+{
+	printf("--- test-noux_pipe started ---\n");
+
+	if (!test_grow() || !test_splice())
+		return -1;
+
+	printf("--- test-noux_pipe finished ---\n");
+	return 0;
+}
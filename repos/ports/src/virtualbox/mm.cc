@@ -63,11 +63,14 @@ class Sub_rm_connection : private Genode::Rm_connection,
 		                  Genode::size_t size = 0, Genode::off_t offset = 0,
 		                  bool use_local_addr = false,
 		                  Local_addr local_addr = (void *)0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool copy_on_write = false,
+		                  bool populate = false)
 		{
 			Local_addr addr = Region_map_client::attach(ds, size, offset,
 			                                            use_local_addr, local_addr,
-			                                            executable);
+			                                            executable, copy_on_write,
+			                                            populate);
 			Genode::addr_t new_addr = addr;
 			new_addr += _offset;
 			return Local_addr(new_addr);